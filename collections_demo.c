@@ -2,15 +2,18 @@
  * @file collections_demo.c
  * @brief Enhanced demonstration program for the zzCollections library.
  *
- * This program demonstrates the usage of all 15 data structures provided by the
+ * This program demonstrates the usage of all 21 data structures provided by the
  * zzCollections library. It showcases how to initialize, use, and free each
  * data structure with various examples and operations, including universal
  * iterator support and remove-over-iterator functionality across all collections.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include "arrayList.h"
 #include "arrayDeque.h"
 #include "linkedList.h"
@@ -27,6 +30,11 @@
 #include "priorityQueue.h"
 #include "circularBuffer.h"
 #include "arraySet.h"
+#include "persistentTreeMap.h"
+#include "concurrentSkipListMap.h"
+#include "radixTreeMap.h"
+#include "intervalTree.h"
+#include "frozenTreeSet.h"
 #include "utils.h"
 
 /**
@@ -66,6 +74,176 @@ void printInfo(const char* info) {
     printf("ℹ️  Info: %s\n", info);
 }
 
+/** Number of failed behavior checks, reported through the exit status. */
+static int demoFailures = 0;
+
+/**
+ * @brief Prints the outcome of a behavior check.
+ *
+ * This function prints a check mark or a cross next to the label and counts
+ * failures, so the demo exits with a non-zero status if any check failed.
+ */
+void printCheck(const char* label, bool ok) {
+    printf("   %s %s\n", ok ? "✓" : "✗ FAILED:", label);
+    if (!ok) demoFailures++;
+}
+
+/**
+ * @brief Seeds an int sum aggregate from a single int.
+ */
+void demoSumInit(void* aggOut, const void* elem) {
+    *(int*)aggOut = *(const int*)elem;
+}
+
+/**
+ * @brief Adds two int sum aggregates.
+ */
+void demoSumCombine(void* aggOut, const void* left, const void* right) {
+    *(int*)aggOut = *(const int*)left + *(const int*)right;
+}
+
+/**
+ * @brief Entry predicate matching odd int values.
+ */
+bool demoOddValue(const void* key, const void* value, void* userdata) {
+    (void)key;
+    (void)userdata;
+    return *(const int*)value % 2 != 0;
+}
+
+/**
+ * @brief Result of scanning a persistent TreeMap snapshot from a reader thread.
+ */
+typedef struct DemoSnapshotScan {
+    zzPersistentTreeMapSnapshot snap;   /**< Snapshot to scan, released by the reader when done */
+    long sum;                           /**< Sum of all values seen in the snapshot */
+    size_t count;                       /**< Number of entries seen in the snapshot */
+} DemoSnapshotScan;
+
+/**
+ * @brief Reader thread for the persistent TreeMap demo.
+ *
+ * Scans the snapshot several times while the main thread keeps updating the map,
+ * checking that every pass sees the same contents, then releases the snapshot.
+ */
+void* demoSnapshotReader(void* arg) {
+    DemoSnapshotScan* scan = arg;
+    for (int pass = 0; pass < 50; pass++) {
+        long sum = 0;
+        size_t count = 0;
+        zzPersistentTreeMapIterator it;
+        zzPersistentTreeMapIteratorInit(&it, &scan->snap);
+        int k, v;
+        while (zzPersistentTreeMapIteratorNext(&it, &k, &v)) {
+            sum += v;
+            count++;
+        }
+        if (pass > 0 && (sum != scan->sum || count != scan->count)) {
+            scan->count = 0;
+            break;
+        }
+        scan->sum = sum;
+        scan->count = count;
+    }
+    zzPersistentTreeMapReleaseSnapshot(&scan->snap);
+    return NULL;
+}
+
+/**
+ * @brief Returns the number of child slots of the root layout of a radix tree map.
+ *
+ * A map with at least two keys always has an inner node at the root; smaller maps
+ * report 0.
+ */
+int demoRadixRootSlots(const zzRadixTreeMap* rm) {
+    if (rm->size < 2) return 0;
+    switch (rm->root->type) {
+        case ZZ_RADIX_NODE4: return 4;
+        case ZZ_RADIX_NODE16: return 16;
+        case ZZ_RADIX_NODE48: return 48;
+        case ZZ_RADIX_NODE256: return 256;
+        default: return -1;
+    }
+}
+
+/** Number of threads of each kind in the concurrent skip list check. */
+#define DEMO_SKIPLIST_THREADS 4
+
+/** Number of keys used by the concurrent skip list check. */
+#define DEMO_SKIPLIST_KEYS 8000
+
+/**
+ * @brief State shared by the threads of the concurrent skip list check.
+ */
+typedef struct DemoSkipListShared {
+    zzConcurrentSkipListMap* map;   /**< Map shared by all threads */
+    atomic_int writersLeft;         /**< Writers still running; scanners stop when it reaches 0 */
+    atomic_int removed;             /**< Successful removals of contested keys */
+    atomic_int errors;              /**< Inconsistencies seen by any thread */
+} DemoSkipListShared;
+
+/**
+ * @brief Arguments of one thread of the concurrent skip list check.
+ */
+typedef struct DemoSkipListTask {
+    DemoSkipListShared* shared;     /**< State shared by all threads */
+    int id;                         /**< Index of the thread among threads of its kind */
+} DemoSkipListTask;
+
+/**
+ * @brief Writer thread: inserts its share of the keys, removes every third one and negates the even ones.
+ */
+void* demoSkipListWriter(void* arg) {
+    DemoSkipListTask* task = arg;
+    zzConcurrentSkipListMap* map = task->shared->map;
+    for (int k = task->id; k < DEMO_SKIPLIST_KEYS; k += DEMO_SKIPLIST_THREADS) {
+        zzConcurrentSkipListMapPut(map, &k, &k);
+    }
+    for (int k = task->id; k < DEMO_SKIPLIST_KEYS; k += DEMO_SKIPLIST_THREADS) {
+        if (k % 3 == 0) {
+            if (!ZZ_IS_OK(zzConcurrentSkipListMapRemove(map, &k))) atomic_fetch_add(&task->shared->errors, 1);
+        } else if (k % 2 == 0) {
+            zzConcurrentSkipListMapPut(map, &k, &(int){-k});
+        }
+    }
+    atomic_fetch_sub(&task->shared->writersLeft, 1);
+    return NULL;
+}
+
+/**
+ * @brief Scanner thread: iterates and seeks while the writers run, checking order and values.
+ */
+void* demoSkipListScanner(void* arg) {
+    DemoSkipListTask* task = arg;
+    zzConcurrentSkipListMap* map = task->shared->map;
+    while (atomic_load(&task->shared->writersLeft) > 0) {
+        zzConcurrentSkipListMapIterator it;
+        zzConcurrentSkipListMapIteratorInit(&it, map);
+        if (task->id % 2 == 1) {
+            zzConcurrentSkipListMapIteratorSeek(&it, &(int){DEMO_SKIPLIST_KEYS / 2});
+        }
+        int prev = -1, k, v;
+        while (zzConcurrentSkipListMapIteratorNext(&it, &k, &v)) {
+            if (k <= prev || (v != k && v != -k)) atomic_fetch_add(&task->shared->errors, 1);
+            prev = k;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Remover thread: races the other removers for every key with remainder 1 modulo 3.
+ */
+void* demoSkipListRemover(void* arg) {
+    DemoSkipListTask* task = arg;
+    for (int k = 1; k < DEMO_SKIPLIST_KEYS; k += 3) {
+        if (ZZ_IS_OK(zzConcurrentSkipListMapRemove(task->shared->map, &k))) {
+            atomic_fetch_add(&task->shared->removed, 1);
+        }
+    }
+    return NULL;
+}
+
 /**
  * @brief Main function demonstrating the usage of all data structures in the library.
  *
@@ -81,7 +259,7 @@ int main() {
     printf("║                                                   ║\n");
     printf("║         🚀 zzCollections Library Demo 🚀          ║\n");
     printf("║                                                   ║\n");
-    printf("║   16 Production-Ready Data Structures in C11      ║\n");
+    printf("║   21 Production-Ready Data Structures in C11      ║\n");
     printf("║                                                   ║\n");
     printf("╚═══════════════════════════════════════════════════╝\n");
     printSeparator();
@@ -662,6 +840,59 @@ int main() {
         }
         printTip("Iterator remove maintains sorted order property!");
 
+        printf("\n   → Augmented map with a value sum: keys 10..80 → values 1..8\n");
+        zzTreeMap om;
+        zzTreeMapInitAugmented(&om, sizeof(int), sizeof(int), zzIntCompare, NULL, NULL,
+                               sizeof(int), demoSumInit, demoSumCombine);
+        int okeys[8], ovals[8];
+        for (int i = 0; i < 8; i++) {
+            okeys[i] = (i + 1) * 10;
+            ovals[i] = i + 1;
+        }
+        zzTreeMapBuildFromSorted(&om, okeys, ovals, 8);
+
+        size_t rank;
+        zzTreeMapRank(&om, &(int){45}, &rank);
+        printf("   → Rank of 45 (keys below it): %zu\n", rank);
+        printCheck("Rank(45) == 4", rank == 4);
+        zzTreeMapSelect(&om, 2, &k, &v);
+        printf("   → Select(2): %d:%d\n", k, v);
+        printCheck("Select(2) == 30:3", k == 30 && v == 3);
+        int sum;
+        zzTreeMapRangeAggregate(&om, &(int){20}, &(int){60}, &sum);
+        printf("   → Sum of values for keys in [20, 60): %d\n", sum);
+        printCheck("RangeAggregate([20, 60)) == 2+3+4+5", sum == 14);
+
+        printf("\n   → Splitting at key 50, then joining back...\n");
+        zzTreeMap lower, upper;
+        zzTreeMapSplit(&om, &(int){50}, &lower, &upper);
+        zzTreeMapGetMax(&lower, &k, NULL);
+        zzTreeMapGetMin(&upper, &k2, NULL);
+        printf("   → Left: %zu entries up to %d, right: %zu entries from %d\n", lower.size, k, upper.size, k2);
+        printCheck("Split(50) gives 4 + 4 entries around the key", lower.size == 4 && upper.size == 4 && k == 40 && k2 == 50);
+        zzTreeMapRangeAggregate(&upper, NULL, NULL, &sum);
+        printCheck("Right half keeps its aggregates (sum 5+6+7+8)", sum == 26);
+        zzTreeMapJoin(&lower, &upper);
+        zzTreeMapRank(&lower, &(int){80}, &rank);
+        printCheck("Join restores 8 entries with Rank(80) == 7", lower.size == 8 && upper.size == 0 && rank == 7);
+
+        size_t removed;
+        zzTreeMapRemoveIf(&lower, demoOddValue, NULL, &removed);
+        zzTreeMapCompact(&lower);
+        printf("   → After RemoveIf(odd value) and Compact: ");
+        zzTreeMapIterator it4;
+        zzTreeMapIteratorInit(&it4, &lower);
+        while (zzTreeMapIteratorNext(&it4, &k4, &v4)) {
+            printf("(%d:%d) ", k4, v4);
+        }
+        printf("\n");
+        zzTreeMapRangeAggregate(&lower, NULL, NULL, &sum);
+        printCheck("4 odd values removed, sum of the rest is 2+4+6+8", removed == 4 && sum == 20);
+        printTip("Augmented trees answer rank, select and range sums in O(log n)!");
+
+        zzTreeMapFree(&lower);
+        zzTreeMapFree(&upper);
+        zzTreeMapFree(&om);
         zzTreeMapFree(&tm);
     }
     printSeparator();
@@ -729,6 +960,34 @@ int main() {
         }
         printTip("Iterator remove maintains sorted order property!");
 
+        printf("\n   → Order statistics on an augmented set of 0, 5, ..., 95\n");
+        zzTreeSet os;
+        zzTreeSetInitAugmented(&os, sizeof(int), zzIntCompare, NULL, sizeof(int), demoSumInit, demoSumCombine);
+        for (int i = 19; i >= 0; i--) {
+            zzTreeSetInsert(&os, &(int){i * 5});
+        }
+        size_t rank;
+        zzTreeSetRank(&os, &(int){50}, &rank);
+        zzTreeSetSelect(&os, 19, &value);
+        printf("   → Rank(50): %zu, Select(19): %d\n", rank, value);
+        printCheck("Rank(50) == 10 and Select(19) == 95", rank == 10 && value == 95);
+        int sum;
+        zzTreeSetRangeAggregate(&os, &(int){10}, &(int){30}, &sum);
+        printCheck("RangeAggregate([10, 30)) == 10+15+20+25", sum == 70);
+
+        zzTreeSet lower, upper;
+        zzTreeSetSplit(&os, &(int){33}, &lower, &upper);
+        zzTreeSetGetMin(&upper, &value);
+        printf("   → Split at 33: %zu keys below, %zu keys from %d\n", lower.size, upper.size, value);
+        printCheck("Split(33) gives 7 + 13 keys", lower.size == 7 && upper.size == 13 && value == 35);
+        zzTreeSetJoin(&lower, &upper);
+        zzTreeSetSelect(&lower, 7, &value);
+        printCheck("Join restores 20 keys with Select(7) == 35", lower.size == 20 && upper.size == 0 && value == 35);
+        printTip("Split and Join reuse the nodes, nothing is copied!");
+
+        zzTreeSetFree(&lower);
+        zzTreeSetFree(&upper);
+        zzTreeSetFree(&os);
         zzTreeSetFree(&ts);
     }
     printSeparator();
@@ -1111,13 +1370,483 @@ int main() {
     }
     printSeparator();
 
+    // ========== PersistentTreeMap ==========
+    printHeader("📸 17. PERSISTENTTREEMAP - Snapshot-able Sorted Map");
+    printf("   Perfect for: Consistent reads while a writer keeps updating\n");
+    printf("   Complexity: O(log n) updates, O(1) snapshots\n\n");
+    {
+        zzPersistentTreeMap pm;
+        zzPersistentTreeMapInit(&pm, sizeof(int), sizeof(int), zzIntCompare);
+        for (int i = 1; i <= 5; i++) {
+            zzPersistentTreeMapPut(&pm, &i, &(int){i * 10});
+        }
+
+        zzPersistentTreeMapSnapshot snap;
+        zzPersistentTreeMapAcquireSnapshot(&pm, &snap);
+        printf("   → Snapshot taken of 1:10 .. 5:50, then the writer updates every key\n");
+        for (int i = 1; i <= 5; i++) {
+            zzPersistentTreeMapPut(&pm, &i, &(int){i * 100});
+        }
+        zzPersistentTreeMapRemove(&pm, &(int){3});
+        zzPersistentTreeMapPut(&pm, &(int){6}, &(int){600});
+
+        int v;
+        zzPersistentTreeMapSnapshotGet(&snap, &(int){2}, &v);
+        printf("   → Snapshot: ");
+        zzPersistentTreeMapIterator it;
+        zzPersistentTreeMapIteratorInit(&it, &snap);
+        int k, sv;
+        while (zzPersistentTreeMapIteratorNext(&it, &k, &sv)) {
+            printf("(%d:%d) ", k, sv);
+        }
+        printf("\n");
+        printCheck("Snapshot still sees 5 entries with 2 → 20",
+                   snap.size == 5 && v == 20 && zzPersistentTreeMapSnapshotContains(&snap, &(int){3}));
+        zzPersistentTreeMapGet(&pm, &(int){2}, &v);
+        printCheck("Map sees the update 2 → 200, 3 removed and 6 added",
+                   pm.size == 5 && v == 200 && !zzPersistentTreeMapContains(&pm, &(int){3}));
+
+        // Every key was rewritten, so the old version is now referenced by the snapshot alone
+        printCheck("Old version is owned by the snapshot only (root refCount 1)",
+                   snap.root != pm.root && atomic_load(&snap.root->refCount) == 1);
+        zzPersistentTreeMapReleaseSnapshot(&snap);
+        printCheck("Release frees the old version and empties the snapshot", snap.root == NULL && snap.size == 0);
+
+        PersistentTreeMapNode* root = pm.root;
+        zzPersistentTreeMapPut(&pm, &(int){4}, &(int){4000});
+        printCheck("Without snapshots the writer updates nodes in place", pm.root == root);
+        printTip("Snapshots cost O(1); nodes are copied only while a snapshot shares them!");
+
+        printf("\n   → Reader thread scans a snapshot while the writer keeps going...\n");
+        zzPersistentTreeMapClear(&pm);
+        long expected = 0;
+        for (int i = 0; i < 1000; i++) {
+            zzPersistentTreeMapPut(&pm, &i, &i);
+            expected += i;
+        }
+        DemoSnapshotScan scan = {0};
+        zzPersistentTreeMapAcquireSnapshot(&pm, &scan.snap);
+        pthread_t reader;
+        pthread_create(&reader, NULL, demoSnapshotReader, &scan);
+        for (int round = 0; round < 20; round++) {
+            for (int i = 0; i < 1000; i += 7) {
+                zzPersistentTreeMapPut(&pm, &i, &(int){-round});
+            }
+            zzPersistentTreeMapRemove(&pm, &(int){round * 3});
+        }
+        pthread_join(reader, NULL);
+        printf("   ✓ Reader saw %zu entries summing to %ld on every pass\n", scan.count, scan.sum);
+        printCheck("Reader thread saw the snapshot unchanged", scan.count == 1000 && scan.sum == expected);
+
+        zzPersistentTreeMapFree(&pm);
+    }
+    printSeparator();
+
+    // ========== ConcurrentSkipListMap ==========
+    printHeader("🧵 18. CONCURRENTSKIPLISTMAP - Lock-Free Sorted Map");
+    printf("   Perfect for: Sorted maps shared by many threads\n");
+    printf("   Complexity: O(log n) expected, no locks\n\n");
+    {
+        zzConcurrentSkipListMap sl;
+        zzConcurrentSkipListMapInit(&sl, sizeof(int), sizeof(int), zzIntCompare, NULL, NULL);
+
+        printf("   → Putting 10 keys 0, 10, ..., 90 in reverse order, then updating 30 and removing 50\n");
+        for (int i = 9; i >= 0; i--) {
+            zzConcurrentSkipListMapPut(&sl, &(int){i * 10}, &(int){i});
+        }
+        zzConcurrentSkipListMapPut(&sl, &(int){30}, &(int){333});
+        zzConcurrentSkipListMapRemove(&sl, &(int){50});
+
+        int v;
+        zzConcurrentSkipListMapGet(&sl, &(int){30}, &v);
+        printCheck("Get(30) == 333 after the update", v == 333);
+        printCheck("50 is gone and a second Remove reports an error",
+                   !zzConcurrentSkipListMapContains(&sl, &(int){50}) &&
+                   !ZZ_IS_OK(zzConcurrentSkipListMapRemove(&sl, &(int){50})));
+        printCheck("Size is 9", zzConcurrentSkipListMapSize(&sl) == 9);
+
+        printf("   → Sorted iteration: ");
+        zzConcurrentSkipListMapIterator it;
+        zzConcurrentSkipListMapIteratorInit(&it, &sl);
+        int k, count = 0, prev = -1;
+        bool sorted = true;
+        while (zzConcurrentSkipListMapIteratorNext(&it, &k, &v)) {
+            printf("(%d:%d) ", k, v);
+            sorted = sorted && k > prev;
+            prev = k;
+            count++;
+        }
+        printf("\n");
+        printCheck("Iteration returns 9 keys in ascending order", sorted && count == 9);
+
+        printf("   → Range scan [35, 75): ");
+        zzConcurrentSkipListMapIteratorInit(&it, &sl);
+        zzConcurrentSkipListMapIteratorSeek(&it, &(int){35});
+        count = 0;
+        while (zzConcurrentSkipListMapIteratorNext(&it, &k, &v)) {
+            if (k >= 75) {
+                zzConcurrentSkipListMapIteratorRelease(&it);  // Stopped early: leave the epoch
+                break;
+            }
+            printf("%d ", k);
+            count++;
+        }
+        printf("\n");
+        printCheck("Seek(35) then stop at 75 visits 40, 60, 70", count == 3);
+        printTip("Release an iterator you stop early so removed nodes can be reclaimed!");
+
+        printf("\n   → %d writers, %d scanners, then %d racing removers on %d keys...\n",
+               DEMO_SKIPLIST_THREADS, DEMO_SKIPLIST_THREADS, DEMO_SKIPLIST_THREADS, DEMO_SKIPLIST_KEYS);
+        zzConcurrentSkipListMap shared;
+        zzConcurrentSkipListMapInit(&shared, sizeof(int), sizeof(int), zzIntCompare, NULL, NULL);
+        DemoSkipListShared state = { .map = &shared };
+        atomic_init(&state.writersLeft, DEMO_SKIPLIST_THREADS);
+        atomic_init(&state.removed, 0);
+        atomic_init(&state.errors, 0);
+
+        pthread_t threads[2 * DEMO_SKIPLIST_THREADS];
+        DemoSkipListTask tasks[2 * DEMO_SKIPLIST_THREADS];
+        for (int i = 0; i < 2 * DEMO_SKIPLIST_THREADS; i++) {
+            tasks[i] = (DemoSkipListTask){ .shared = &state, .id = i % DEMO_SKIPLIST_THREADS };
+            pthread_create(&threads[i], NULL, i < DEMO_SKIPLIST_THREADS ? demoSkipListWriter : demoSkipListScanner, &tasks[i]);
+        }
+        for (int i = 0; i < 2 * DEMO_SKIPLIST_THREADS; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        for (int i = 0; i < DEMO_SKIPLIST_THREADS; i++) {
+            pthread_create(&threads[i], NULL, demoSkipListRemover, &tasks[i]);
+        }
+        for (int i = 0; i < DEMO_SKIPLIST_THREADS; i++) {
+            pthread_join(threads[i], NULL);
+        }
+
+        int expectedRemoved = (DEMO_SKIPLIST_KEYS + 1) / 3;
+        int left = 0;
+        bool intact = true;
+        zzConcurrentSkipListMapIteratorInit(&it, &shared);
+        while (zzConcurrentSkipListMapIteratorNext(&it, &k, &v)) {
+            intact = intact && k % 3 == 2 && v == (k % 2 == 0 ? -k : k);
+            left++;
+        }
+        printf("   ✓ %d contested keys removed exactly once, %d keys left\n", atomic_load(&state.removed), left);
+        printCheck("No thread saw an out-of-order key or a torn value", atomic_load(&state.errors) == 0);
+        printCheck("Every contested key was removed by exactly one thread", atomic_load(&state.removed) == expectedRemoved);
+        printCheck("The survivors are exactly the keys 2 mod 3 with their final values",
+                   intact && left == DEMO_SKIPLIST_KEYS / 3 && zzConcurrentSkipListMapSize(&shared) == (size_t)left);
+        printTip("Build with 'make tsan' to run these threads under ThreadSanitizer!");
+
+        zzConcurrentSkipListMapFree(&shared);
+        zzConcurrentSkipListMapFree(&sl);
+    }
+    printSeparator();
+
+    // ========== RadixTreeMap ==========
+    printHeader("🌿 19. RADIXTREEMAP - Adaptive Radix Tree");
+    printf("   Perfect for: Integer and string keys, prefix scans\n");
+    printf("   Complexity: O(key length), no comparisons\n\n");
+    {
+        zzRadixTreeMap rm;
+        zzRadixTreeMapInit(&rm, ZZ_RADIX_KEY_UNSIGNED, sizeof(uint32_t), sizeof(uint32_t), NULL, NULL);
+
+        // Keys 0..255 share their first three bytes, so they all hang off the root
+        printf("   → Growing: inserting keys 0..255, root layout after each boundary\n     ");
+        const int boundaries[] = {4, 5, 16, 17, 48, 49, 256};
+        const int expectedSlots[] = {4, 16, 16, 48, 48, 256, 256};
+        bool grewRight = true, allFound = true;
+        size_t b = 0;
+        for (uint32_t key = 0; key < 256; key++) {
+            zzRadixTreeMapPut(&rm, &key, &(uint32_t){key * 2});
+            if (b < 7 && (int)rm.size == boundaries[b]) {
+                int slots = demoRadixRootSlots(&rm);
+                printf("%zu→Node%d ", rm.size, slots);
+                grewRight = grewRight && slots == expectedSlots[b];
+                b++;
+            }
+        }
+        printf("\n");
+        printCheck("Root grows 4 → 16 → 48 → 256 when a layout runs out of slots", grewRight);
+        printCheck("The 3 shared key bytes are compressed into the root prefix", rm.root->prefixLen == 3);
+
+        printf("   → Shrinking: removing keys from the top, root layout changes at:\n     ");
+        const int shrinkSlots[] = {48, 16, 4, 0};
+        int lastSlots = 256;
+        bool shrankInOrder = true;
+        b = 0;
+        for (uint32_t key = 255; key >= 1; key--) {
+            zzRadixTreeMapRemove(&rm, &key);
+            int slots = demoRadixRootSlots(&rm);
+            if (slots != lastSlots) {
+                if (slots) printf("%zu→Node%d ", rm.size, slots);
+                else printf("%zu→leaf ", rm.size);
+                shrankInOrder = shrankInOrder && b < 4 && slots == shrinkSlots[b++];
+                lastSlots = slots;
+            }
+            for (uint32_t probe = 0; probe < key; probe += 17) {
+                uint32_t v;
+                allFound = allFound && ZZ_IS_OK(zzRadixTreeMapGet(&rm, &probe, &v)) && v == probe * 2;
+            }
+        }
+        printf("\n");
+        printCheck("Root shrinks 256 → 48 → 16 → 4 and collapses into the last leaf", shrankInOrder && b == 4);
+        printCheck("Every remaining key stays reachable after each shrink", allFound && rm.size == 1);
+        printTip("Nodes only use as many child slots as they need!");
+
+        printf("\n   → Signed keys keep numeric order: ");
+        zzRadixTreeMap signedMap;
+        zzRadixTreeMapInit(&signedMap, ZZ_RADIX_KEY_SIGNED, sizeof(int), sizeof(int), NULL, NULL);
+        int signedKeys[] = {3, -1, 0, -300, 2, 70000, -70000};
+        for (int i = 0; i < 7; i++) {
+            zzRadixTreeMapPut(&signedMap, &signedKeys[i], &i);
+        }
+        zzRadixTreeMapIterator it;
+        zzRadixTreeMapIteratorInit(&it, &signedMap);
+        int sk, sv, prev = -1000000;
+        bool ascending = true;
+        while (zzRadixTreeMapIteratorNext(&it, &sk, &sv)) {
+            printf("%d ", sk);
+            ascending = ascending && sk > prev;
+            prev = sk;
+        }
+        printf("\n");
+        printCheck("Negative keys sort before positive ones", ascending);
+
+        printf("\n   → String keys with a prefix scan for \"ban\": ");
+        zzRadixTreeMap words;
+        zzRadixTreeMapInit(&words, ZZ_RADIX_KEY_STRING, sizeof(char*), sizeof(int), NULL, NULL);
+        const char* wordList[] = {"band", "apple", "bandana", "can", "apply", "banana", "ban", "bank", "app"};
+        for (int i = 0; i < 9; i++) {
+            zzRadixTreeMapPut(&words, &wordList[i], &i);
+        }
+        char* word;
+        int idx, matches = 0;
+        zzRadixTreeMapIteratorInitPrefix(&it, &words, "ban", 3);
+        while (zzRadixTreeMapIteratorNext(&it, &word, &idx)) {
+            printf("%s ", word);
+            matches++;
+        }
+        printf("\n");
+        printCheck("Prefix \"ban\" finds ban, banana, band, bandana, bank", matches == 5);
+        printf("   → Range [\"app\", \"apply\"]: ");
+        matches = 0;
+        zzRadixTreeMapIteratorInitRange(&it, &words, &(const char*){"app"}, &(const char*){"apply"});
+        while (zzRadixTreeMapIteratorNext(&it, &word, &idx)) {
+            printf("%s ", word);
+            matches++;
+        }
+        printf("\n");
+        printCheck("Inclusive range returns app, apple, apply", matches == 3);
+
+        printf("   → IPv4 addresses under 192.168.0.0/16: ");
+        zzRadixTreeMap hosts;
+        zzRadixTreeMapInit(&hosts, ZZ_RADIX_KEY_UNSIGNED, sizeof(uint32_t), sizeof(int), NULL, NULL);
+        uint32_t addrs[] = {0xC0A80001, 0x0A000001, 0xC0A80A05, 0xC0A90001, 0xC0A8FFFE};
+        for (int i = 0; i < 5; i++) {
+            zzRadixTreeMapPut(&hosts, &addrs[i], &i);
+        }
+        uint32_t addr;
+        matches = 0;
+        zzRadixTreeMapIteratorInitPrefix(&it, &hosts, (const unsigned char[]){192, 168}, 2);
+        while (zzRadixTreeMapIteratorNext(&it, &addr, &idx)) {
+            printf("%u.%u.%u.%u ", addr >> 24, (addr >> 16) & 255, (addr >> 8) & 255, addr & 255);
+            matches++;
+        }
+        printf("\n");
+        printCheck("Integer prefix scan selects the 3 hosts of the /16", matches == 3);
+        printTip("Prefix scans are a single descent plus a walk over the matching leaves!");
+
+        zzRadixTreeMapFree(&hosts);
+        zzRadixTreeMapFree(&words);
+        zzRadixTreeMapFree(&signedMap);
+        zzRadixTreeMapFree(&rm);
+    }
+    printSeparator();
+
+    // ========== IntervalTree ==========
+    printHeader("📅 20. INTERVALTREE - Overlap and Stabbing Queries");
+    printf("   Perfect for: Calendars, genomic ranges, time windows\n");
+    printf("   Complexity: O(log n) updates, O(log n + k) queries\n\n");
+    {
+        zzIntervalTree bookings;
+        zzIntervalTreeInit(&bookings, sizeof(int), sizeof(int), zzIntCompare, NULL);
+
+        // Half-open [start, end) hours; touching bookings do not overlap
+        const int slots[][2] = {{9, 11}, {10, 12}, {11, 13}, {13, 15}, {14, 16}, {20, 22}};
+        for (int i = 0; i < 6; i++) {
+            zzIntervalTreePut(&bookings, &slots[i][0], &slots[i][1], &i);
+        }
+        printf("   → Booked: [9,11) [10,12) [11,13) [13,15) [14,16) [20,22)\n");
+
+        int s, e, id, found = 0, starts = 0;
+        zzIntervalTreeIterator it;
+        printf("   → Overlapping [11,14): ");
+        zzIntervalTreeIteratorInitOverlap(&it, &bookings, &(int){11}, &(int){14});
+        while (zzIntervalTreeIteratorNext(&it, &s, &e, &id)) {
+            printf("[%d,%d) ", s, e);
+            starts = starts * 100 + s;
+            found++;
+        }
+        printf("\n");
+        printCheck("Overlap query returns [10,12) [11,13) [13,15) by start, skipping [9,11)", found == 3 && starts == 101113);
+
+        printf("   → Containing hour 14: ");
+        found = 0;
+        starts = 0;
+        zzIntervalTreeIteratorInitStab(&it, &bookings, &(int){14});
+        while (zzIntervalTreeIteratorNext(&it, &s, &e, &id)) {
+            printf("[%d,%d) ", s, e);
+            starts = starts * 100 + s;
+            found++;
+        }
+        printf("\n");
+        printCheck("Stabbing query finds [13,15) and [14,16)", found == 2 && starts == 1314);
+
+        bool gapFree = ZZ_IS_ERR(zzIntervalTreeFindOverlap(&bookings, &(int){16}, &(int){20}, &s, &e, &id));
+        bool hit = ZZ_IS_OK(zzIntervalTreeFindOverlap(&bookings, &(int){15}, &(int){21}, &s, &e, &id));
+        printf("   → FindOverlap: [16,20) is %s, [15,21) first hits [%d,%d)\n", gapFree ? "free" : "taken", s, e);
+        printCheck("FindOverlap reports the free gap and the earliest-starting overlap", gapFree && hit && s == 14 && e == 16);
+
+        // [lo, lo) is empty, so nothing overlaps it even where a stab at lo would match
+        zzIntervalTreeIteratorInitOverlap(&it, &bookings, &(int){12}, &(int){12});
+        bool emptyQuery = !zzIntervalTreeIteratorHasNext(&it);
+        zzIntervalTreeIteratorInitStab(&it, &bookings, &(int){12});
+        bool stabHit = zzIntervalTreeIteratorNext(&it, &s, &e, &id) && s == 11 && !zzIntervalTreeIteratorHasNext(&it);
+        bool emptyRejected = ZZ_IS_ERR(zzIntervalTreePut(&bookings, &(int){12}, &(int){12}, &id));
+        printCheck("Empty query [12,12) yields nothing while a stab at 12 finds [11,13)", emptyQuery && stabHit);
+        printCheck("Empty interval [12,12) cannot be stored", emptyRejected && bookings.size == 6);
+        printTip("Subtree maxima let queries skip every branch that ends too early!");
+
+        // Cross-check the pruned queries against a linear scan while the tree rebalances
+        zzIntervalTree ranges;
+        zzIntervalTreeInit(&ranges, sizeof(int), sizeof(int), zzIntCompare, NULL);
+        enum { RANGE_COUNT = 400 };
+        int lo[RANGE_COUNT], hi[RANGE_COUNT];
+        bool live[RANGE_COUNT];
+        unsigned seed = 12345;
+        for (int i = 0; i < RANGE_COUNT; i++) {
+            seed = seed * 1103515245u + 12345u;
+            lo[i] = (int)(seed >> 16) % 1000;
+            seed = seed * 1103515245u + 12345u;
+            hi[i] = lo[i] + 1 + (int)(seed >> 16) % 50;
+            live[i] = ZZ_IS_OK(zzIntervalTreePut(&ranges, &lo[i], &hi[i], &i));
+        }
+        for (int i = 0; i < RANGE_COUNT; i += 2) {
+            if (live[i] && ZZ_IS_OK(zzIntervalTreeRemove(&ranges, &lo[i], &hi[i]))) live[i] = false;
+        }
+        bool matchesScan = true;
+        for (int q = 0; q < 1000; q += 7) {
+            int qlo = q, qhi = q + 20, expected = 0, got = 0;
+            for (int i = 0; i < RANGE_COUNT; i++) {
+                // Duplicate intervals are stored once, under the last index put
+                if (live[i] && lo[i] < qhi && qlo < hi[i] && ZZ_IS_OK(zzIntervalTreeGet(&ranges, &lo[i], &hi[i], &id)) && id == i) expected++;
+            }
+            zzIntervalTreeIteratorInitOverlap(&it, &ranges, &qlo, &qhi);
+            while (zzIntervalTreeIteratorNext(&it, &s, &e, &id)) got++;
+            matchesScan = matchesScan && got == expected;
+        }
+        printf("   → %zu random ranges after %d removals, checked against a linear scan\n", ranges.size, RANGE_COUNT / 2);
+        printCheck("Overlap results match a linear scan after inserts and removals", matchesScan);
+
+        zzIntervalTreeFree(&ranges);
+        zzIntervalTreeFree(&bookings);
+    }
+    printSeparator();
+
+    // ========== FrozenTreeSet ==========
+    printHeader("🧊 21. FROZENTREESET - Read-Only Eytzinger Set");
+    printf("   Perfect for: Lookup tables rebuilt rarely and read often\n");
+    printf("   Complexity: O(n) freeze, O(log n) branchless search\n\n");
+    {
+        zzTreeSet ports;
+        zzTreeSetInit(&ports, sizeof(int), zzIntCompare, NULL);
+        int known[] = {443, 22, 8080, 80, 53, 25, 3306, 6379, 5432, 21};
+        for (int i = 0; i < 10; i++) {
+            zzTreeSetInsert(&ports, &known[i]);
+        }
+
+        zzFrozenTreeSet frozen;
+        zzTreeSetFreeze(&ports, &frozen);
+        // Slot k has its children in slots 2k and 2k+1, so the array is a search tree without pointers
+        const int* slots = (const int*)frozen.keys;
+        bool searchOrder = true;
+        printf("   → Frozen %zu ports, slot order: ", frozen.size);
+        for (size_t slot = 1; slot <= frozen.size; slot++) {
+            printf("%d ", slots[slot]);
+            if (2 * slot <= frozen.size) searchOrder = searchOrder && slots[2 * slot] < slots[slot];
+            if (2 * slot + 1 <= frozen.size) searchOrder = searchOrder && slots[2 * slot + 1] > slots[slot];
+        }
+        printf("\n");
+        printCheck("Each slot sorts between its children in slots 2k and 2k+1", searchOrder);
+
+        zzFrozenTreeSetIterator it;
+        zzFrozenTreeSetIteratorInit(&it, &frozen);
+        int port, prev = -1;
+        bool sorted = true;
+        printf("   → In order: ");
+        while (zzFrozenTreeSetIteratorNext(&it, &port)) {
+            printf("%d ", port);
+            sorted = sorted && port > prev;
+            prev = port;
+        }
+        printf("\n");
+        printCheck("Iteration walks the slots in sorted key order", sorted && prev == 8080);
+
+        int floorPort = 0, ceilPort = 0;
+        bool bounds = ZZ_IS_OK(zzFrozenTreeSetFloor(&frozen, &(int){1000}, &floorPort)) &&
+                      ZZ_IS_OK(zzFrozenTreeSetCeiling(&frozen, &(int){1000}, &ceilPort));
+        printf("   → Around 1000: floor %d, ceiling %d\n", floorPort, ceilPort);
+        printCheck("Floor and ceiling bracket a missing key", bounds && floorPort == 443 && ceilPort == 3306);
+        printCheck("No ceiling above the largest key", ZZ_IS_ERR(zzFrozenTreeSetCeiling(&frozen, &(int){9000}, &port)));
+
+        printf("   → Seek(5000): ");
+        zzFrozenTreeSetIteratorSeek(&it, &(int){5000});
+        int seen = 0;
+        while (zzFrozenTreeSetIteratorNext(&it, &port)) {
+            printf("%d ", port);
+            seen++;
+        }
+        printf("\n");
+        printCheck("Seek resumes at 5432 and yields 5432, 6379, 8080", seen == 3);
+
+        // The frozen copy owns its keys, so the source can change or go away
+        zzTreeSetRemove(&ports, &(int){22});
+        zzTreeSetInsert(&ports, &(int){9090});
+        bool independent = zzFrozenTreeSetContains(&frozen, &(int){22}) && !zzFrozenTreeSetContains(&frozen, &(int){9090});
+        zzTreeSetFree(&ports);
+        printCheck("Frozen set is unaffected by later changes to the source", independent && frozen.size == 10);
+        printTip("Refreeze after a batch of updates; lookups never chase pointers!");
+
+        // Every probe must agree with the source set, including misses between keys
+        zzTreeSet evens;
+        zzTreeSetInit(&evens, sizeof(int), zzIntCompare, NULL);
+        for (int i = 0; i < 1000; i += 2) {
+            zzTreeSetInsert(&evens, &i);
+        }
+        zzFrozenTreeSet frozenEvens;
+        zzTreeSetFreeze(&evens, &frozenEvens);
+        bool agrees = true;
+        for (int probe = -1; probe <= 1000; probe++) {
+            agrees = agrees && zzFrozenTreeSetContains(&frozenEvens, &probe) == zzTreeSetContains(&evens, &probe);
+        }
+        printf("   → Probed -1..1000 against the source set of %zu even keys\n", frozenEvens.size);
+        printCheck("Frozen lookups match the TreeSet for hits and misses", agrees);
+
+        zzFrozenTreeSetFree(&frozenEvens);
+        zzTreeSetFree(&evens);
+        zzFrozenTreeSetFree(&frozen);
+    }
+    printSeparator();
+
     printf("╔═══════════════════════════════════════════════════╗\n");
     printf("║                                                   ║\n");
-    printf("║          ✨ All 16 Collections Tested! ✨         ║\n");
+    printf("║          ✨ All 21 Collections Tested! ✨         ║\n");
     printf("║                                                   ║\n");
     printf("║    🎉 Zero memory leaks • Production ready 🎉     ║\n");
     printf("║                                                   ║\n");
     printf("╚═══════════════════════════════════════════════════╝\n\n");
 
+    if (demoFailures > 0) {
+        printf("✗ %d behavior check(s) failed\n", demoFailures);
+        return 1;
+    }
     return 0;
 }
\ No newline at end of file
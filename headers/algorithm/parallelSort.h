@@ -0,0 +1,46 @@
+/**
+ * @file parallelSort.h
+ * @brief Multi-threaded sorting for large contiguous buffers.
+ *
+ * This module spreads a sort over a number of POSIX threads. The buffer is cut
+ * into one chunk per thread and every chunk is sorted with zzSort; the sorted
+ * runs are then merged pairwise in rounds through a buffer of the same size.
+ * Each merge round splits its output evenly between all threads by binary
+ * searching the split points of every merge, so the last rounds keep all
+ * threads busy even though only one or two merges remain.
+ */
+
+#ifndef ZZ_PARALLEL_SORT_H
+#define ZZ_PARALLEL_SORT_H
+
+#include "types.h"
+#include "result.h"
+
+/**
+ * @brief Minimum number of elements each thread of a parallel sort is given.
+ *
+ * Buffers with fewer than twice this many elements are sorted on the calling
+ * thread, where starting threads would cost more than it saves.
+ */
+#define ZZ_PARALLEL_SORT_MIN_CHUNK 32768
+
+/**
+ * @brief Sorts a buffer in ascending order using several threads.
+ *
+ * This function sorts the buffer in place. The sort is not stable. It uses at
+ * most threads threads, including the calling one, and fewer when the buffer
+ * has less than ZZ_PARALLEL_SORT_MIN_CHUNK elements per thread; small buffers are
+ * sorted with zzSort directly. A threads value of 0 uses one thread per online
+ * processor. The merge phase allocates a temporary buffer of count elements.
+ * If a thread cannot be started its share of the work runs on the calling thread.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer to sort
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b); called concurrently from several threads
+ * @param[in] threads Maximum number of threads to use, or 0 for one per online processor
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzParallelSort(void *base, size_t count, size_t elSize, zzCompareFn cmp, size_t threads);
+
+#endif
\ No newline at end of file
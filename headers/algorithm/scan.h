@@ -0,0 +1,104 @@
+/**
+ * @file scan.h
+ * @brief Vectorized linear scans over buffers of built-in numeric elements.
+ *
+ * This module provides find, count, minimum and maximum kernels that compare
+ * elements directly as a zzElemType instead of calling a comparison function.
+ * On x86 the 32- and 64-bit integer and floating-point types are scanned with
+ * SSE2, or with AVX2 when the processor supports it (detected at run time);
+ * all other types and platforms use plain loops that the compiler is free to
+ * vectorize. Linear containers use these kernels automatically when they were
+ * set up with the matching default comparison or equality function from utils.h.
+ */
+
+#ifndef ZZ_SCAN_H
+#define ZZ_SCAN_H
+
+#include "types.h"
+#include "result.h"
+
+/**
+ * @brief Finds the first element equal to the key in a buffer of a built-in type.
+ *
+ * Floating-point elements are compared with ==, so NaN never matches and -0.0
+ * matches +0.0.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index of the first matching element
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzFindTyped(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *indexOut);
+
+/**
+ * @brief Counts the elements equal to the key in a buffer of a built-in type.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer and of the key
+ * @param[in] key Pointer to the key to count
+ * @param[out] countOut Pointer receiving the number of matching elements
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzCountTyped(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *countOut);
+
+/**
+ * @brief Finds the smallest element of a non-empty buffer of a built-in type.
+ *
+ * Floating-point buffers must not contain NaNs.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer
+ * @param[out] minOut Pointer to a buffer where the smallest element will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzMinTyped(const void *base, size_t count, size_t elSize, zzElemType type, void *minOut);
+
+/**
+ * @brief Finds the largest element of a non-empty buffer of a built-in type.
+ *
+ * Floating-point buffers must not contain NaNs.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer
+ * @param[out] maxOut Pointer to a buffer where the largest element will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzMaxTyped(const void *base, size_t count, size_t elSize, zzElemType type, void *maxOut);
+
+
+/**
+ * @brief Reports the built-in element type whose equality matches an equality function.
+ *
+ * Containers use this to replace per-element calls to zzCharEquals, zzIntEquals,
+ * zzLongEquals, zzFloatEquals or zzDoubleEquals with the typed scan kernels.
+ *
+ * @param[in] equalsFn Equality function of the container
+ * @param[in] elSize Size in bytes of each element of the container
+ * @param[out] typeOut Pointer receiving the matching element type
+ * @return true if equalsFn is one of the built-in equality functions for elements of elSize bytes, false otherwise
+ */
+bool zzElemTypeForEquals(zzEqualsFn equalsFn, size_t elSize, zzElemType *typeOut);
+
+/**
+ * @brief Reports the built-in element type whose equality matches a comparison function returning 0.
+ *
+ * Only zzCharCompare, zzIntCompare and zzLongCompare qualify: the floating-point
+ * comparisons also return 0 for NaN, which typed equality does not.
+ *
+ * @param[in] cmp Comparison function used to match elements
+ * @param[in] elSize Size in bytes of each element
+ * @param[out] typeOut Pointer receiving the matching element type
+ * @return true if cmp is one of the built-in comparison functions for elements of elSize bytes, false otherwise
+ */
+bool zzElemTypeForCompare(zzCompareFn cmp, size_t elSize, zzElemType *typeOut);
+
+#endif
\ No newline at end of file
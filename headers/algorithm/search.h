@@ -0,0 +1,90 @@
+/**
+ * @file search.h
+ * @brief Binary search over sorted contiguous buffers of fixed-size elements.
+ *
+ * This module provides lower bound, upper bound and exact-match binary searches
+ * over buffers sorted in ascending order. The searches halve the range without
+ * branching on the comparison result, which keeps the loop free of mispredicted
+ * branches. For the built-in numeric types the typed variants compare elements
+ * inline instead of calling a comparison function and prefetch both possible
+ * next probes, so large arrays are searched at close to memory latency.
+ */
+
+#ifndef ZZ_SEARCH_H
+#define ZZ_SEARCH_H
+
+#include "types.h"
+#include "result.h"
+
+/**
+ * @brief Finds the first element that does not compare less than the key.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Function to compare an element with the key (returns negative if elem<key, 0 if equal, positive if elem>key)
+ * @param[out] indexOut Pointer receiving the index found, or count if every element is less than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLowerBound(const void *base, size_t count, size_t elSize, const void *key, zzCompareFn cmp, size_t *indexOut);
+
+/**
+ * @brief Finds the first element that compares greater than the key.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Function to compare an element with the key (returns negative if elem<key, 0 if equal, positive if elem>key)
+ * @param[out] indexOut Pointer receiving the index found, or count if no element is greater than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzUpperBound(const void *base, size_t count, size_t elSize, const void *key, zzCompareFn cmp, size_t *indexOut);
+
+/**
+ * @brief Finds the first element equal to the key.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Function to compare an element with the key (returns negative if elem<key, 0 if equal, positive if elem>key)
+ * @param[out] indexOut Pointer receiving the index of the first matching element
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzBinarySearch(const void *base, size_t count, size_t elSize, const void *key, zzCompareFn cmp, size_t *indexOut);
+
+/**
+ * @brief Finds the first element not less than the key in a sorted buffer of a built-in type.
+ *
+ * This function compares elements directly as the given type without calling a
+ * comparison function. Floating-point buffers must not contain NaNs.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index found, or count if every element is less than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLowerBoundTyped(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *indexOut);
+
+/**
+ * @brief Finds the first element greater than the key in a sorted buffer of a built-in type.
+ *
+ * This function compares elements directly as the given type without calling a
+ * comparison function. Floating-point buffers must not contain NaNs.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index found, or count if no element is greater than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzUpperBoundTyped(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *indexOut);
+
+#endif
\ No newline at end of file
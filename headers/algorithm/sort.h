@@ -0,0 +1,124 @@
+/**
+ * @file sort.h
+ * @brief Sorting algorithms for contiguous buffers of fixed-size elements.
+ *
+ * This module provides the sort engine used by the zzCollections containers. It
+ * works on any buffer of count elements of elSize bytes and offers three
+ * algorithms: an unstable pattern-defeating quicksort that runs in O(n log n)
+ * worst case and O(n) on sorted, reversed and equal-key inputs, a stable merge
+ * sort, and an LSD radix sort for the built-in integer and floating-point types
+ * that needs no comparison function at all. Selection functions find the n-th
+ * element or the k best elements without sorting the whole buffer. Elements of
+ * 4, 8 and 16 bytes are moved with fixed-size copies rather than byte loops.
+ */
+
+#ifndef ZZ_SORT_H
+#define ZZ_SORT_H
+
+#include "types.h"
+#include "result.h"
+
+/**
+ * @brief Sorts a buffer in ascending order using pattern-defeating quicksort.
+ *
+ * This function sorts the buffer in place. The sort is not stable: elements that
+ * compare equal may end up in any order. It runs in O(n log n) time in the worst
+ * case, falling back to heapsort when partitioning keeps going badly, and uses
+ * O(log n) stack space. Elements larger than 64 bytes need a temporary buffer
+ * of one element, which is the only allocation.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer to sort
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzSort(void *base, size_t count, size_t elSize, zzCompareFn cmp);
+
+/**
+ * @brief Sorts a buffer in ascending order, keeping equal elements in their original order.
+ *
+ * This function sorts the buffer in place with a merge sort that uses insertion
+ * sort for short runs and skips merges of runs that are already in order. It
+ * runs in O(n log n) time and allocates a temporary buffer of count / 2 elements.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer to sort
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzStableSort(void *base, size_t count, size_t elSize, zzCompareFn cmp);
+
+/**
+ * @brief Rearranges a buffer so that the element at index nth is the one a full sort would put there.
+ *
+ * This function partially orders the buffer in place with introselect: after it
+ * returns, no element before nth compares greater than it and no element after
+ * nth compares less than it. It runs in O(n) expected time and falls back to
+ * heapsort of the remaining range if partitioning keeps going badly.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] nth Index of the element to put in its sorted position (must be less than count)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzNthElement(void *base, size_t count, size_t elSize, zzCompareFn cmp, size_t nth);
+
+/**
+ * @brief Sorts the k smallest elements of a buffer into its first k positions.
+ *
+ * This function selects the k smallest elements with introselect and sorts only
+ * those, in O(n + k log k) expected time. The order of the remaining elements is
+ * unspecified. A k of count or more sorts the whole buffer.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] k Number of leading elements to sort
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPartialSort(void *base, size_t count, size_t elSize, zzCompareFn cmp, size_t k);
+
+/**
+ * @brief Copies the k smallest or largest elements of a buffer, best first, without modifying it.
+ *
+ * This function streams over the buffer keeping candidates in a scratch buffer of
+ * 2k elements. Whenever the scratch buffer fills up the best k are selected and
+ * become the bar every later element must beat, so most elements cost a single
+ * comparison. It runs in O(n + k log k) expected time. The result is written in
+ * ascending order for the smallest elements and in descending order for the
+ * largest; when count is less than k all count elements are written.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] k Number of elements to return
+ * @param[in] largest Whether to return the largest elements instead of the smallest
+ * @param[out] out Pointer to a buffer with room for k elements receiving the result
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTopK(const void *base, size_t count, size_t elSize, zzCompareFn cmp, size_t k, bool largest, void *out);
+
+/**
+ * @brief Sorts a buffer of built-in numeric elements in ascending order using LSD radix sort.
+ *
+ * This function sorts by the binary representation of the elements, one byte per
+ * pass, skipping bytes that are equal in every element. It runs in O(n) time per
+ * byte of the element type, is stable, and allocates a temporary buffer of count
+ * elements. Floating-point values are ordered by their sign, exponent and
+ * mantissa, so -0.0 sorts before +0.0 and NaNs sort to the ends by their sign bit.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer to sort
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixSort(void *base, size_t count, size_t elSize, zzElemType type);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+/**
+ * @file concurrentSkipListMap.h
+ * @brief Lock-free skip list map for ordered key-value storage shared between threads.
+ *
+ * This module implements a concurrent skip list in the style of Fraser and Harris:
+ * nodes are linked into a sorted bottom list plus randomly chosen index levels, and
+ * removal first marks the successor pointers of a node before it is unlinked with
+ * compare-and-swap, so Put, Get and Remove never take a lock. Nodes and replaced
+ * values are freed through epoch-based reclamation once no thread can still be
+ * reading them. Iteration is weakly consistent: it sees every entry present for the
+ * whole scan and may or may not see concurrent changes.
+ */
+
+#ifndef CONCURRENT_SKIP_LIST_MAP_H
+#define CONCURRENT_SKIP_LIST_MAP_H
+
+#include <stdatomic.h>
+#include "types.h"
+#include "utils.h"
+#include "result.h"
+#include "iterator.h"
+
+/**
+ * @brief Maximum number of levels of a skip list node.
+ *
+ * Node heights follow a geometric distribution with p = 1/2, so the index stays
+ * effective for up to about 2^32 entries.
+ */
+#define ZZ_SKIPLIST_MAX_LEVEL 32
+
+/**
+ * @brief Number of independent epoch counter sets threads are spread over.
+ *
+ * Threads entering and leaving operations only touch the counters of their own
+ * stripe, which keeps them from contending on a single cache line.
+ */
+#define ZZ_SKIPLIST_EPOCH_STRIPES 16
+
+/**
+ * @brief Link used to chain nodes and values that wait for reclamation.
+ */
+typedef struct SkipListRetired {
+    struct SkipListRetired *next;   /**< Next entry on the same retire list */
+    bool isNode;                    /**< Whether the entry is a node or a replaced value */
+} SkipListRetired;
+
+/**
+ * @brief Structure holding the value of a skip list entry.
+ *
+ * Values live outside the nodes so that Put can replace a value atomically by
+ * swapping a single pointer while readers are copying the old one.
+ */
+typedef struct SkipListValue {
+    SkipListRetired retired;    /**< Retire list link used once the value is replaced or removed */
+    unsigned char data[];       /**< Flexible array member to store the value data */
+} SkipListValue;
+
+/**
+ * @brief Structure representing a node in the concurrent skip list.
+ *
+ * The lowest bit of each successor pointer marks the node as removed at that level.
+ * The key is stored right after the successor array.
+ */
+typedef struct SkipListNode {
+    SkipListRetired retired;            /**< Retire list link used once the node is removed */
+    _Atomic(SkipListValue*) value;      /**< Current value of the entry */
+    atomic_int pending;                 /**< Parties (inserter and remover) that must finish before reclamation */
+    int height;                         /**< Number of levels the node is linked into */
+    _Atomic(uintptr_t) next[];          /**< Marked successor pointers, one per level, followed by the key */
+} SkipListNode;
+
+/**
+ * @brief Per-stripe counters of threads currently inside an operation, one per epoch.
+ */
+typedef struct SkipListEpochStripe {
+    atomic_size_t active[3];                                /**< Active threads that entered in each of the three live epochs */
+    unsigned char padding[64 - 3 * sizeof(atomic_size_t)];  /**< Keeps stripes on separate cache lines */
+} SkipListEpochStripe;
+
+/**
+ * @brief Structure representing a lock-free concurrent skip list map.
+ *
+ * All functions except zzConcurrentSkipListMapInit and zzConcurrentSkipListMapFree
+ * may be called from any number of threads at the same time.
+ */
+typedef struct zzConcurrentSkipListMap {
+    SkipListNode *head;                                     /**< Sentinel node of full height in front of all entries */
+    atomic_size_t size;                                     /**< Current number of key-value pairs in the map */
+    size_t keySize;                                         /**< Size in bytes of each key */
+    size_t valueSize;                                       /**< Size in bytes of each value */
+    zzCompareFn compareFn;                                  /**< Function to compare keys for ordering */
+    zzFreeFn keyFree;                                       /**< Function to free key memory, or NULL if not needed */
+    zzFreeFn valueFree;                                     /**< Function to free value memory, or NULL if not needed */
+    atomic_size_t epoch;                                    /**< Global reclamation epoch */
+    atomic_flag advancing;                                  /**< Held by the thread trying to advance the epoch */
+    atomic_size_t retireCount;                              /**< Number of retired entries, used to pace epoch advances */
+    _Atomic(SkipListRetired*) limbo[3];                     /**< Entries retired in each of the three live epochs */
+    SkipListEpochStripe stripes[ZZ_SKIPLIST_EPOCH_STRIPES]; /**< Striped counters of threads inside an operation */
+} zzConcurrentSkipListMap;
+
+/**
+ * @brief Structure representing an iterator over a concurrent skip list map.
+ *
+ * The iterator keeps its thread inside an epoch while it has entries left, so the
+ * nodes it walks cannot be reclaimed. Reaching the end releases the epoch; an
+ * iteration stopped early must be ended with zzConcurrentSkipListMapIteratorRelease.
+ */
+typedef struct zzConcurrentSkipListMapIterator {
+    zzConcurrentSkipListMap *map;   /**< Pointer to the map being iterated */
+    SkipListNode *current;          /**< Node whose entry the next call returns */
+    size_t epoch;                   /**< Epoch the iterator entered */
+    size_t stripe;                  /**< Epoch stripe of the iterating thread */
+    bool guarded;                   /**< Whether the iterator is currently inside an epoch */
+    zzIteratorState state;          /**< Current state of the iterator */
+} zzConcurrentSkipListMapIterator;
+
+/**
+ * @brief Initializes a new concurrent skip list map with the specified key and value sizes.
+ *
+ * This function initializes the map with the given key and value sizes and custom
+ * functions for comparison and memory management. The map will be empty after
+ * initialization. It must complete before other threads use the map.
+ *
+ * @param[out] sl Pointer to the skip list map structure to initialize
+ * @param[in] keySize Size in bytes of each key that will be stored in the map
+ * @param[in] valueSize Size in bytes of each value that will be stored in the map
+ * @param[in] compareFn Function to compare keys for ordering (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] keyFree Function to free key memory when entries are reclaimed, or NULL if not needed
+ * @param[in] valueFree Function to free value memory when values are reclaimed, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapInit(zzConcurrentSkipListMap *sl, size_t keySize, size_t valueSize, zzCompareFn compareFn, zzFreeFn keyFree, zzFreeFn valueFree);
+
+/**
+ * @brief Frees all memory associated with the concurrent skip list map.
+ *
+ * This function frees all entries, including those still waiting for reclamation,
+ * calling the free functions on their keys and values. No other thread may use
+ * the map during or after this call.
+ *
+ * @param[in,out] sl Pointer to the skip list map to free
+ */
+void zzConcurrentSkipListMapFree(zzConcurrentSkipListMap *sl);
+
+/**
+ * @brief Inserts or updates a key-value pair in the concurrent skip list map.
+ *
+ * This function links a new node with compare-and-swap, or atomically replaces the
+ * value of an existing key. A replaced value is reclaimed once no reader can still
+ * be copying it.
+ *
+ * @param[in,out] sl Pointer to the skip list map to insert/update in
+ * @param[in] key Pointer to the key to insert/update (contents will be copied)
+ * @param[in] value Pointer to the value to insert/update (contents will be copied)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapPut(zzConcurrentSkipListMap *sl, const void *key, const void *value);
+
+/**
+ * @brief Retrieves the value associated with the given key.
+ *
+ * This function searches the skip list without writing to shared memory other
+ * than its epoch counter.
+ *
+ * @param[in] sl Pointer to the skip list map to retrieve from
+ * @param[in] key Pointer to the key to look up
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the key is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapGet(zzConcurrentSkipListMap *sl, const void *key, void *valueOut);
+
+/**
+ * @brief Checks if the concurrent skip list map contains the specified key.
+ *
+ * @param[in] sl Pointer to the skip list map to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the map, false otherwise
+ */
+bool zzConcurrentSkipListMapContains(zzConcurrentSkipListMap *sl, const void *key);
+
+/**
+ * @brief Removes a key-value pair from the concurrent skip list map.
+ *
+ * This function marks the node as removed at every level, unlinks it and hands it
+ * to epoch-based reclamation. If several threads remove the same key at once,
+ * exactly one of them succeeds.
+ *
+ * @param[in,out] sl Pointer to the skip list map to remove from
+ * @param[in] key Pointer to the key to remove
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapRemove(zzConcurrentSkipListMap *sl, const void *key);
+
+/**
+ * @brief Returns the number of key-value pairs in the concurrent skip list map.
+ *
+ * While other threads are updating the map the result is only a snapshot.
+ *
+ * @param[in] sl Pointer to the skip list map
+ * @return Number of key-value pairs in the map
+ */
+size_t zzConcurrentSkipListMapSize(const zzConcurrentSkipListMap *sl);
+
+/**
+ * @brief Initializes an iterator positioned at the smallest key of the map.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] sl Pointer to the skip list map to iterate over
+ */
+void zzConcurrentSkipListMapIteratorInit(zzConcurrentSkipListMapIterator *it, zzConcurrentSkipListMap *sl);
+
+/**
+ * @brief Repositions the iterator at the first key greater than or equal to the given key.
+ *
+ * This function uses the index levels to find the position in O(log n) expected
+ * time, so a range scan starts with a seek and stops once a key passes the
+ * upper bound.
+ *
+ * @param[in,out] it Pointer to the iterator to reposition
+ * @param[in] key Pointer to the lower bound of the keys to iterate
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapIteratorSeek(zzConcurrentSkipListMapIterator *it, const void *key);
+
+/**
+ * @brief Advances the iterator to the next key-value pair.
+ *
+ * This function copies the current key and value to the output buffers and moves
+ * the iterator to the next key-value pair in sorted order. Returns false when the
+ * iterator reaches the end of the map.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] keyOut Pointer to a buffer where the current key will be copied
+ * @param[out] valueOut Pointer to a buffer where the current value will be copied
+ * @return true if a key-value pair was retrieved, false if the iterator reached the end
+ */
+bool zzConcurrentSkipListMapIteratorNext(zzConcurrentSkipListMapIterator *it, void *keyOut, void *valueOut);
+
+/**
+ * @brief Checks if the iterator has more elements.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more elements, false otherwise
+ */
+bool zzConcurrentSkipListMapIteratorHasNext(const zzConcurrentSkipListMapIterator *it);
+
+/**
+ * @brief Ends an iteration before it reached the end of the map.
+ *
+ * This function leaves the epoch held by the iterator so that removed entries can
+ * be reclaimed again. Calling it on a finished iterator has no effect.
+ *
+ * @param[in,out] it Pointer to the iterator to release
+ */
+void zzConcurrentSkipListMapIteratorRelease(zzConcurrentSkipListMapIterator *it);
+
+#endif
\ No newline at end of file
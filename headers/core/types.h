@@ -24,6 +24,38 @@
  */
 typedef enum { ZZ_RED, ZZ_BLACK } zzRBColor;
 
+/**
+ * @brief Enumeration of built-in element types with a known binary representation.
+ *
+ * This enumeration lets type-aware algorithms such as radix sort interpret raw
+ * element bytes as the corresponding C type instead of going through a
+ * comparison function. Each value matches the fixed-width type of the same name.
+ */
+typedef enum {
+    ZZ_ELEM_INT8,    /**< int8_t elements */
+    ZZ_ELEM_UINT8,   /**< uint8_t elements */
+    ZZ_ELEM_INT16,   /**< int16_t elements */
+    ZZ_ELEM_UINT16,  /**< uint16_t elements */
+    ZZ_ELEM_INT32,   /**< int32_t elements */
+    ZZ_ELEM_UINT32,  /**< uint32_t elements */
+    ZZ_ELEM_INT64,   /**< int64_t elements */
+    ZZ_ELEM_UINT64,  /**< uint64_t elements */
+    ZZ_ELEM_FLOAT,   /**< float elements (IEEE 754 binary32) */
+    ZZ_ELEM_DOUBLE   /**< double elements (IEEE 754 binary64) */
+} zzElemType;
+
+/**
+ * @brief Structure describing a contiguous run of elements inside a container's storage.
+ *
+ * Ring-based containers report their contents as up to two spans so that callers
+ * can read or write the elements in place, or hand them to vectored I/O such as
+ * writev(), without copying. A span stays valid until the container is modified.
+ */
+typedef struct zzSpan {
+    void *data;     /**< Pointer to the first element of the run, or NULL if the run is empty */
+    size_t count;   /**< Number of elements in the run */
+} zzSpan;
+
 /**
  * @brief Function pointer type for freeing memory.
  *
@@ -89,4 +121,70 @@ typedef bool (*zzEqualsFn)(const void* a, const void* b);
  */
 typedef void (*zzForEachFn)(void* element, void* userdata);
 
+/**
+ * @brief Function pointer type for testing an element against a condition.
+ *
+ * This function pointer type is used by bulk removal operations such as
+ * RemoveIf and RetainIf to select elements. It must not modify the container
+ * the element belongs to.
+ *
+ * @param element Pointer to the element being tested
+ * @param userdata Pointer to user-defined data that may be used in the test
+ * @return true if the element satisfies the condition, false otherwise
+ */
+typedef bool (*zzPredicateFn)(const void* element, void* userdata);
+
+/**
+ * @brief Function pointer type for testing a key-value entry against a condition.
+ *
+ * This function pointer type is the map counterpart of zzPredicateFn and
+ * receives both the key and the value of the entry being tested.
+ *
+ * @param key Pointer to the key of the entry being tested
+ * @param value Pointer to the value of the entry being tested
+ * @param userdata Pointer to user-defined data that may be used in the test
+ * @return true if the entry satisfies the condition, false otherwise
+ */
+typedef bool (*zzEntryPredicateFn)(const void* key, const void* value, void* userdata);
+
+/**
+ * @brief Function pointer type for initializing an aggregate from a single element.
+ *
+ * This function pointer type is used by augmented ordered collections to seed
+ * the aggregate of a single element (for example, copying a value into a running
+ * sum or minimum). The aggregate buffer holds the user-defined aggregate type.
+ *
+ * @param aggOut Pointer to the aggregate buffer to initialize
+ * @param elem Pointer to the element the aggregate is computed from
+ */
+typedef void (*zzAggregateInitFn)(void* aggOut, const void* elem);
+
+/**
+ * @brief Function pointer type for combining two aggregates.
+ *
+ * This function pointer type represents an associative operation (such as sum,
+ * min or max) that merges the aggregate of a left range with the aggregate of the
+ * right range that immediately follows it. The output buffer may alias either input.
+ *
+ * @param aggOut Pointer to the buffer receiving the combined aggregate
+ * @param left Pointer to the aggregate of the lower range
+ * @param right Pointer to the aggregate of the upper range
+ */
+typedef void (*zzAggregateCombineFn)(void* aggOut, const void* left, const void* right);
+
+
+/**
+ * @brief Function pointer type for extracting an order-preserving key prefix.
+ *
+ * This function pointer type is used by ordered collections that cache a
+ * normalized 64-bit prefix of every key to avoid calling the comparison function
+ * (and chasing the pointers it follows) on most comparisons. The prefix must
+ * preserve the key order: whenever a key compares below another, its prefix
+ * must not be greater. Keys with equal prefixes fall back to the full comparison.
+ *
+ * @param key Pointer to the key to extract the prefix from
+ * @return 64-bit prefix whose unsigned order agrees with the key order
+ */
+typedef uint64_t (*zzKeyPrefixFn)(const void* key);
+
 #endif
\ No newline at end of file
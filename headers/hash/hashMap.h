@@ -158,6 +158,37 @@ zzOpResult zzHashMapRemove(zzHashMap *hm, const void *key);
  */
 void zzHashMapClear(zzHashMap *hm);
 
+/**
+ * @brief Removes every entry for which the predicate returns true.
+ *
+ * This function tests each key-value pair once, in bucket order, and unlinks the
+ * matching nodes during the same pass, so it runs in O(n + capacity) time however
+ * many entries are removed. If custom free functions were provided, they are
+ * called on the key and value of every removed entry. The predicate must not
+ * modify the map.
+ *
+ * @param[in,out] hm Pointer to the HashMap to filter
+ * @param[in] pred Function selecting the entries to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzHashMapRemoveIf(zzHashMap *hm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the entries for which the predicate returns true.
+ *
+ * This function is the complement of zzHashMapRemoveIf and removes every entry
+ * that does not satisfy the predicate in the same single pass.
+ *
+ * @param[in,out] hm Pointer to the HashMap to filter
+ * @param[in] pred Function selecting the entries to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzHashMapRetainIf(zzHashMap *hm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Initializes an iterator for the HashMap.
  *
@@ -138,6 +138,36 @@ zzOpResult zzHashSetRemove(zzHashSet *s, const void *key);
  */
 void zzHashSetClear(zzHashSet *s);
 
+/**
+ * @brief Removes every key for which the predicate returns true.
+ *
+ * This function tests each key once, in bucket order, and unlinks the matching
+ * nodes during the same pass, so it runs in O(n + capacity) time however many
+ * keys are removed. If a custom free function was provided, it is called on
+ * every removed key. The predicate must not modify the set.
+ *
+ * @param[in,out] s Pointer to the HashSet to filter
+ * @param[in] pred Function selecting the keys to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzHashSetRemoveIf(zzHashSet *s, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the keys for which the predicate returns true.
+ *
+ * This function is the complement of zzHashSetRemoveIf and removes every key
+ * that does not satisfy the predicate in the same single pass.
+ *
+ * @param[in,out] s Pointer to the HashSet to filter
+ * @param[in] pred Function selecting the keys to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzHashSetRetainIf(zzHashSet *s, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Applies a function to each element in the HashSet.
  *
@@ -69,6 +69,43 @@ zzOpResult zzArrayDequeInit(zzArrayDeque *ad, size_t elSize, size_t capacity, zz
  */
 void zzArrayDequeFree(zzArrayDeque *ad);
 
+/**
+ * @brief Transfers ownership of the ArrayDeque's buffer to the caller.
+ *
+ * This function hands out the underlying buffer with the size elements stored
+ * contiguously from its start, in order from front to back. If the elements
+ * wrap around the end of the circular buffer they are first rotated into place,
+ * which temporarily allocates room for the shorter of the two wrapped runs; if
+ * that fails the deque is left unchanged. The caller becomes responsible for the
+ * elements and must release the buffer with free(); the free function of the
+ * deque is not called. The deque is left empty with no storage and can be
+ * reused: it allocates a new buffer on the next insertion.
+ *
+ * @param[in,out] ad Pointer to the ArrayDeque to detach the buffer from
+ * @param[out] bufferOut Pointer receiving the buffer, or NULL if the deque had no storage
+ * @param[out] sizeOut Pointer receiving the number of elements in the buffer
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayDequeDetach(zzArrayDeque *ad, void **bufferOut, size_t *sizeOut);
+
+/**
+ * @brief Makes the ArrayDeque take ownership of an existing buffer without copying it.
+ *
+ * This function replaces the contents of an initialized deque with the first size
+ * elements of a buffer allocated with malloc, calloc or realloc and room for
+ * capacity elements of the deque's element size. The first element of the buffer
+ * becomes the front. The current elements are released first as by
+ * zzArrayDequeFree. From then on the deque owns the buffer and frees it together
+ * with the deque.
+ *
+ * @param[in,out] ad Pointer to an initialized ArrayDeque
+ * @param[in] buffer Heap buffer to adopt, or NULL to leave the deque empty with no storage
+ * @param[in] size Number of elements stored at the start of the buffer
+ * @param[in] capacity Number of elements the buffer has room for (must be at least size)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayDequeAdopt(zzArrayDeque *ad, void *buffer, size_t size, size_t capacity);
+
 /**
  * @brief Adds an element to the front of the ArrayDeque.
  *
@@ -159,6 +196,35 @@ zzOpResult zzArrayDequePeekBack(const zzArrayDeque *ad, void *out);
  */
 zzOpResult zzArrayDequeGet(const zzArrayDeque *ad, size_t idx, void *out);
 
+/**
+ * @brief Returns a pointer to the element at the specified index.
+ *
+ * This function gives direct access to the element inside the circular buffer
+ * instead of copying it out. The index is relative to the logical order of
+ * elements (from front to back). The element may be modified through the pointer,
+ * which stays valid until the deque is next modified.
+ *
+ * @param[in] ad Pointer to the ArrayDeque
+ * @param[in] idx Index of the element (0-based, relative to front)
+ * @return Pointer to the element, or NULL if ad is NULL or idx is out of bounds
+ */
+void *zzArrayDequeAt(const zzArrayDeque *ad, size_t idx);
+
+/**
+ * @brief Describes the contents of the ArrayDeque as at most two contiguous spans.
+ *
+ * The elements occupy one run of the circular buffer, or two runs when they
+ * wrap around its end. Reading spans[0] and then spans[1] visits every element
+ * in logical order (from front to back) without copying, so the spans can be
+ * passed directly to vectored I/O such as writev(). Unused spans are set to
+ * { NULL, 0 }. The spans stay valid until the deque is next modified.
+ *
+ * @param[in] ad Pointer to the ArrayDeque
+ * @param[out] spans Array of two spans receiving the contents
+ * @return Number of non-empty spans written (0, 1 or 2)
+ */
+size_t zzArrayDequeSpans(const zzArrayDeque *ad, zzSpan spans[2]);
+
 /**
  * @brief Clears all elements from the ArrayDeque.
  *
@@ -170,6 +236,36 @@ zzOpResult zzArrayDequeGet(const zzArrayDeque *ad, size_t idx, void *out);
  */
 void zzArrayDequeClear(zzArrayDeque *ad);
 
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, from front to back, and compacts the
+ * survivors towards the front in a single stable pass, so it runs in O(n) time
+ * however many elements are removed. If a custom free function was provided, it
+ * is called on every removed element. The predicate must not modify the deque.
+ *
+ * @param[in,out] ad Pointer to the ArrayDeque to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayDequeRemoveIf(zzArrayDeque *ad, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzArrayDequeRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] ad Pointer to the ArrayDeque to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayDequeRetainIf(zzArrayDeque *ad, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Initializes an iterator for the ArrayDeque.
  *
@@ -21,15 +21,38 @@
  * This structure stores elements in a contiguous memory block that can grow
  * dynamically as elements are added. It tracks the current size, capacity,
  * element size, and provides a custom free function for element cleanup.
+ * A list initialized with zzArrayListInitInline keeps its first elements in
+ * inline storage that follows the structure and leaves buffer NULL until it
+ * outgrows that storage.
  */
 typedef struct zzArrayList {
-    void *buffer;      /**< Pointer to the underlying buffer storing elements */
+    void *buffer;      /**< Pointer to the heap buffer storing elements, or NULL while the inline storage is in use */
     size_t size;       /**< Current number of elements in the list */
     size_t capacity;   /**< Maximum number of elements the buffer can hold */
     size_t elSize;     /**< Size in bytes of each individual element */
+    size_t inlineCap;  /**< Number of elements the inline storage can hold, or 0 if the list has none */
     zzFreeFn elemFree; /**< Function to free individual elements, or NULL if not needed */
 } zzArrayList;
 
+/**
+ * @brief Declares a structure type made of an ArrayList followed by inline storage of the given size in bytes.
+ *
+ * The list member must be initialized with zzArrayListInitInline, passing the
+ * size of the storage member. Because the storage is located relative to the
+ * list rather than through a pointer, the whole structure may be copied with
+ * memcpy, for example as the value of a HashMap, as long as it is copied in
+ * full. Once the list has spilled to the heap, copies share the heap buffer
+ * exactly like copies of a plain zzArrayList.
+ *
+ * @code
+ * typedef ZZ_ARRAY_LIST_INLINE(8 * sizeof(int)) SmallIntList;
+ * SmallIntList small;
+ * zzArrayListInitInline(&small.list, sizeof small.storage, sizeof(int), NULL);
+ * @endcode
+ */
+#define ZZ_ARRAY_LIST_INLINE(bytes) \
+    struct { zzArrayList list; _Alignas(max_align_t) unsigned char storage[bytes]; }
+
 /**
  * @brief Structure representing an iterator for ArrayList.
  *
@@ -57,6 +80,23 @@ typedef struct zzArrayListIterator {
  */
 zzOpResult zzArrayListInit(zzArrayList *al, size_t elSize, size_t capacity, zzFreeFn elemFree);
 
+/**
+ * @brief Initializes an ArrayList that keeps its first elements in inline storage.
+ *
+ * This function initializes the list member of a ZZ_ARRAY_LIST_INLINE structure
+ * without allocating. Elements are stored in the inline storage until the list
+ * outgrows it; the elements are then moved to a heap buffer that grows as in
+ * zzArrayListInit. If the storage cannot hold a single element, the list is
+ * initialized as by zzArrayListInit with the default capacity.
+ *
+ * @param[out] al Pointer to the list member of a ZZ_ARRAY_LIST_INLINE structure
+ * @param[in] inlineBytes Size in bytes of the storage member of that structure
+ * @param[in] elSize Size in bytes of each element that will be stored in the list
+ * @param[in] elemFree Function to free individual elements when they are removed or the list is freed, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListInitInline(zzArrayList *al, size_t inlineBytes, size_t elSize, zzFreeFn elemFree);
+
 /**
  * @brief Frees all resources associated with the ArrayList.
  *
@@ -68,6 +108,40 @@ zzOpResult zzArrayListInit(zzArrayList *al, size_t elSize, size_t capacity, zzFr
  */
 void zzArrayListFree(zzArrayList *al);
 
+/**
+ * @brief Transfers ownership of the ArrayList's buffer to the caller.
+ *
+ * This function hands out the underlying buffer, holding size contiguous
+ * elements, without copying it. The caller becomes responsible for the elements
+ * and must release the buffer with free(); the free function of the list is not
+ * called. Elements held in inline storage are first copied to a new heap
+ * buffer. The list is left empty and can be reused: it returns to its inline
+ * storage, if any, or allocates a new buffer on the next insertion.
+ *
+ * @param[in,out] al Pointer to the ArrayList to detach the buffer from
+ * @param[out] bufferOut Pointer receiving the buffer, or NULL if the list held no heap storage and no elements
+ * @param[out] sizeOut Pointer receiving the number of elements in the buffer
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListDetach(zzArrayList *al, void **bufferOut, size_t *sizeOut);
+
+/**
+ * @brief Makes the ArrayList take ownership of an existing buffer without copying it.
+ *
+ * This function replaces the contents of an initialized list with the first size
+ * elements of a buffer allocated with malloc, calloc or realloc and room for
+ * capacity elements of the list's element size. The current elements are
+ * released first as by zzArrayListFree. From then on the list owns the buffer:
+ * it may reallocate it and frees it together with the list.
+ *
+ * @param[in,out] al Pointer to an initialized ArrayList
+ * @param[in] buffer Heap buffer to adopt, or NULL to leave the list empty on its inline storage, if any
+ * @param[in] size Number of elements stored at the start of the buffer
+ * @param[in] capacity Number of elements the buffer has room for (must be at least size)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListAdopt(zzArrayList *al, void *buffer, size_t size, size_t capacity);
+
 /**
  * @brief Adds an element to the end of the ArrayList.
  *
@@ -94,6 +168,33 @@ zzOpResult zzArrayListAdd(zzArrayList *al, const void *elem);
  */
 zzOpResult zzArrayListGet(const zzArrayList *al, size_t idx, void *out);
 
+/**
+ * @brief Returns a pointer to the contiguous storage of the ArrayList.
+ *
+ * The size elements of the list are laid out back to back starting at the
+ * returned address, so callers can read or modify them in place without the copy
+ * made by zzArrayListGet. The pointer is invalidated by any operation that adds
+ * elements (the buffer may be reallocated) and the data it points to is shifted
+ * by insertions and removals.
+ *
+ * @param[in] al Pointer to the ArrayList
+ * @return Pointer to the first element, or NULL if al is NULL
+ */
+void *zzArrayListData(const zzArrayList *al);
+
+/**
+ * @brief Returns a pointer to the element at the specified index.
+ *
+ * This function gives direct access to the element inside the list's buffer
+ * instead of copying it out. The element may be modified through the pointer.
+ * The same invalidation rules as for zzArrayListData apply.
+ *
+ * @param[in] al Pointer to the ArrayList
+ * @param[in] idx Index of the element (0-based)
+ * @return Pointer to the element, or NULL if al is NULL or idx is out of bounds
+ */
+void *zzArrayListAt(const zzArrayList *al, size_t idx);
+
 /**
  * @brief Sets the element at the specified index.
  *
@@ -133,6 +234,36 @@ zzOpResult zzArrayListRemove(zzArrayList *al, size_t idx);
  */
 void zzArrayListClear(zzArrayList *al);
 
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, in order, and compacts the survivors
+ * in a single stable pass, so it runs in O(n) time however many elements are
+ * removed. If a custom free function was provided, it is called on every
+ * removed element. The predicate must not modify the list.
+ *
+ * @param[in,out] al Pointer to the ArrayList to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListRemoveIf(zzArrayList *al, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzArrayListRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] al Pointer to the ArrayList to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListRetainIf(zzArrayList *al, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Inserts an element at the specified index.
  *
@@ -147,12 +278,76 @@ void zzArrayListClear(zzArrayList *al);
  */
 zzOpResult zzArrayListInsert(zzArrayList *al, size_t idx, const void *elem);
 
+/**
+ * @brief Appends an array of elements to the end of the ArrayList.
+ *
+ * This function grows the buffer at most once to fit all new elements and
+ * copies them in with a single memcpy. The source array must not point into
+ * the list's own buffer.
+ *
+ * @param[in,out] al Pointer to the ArrayList to add to
+ * @param[in] elems Pointer to the first of count contiguous elements (contents will be copied)
+ * @param[in] count Number of elements to append
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListAddAll(zzArrayList *al, const void *elems, size_t count);
+
+/**
+ * @brief Inserts an array of elements at the specified index.
+ *
+ * This function grows the buffer at most once, shifts the elements from idx
+ * onwards right by count positions with a single memmove and copies the new
+ * elements into the gap. The source array must not point into the list's own
+ * buffer.
+ *
+ * @param[in,out] al Pointer to the ArrayList to insert into
+ * @param[in] idx Index at which to insert the first element (0-based)
+ * @param[in] elems Pointer to the first of count contiguous elements (contents will be copied)
+ * @param[in] count Number of elements to insert
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListInsertRange(zzArrayList *al, size_t idx, const void *elems, size_t count);
+
+/**
+ * @brief Removes the elements in the index range [fromIdx, toIdx).
+ *
+ * This function calls the custom free function on each removed element (if
+ * provided) and closes the gap with a single memmove of the tail.
+ *
+ * @param[in,out] al Pointer to the ArrayList to remove from
+ * @param[in] fromIdx Index of the first element to remove (0-based)
+ * @param[in] toIdx Index one past the last element to remove
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListRemoveRange(zzArrayList *al, size_t fromIdx, size_t toIdx);
+
+/**
+ * @brief Replaces a range of elements with an array of elements.
+ *
+ * This function replaces the count elements starting at idx with newCount
+ * elements copied from elems, so the list grows or shrinks by the difference.
+ * The buffer is grown at most once and the tail is moved with a single memmove.
+ * The custom free function is called on each replaced element (if provided),
+ * and the list is left unchanged if growing fails. The source array must not
+ * point into the list's own buffer.
+ *
+ * @param[in,out] al Pointer to the ArrayList to modify
+ * @param[in] idx Index of the first element to replace (0-based)
+ * @param[in] count Number of elements to replace
+ * @param[in] elems Pointer to the first of newCount contiguous elements (contents will be copied)
+ * @param[in] newCount Number of elements to put in place of the replaced ones
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListReplaceRange(zzArrayList *al, size_t idx, size_t count, const void *elems, size_t newCount);
+
 /**
  * @brief Finds the index of the first occurrence of an element.
  *
  * This function searches for the first element in the list that matches the
  * specified element using the provided comparison function. The search proceeds
- * from index 0 to the end of the list.
+ * from index 0 to the end of the list. When cmp is zzCharCompare, zzIntCompare or
+ * zzLongCompare on elements of the matching size, the list is scanned with the
+ * vectorized typed kernels instead of calling cmp for every element.
  *
  * @param[in] al Pointer to the ArrayList to search in
  * @param[in] elem Pointer to the element to search for
@@ -162,6 +357,232 @@ zzOpResult zzArrayListInsert(zzArrayList *al, size_t idx, const void *elem);
  */
 zzOpResult zzArrayListIndexOf(const zzArrayList *al, const void *elem, zzCompareFn cmp, int *indexOut);
 
+/**
+ * @brief Finds the index of the first element equal to the key in an ArrayList of a built-in type.
+ *
+ * This function scans the list with vectorized typed comparisons instead of
+ * calling a comparison function. The element size of the list must match the
+ * size of type.
+ *
+ * @param[in] al Pointer to the ArrayList to search in
+ * @param[in] type Type of the elements stored in the list and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index of the first matching element
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListFindTyped(const zzArrayList *al, zzElemType type, const void *key, size_t *indexOut);
+
+/**
+ * @brief Counts the elements equal to the key in an ArrayList of a built-in type.
+ *
+ * @param[in] al Pointer to the ArrayList to search in
+ * @param[in] type Type of the elements stored in the list and of the key
+ * @param[in] key Pointer to the key to count
+ * @param[out] countOut Pointer receiving the number of matching elements
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListCountTyped(const zzArrayList *al, zzElemType type, const void *key, size_t *countOut);
+
+/**
+ * @brief Finds the smallest element of a non-empty ArrayList of a built-in type.
+ *
+ * Floating-point lists must not contain NaNs.
+ *
+ * @param[in] al Pointer to the ArrayList to search in
+ * @param[in] type Type of the elements stored in the list
+ * @param[out] minOut Pointer to a buffer where the smallest element will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListMinTyped(const zzArrayList *al, zzElemType type, void *minOut);
+
+/**
+ * @brief Finds the largest element of a non-empty ArrayList of a built-in type.
+ *
+ * Floating-point lists must not contain NaNs.
+ *
+ * @param[in] al Pointer to the ArrayList to search in
+ * @param[in] type Type of the elements stored in the list
+ * @param[out] maxOut Pointer to a buffer where the largest element will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListMaxTyped(const zzArrayList *al, zzElemType type, void *maxOut);
+
+/**
+ * @brief Finds an element equal to the key in a sorted ArrayList.
+ *
+ * This function runs a binary search in O(log n) time and reports the index of
+ * the first element equal to the key. The list must be sorted in the order
+ * defined by cmp.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Comparison function called as cmp(element, key)
+ * @param[out] indexOut Pointer receiving the index of the first matching element
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListBinarySearch(const zzArrayList *al, const void *key, zzCompareFn cmp, size_t *indexOut);
+
+/**
+ * @brief Finds the index of the first element not less than the key in a sorted ArrayList.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Comparison function called as cmp(element, key)
+ * @param[out] indexOut Pointer receiving the index found, or the list size if every element is less than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListLowerBound(const zzArrayList *al, const void *key, zzCompareFn cmp, size_t *indexOut);
+
+/**
+ * @brief Finds the index of the first element greater than the key in a sorted ArrayList.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Comparison function called as cmp(element, key)
+ * @param[out] indexOut Pointer receiving the index found, or the list size if no element is greater than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListUpperBound(const zzArrayList *al, const void *key, zzCompareFn cmp, size_t *indexOut);
+
+/**
+ * @brief Finds the index of the first element not less than the key in a sorted ArrayList of a built-in type.
+ *
+ * This function compares elements inline as the given type instead of calling a
+ * comparison function. The element size of the list must match the size of type.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] type Type of the elements stored in the list and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index found, or the list size if every element is less than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListLowerBoundTyped(const zzArrayList *al, zzElemType type, const void *key, size_t *indexOut);
+
+/**
+ * @brief Finds the index of the first element greater than the key in a sorted ArrayList of a built-in type.
+ *
+ * This function compares elements inline as the given type instead of calling a
+ * comparison function. The element size of the list must match the size of type.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] type Type of the elements stored in the list and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index found, or the list size if no element is greater than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListUpperBoundTyped(const zzArrayList *al, zzElemType type, const void *key, size_t *indexOut);
+
+/**
+ * @brief Inserts an element into a sorted ArrayList at the position that keeps it sorted.
+ *
+ * This function finds the position with a binary search and inserts the element
+ * with a single memmove of the tail, so it runs in O(log n) comparisons plus
+ * O(n) data movement. The element is placed after any elements equal to it,
+ * which keeps insertions of equal elements in arrival order.
+ *
+ * @param[in,out] al Pointer to the sorted ArrayList to insert into
+ * @param[in] elem Pointer to the element to insert (contents will be copied)
+ * @param[in] cmp Comparison function defining the order of elements
+ * @param[out] indexOut Pointer receiving the index the element was inserted at, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListSortedInsert(zzArrayList *al, const void *elem, zzCompareFn cmp, size_t *indexOut);
+
+/**
+ * @brief Sorts the elements of the ArrayList in ascending order.
+ *
+ * This function sorts the list in place with pattern-defeating quicksort in
+ * O(n log n) time. The sort is not stable; use zzArrayListStableSort when equal
+ * elements must keep their order.
+ *
+ * @param[in,out] al Pointer to the ArrayList to sort
+ * @param[in] cmp Comparison function defining the order of elements
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListSort(zzArrayList *al, zzCompareFn cmp);
+
+/**
+ * @brief Sorts the elements of the ArrayList in ascending order, keeping equal elements in order.
+ *
+ * This function sorts the list in place with a merge sort in O(n log n) time,
+ * using a temporary buffer of half the list size.
+ *
+ * @param[in,out] al Pointer to the ArrayList to sort
+ * @param[in] cmp Comparison function defining the order of elements
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListStableSort(zzArrayList *al, zzCompareFn cmp);
+
+/**
+ * @brief Sorts a list of built-in numeric elements in ascending order using radix sort.
+ *
+ * This function sorts the list in place by the binary representation of its
+ * elements without calling a comparison function, in O(n) time per byte of the
+ * element type. The element size of the list must match the size of type.
+ *
+ * @param[in,out] al Pointer to the ArrayList to sort
+ * @param[in] type Type of the elements stored in the list
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListRadixSort(zzArrayList *al, zzElemType type);
+
+/**
+ * @brief Sorts the elements of the ArrayList in ascending order using several threads.
+ *
+ * This function sorts the list in place with zzParallelSort, using up to threads
+ * threads (0 for one per online processor) and a temporary buffer the size of
+ * the list. Lists too small to benefit are sorted on the calling thread. The
+ * sort is not stable.
+ *
+ * @param[in,out] al Pointer to the ArrayList to sort
+ * @param[in] cmp Comparison function defining the order of elements (called concurrently)
+ * @param[in] threads Maximum number of threads to use, or 0 for one per online processor
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListParallelSort(zzArrayList *al, zzCompareFn cmp, size_t threads);
+
+/**
+ * @brief Rearranges the ArrayList so that the element at index nth is the one a full sort would put there.
+ *
+ * This function partially orders the list in place with introselect in O(n)
+ * expected time: no element before nth compares greater than it and no element
+ * after nth compares less than it.
+ *
+ * @param[in,out] al Pointer to the ArrayList to rearrange
+ * @param[in] cmp Comparison function defining the order of elements
+ * @param[in] nth Index of the element to put in its sorted position (0-based)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListNthElement(zzArrayList *al, zzCompareFn cmp, size_t nth);
+
+/**
+ * @brief Sorts the k smallest elements of the ArrayList into its first k positions.
+ *
+ * This function runs in O(n + k log k) expected time and leaves the remaining
+ * elements in unspecified order. A k of the list size or more sorts the whole list.
+ *
+ * @param[in,out] al Pointer to the ArrayList to partially sort
+ * @param[in] cmp Comparison function defining the order of elements
+ * @param[in] k Number of leading elements to sort
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListPartialSort(zzArrayList *al, zzCompareFn cmp, size_t k);
+
+/**
+ * @brief Copies the k smallest or largest elements of the ArrayList, best first.
+ *
+ * This function leaves the list unchanged and runs in O(n + k log k) expected
+ * time. If the list holds fewer than k elements, all of them are copied.
+ *
+ * @param[in] al Pointer to the ArrayList to select from
+ * @param[in] cmp Comparison function defining the order of elements
+ * @param[in] k Number of elements to return
+ * @param[in] largest Whether to return the largest elements instead of the smallest
+ * @param[out] out Pointer to a buffer with room for k elements receiving the result
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListTopK(const zzArrayList *al, zzCompareFn cmp, size_t k, bool largest, void *out);
+
 /**
  * @brief Initializes an iterator for the ArrayList.
  *
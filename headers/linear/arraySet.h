@@ -21,16 +21,28 @@
  *
  * Stores unique elements in a contiguous memory block.
  * Growth is handled automatically. Uniqueness is enforced via linear search.
+ * A set initialized with zzArraySetInitInline keeps its first elements in the
+ * inline storage that follows it and leaves buffer NULL until it outgrows it.
  */
 typedef struct zzArraySet {
-    void *buffer;          /**< Pointer to the underlying buffer */
+    void *buffer;          /**< Pointer to the heap buffer, or NULL while the inline storage is in use */
     size_t size;           /**< Current number of elements */
     size_t capacity;       /**< Maximum capacity before resize */
     size_t elSize;         /**< Size of each element in bytes */
+    size_t inlineCap;      /**< Capacity of the inline storage, or 0 if the set has none */
     zzEqualsFn equalsFn;   /**< Function to check element equality */
     zzFreeFn elemFree;     /**< Function to free elements */
 } zzArraySet;
 
+/**
+ * @brief Declares a structure type made of an ArraySet followed by inline storage of the given size in bytes.
+ *
+ * The set member must be initialized with zzArraySetInitInline. The storage is
+ * located relative to the set, so the whole structure may be copied with memcpy.
+ */
+#define ZZ_ARRAY_SET_INLINE(bytes) \
+    struct { zzArraySet set; _Alignas(max_align_t) unsigned char storage[bytes]; }
+
 /**
  * @brief Structure representing an iterator for ArraySet.
  *
@@ -57,6 +69,22 @@ typedef struct zzArraySetIterator {
  */
 zzOpResult zzArraySetInit(zzArraySet *as, size_t elSize, size_t capacity, zzEqualsFn equalsFn, zzFreeFn elemFree);
 
+/**
+ * @brief Initializes an ArraySet that keeps its first elements in inline storage.
+ *
+ * Initializes the set member of a ZZ_ARRAY_SET_INLINE structure without allocating.
+ * The elements move to a heap buffer once the inline storage is full. If the
+ * storage cannot hold a single element, the set is initialized as by zzArraySetInit.
+ *
+ * @param[out] as Pointer to the set member of a ZZ_ARRAY_SET_INLINE structure
+ * @param[in] inlineBytes Size in bytes of the storage member of that structure
+ * @param[in] elSize Size of each element in bytes
+ * @param[in] equalsFn Function to check element equality (optional, defaults to memcmp)
+ * @param[in] elemFree Function to free individual elements (optional)
+ * @return zzOpResult ZZ_SUCCESS on success, or error on failure
+ */
+zzOpResult zzArraySetInitInline(zzArraySet *as, size_t inlineBytes, size_t elSize, zzEqualsFn equalsFn, zzFreeFn elemFree);
+
 /**
  * @brief Frees the ArraySet and its elements.
  *
@@ -91,7 +119,8 @@ zzOpResult zzArraySetRemove(zzArraySet *as, const void *elem);
 /**
  * @brief Checks if the set contains an element.
  *
- * Performs a linear scan to find the element.
+ * Performs a linear scan to find the element, vectorized for sets of built-in
+ * types that use the matching equality function from utils.h.
  *
  * @param[in] as Pointer to the ArraySet
  * @param[in] elem Element to check
@@ -111,6 +140,30 @@ bool zzArraySetContains(const zzArraySet *as, const void *elem);
  */
 zzOpResult zzArraySetGet(const zzArraySet *as, size_t idx, void *out);
 
+/**
+ * @brief Returns a read-only pointer to the contiguous storage of the ArraySet.
+ *
+ * Provides the size elements back to back without copying. The elements must not
+ * be modified in place, since that could break uniqueness. The pointer is
+ * invalidated by Add, Remove and Clear.
+ *
+ * @param[in] as Pointer to the ArraySet
+ * @return Pointer to the first element, or NULL if as is NULL
+ */
+const void *zzArraySetData(const zzArraySet *as);
+
+/**
+ * @brief Returns a read-only pointer to the element at a specific index.
+ *
+ * Zero-copy counterpart of zzArraySetGet. The same invalidation rules as for
+ * zzArraySetData apply.
+ *
+ * @param[in] as Pointer to the ArraySet
+ * @param[in] idx Index of the element
+ * @return Pointer to the element, or NULL if as is NULL or idx is out of bounds
+ */
+const void *zzArraySetAt(const zzArraySet *as, size_t idx);
+
 /**
  * @brief Clears the set.
  *
@@ -120,6 +173,35 @@ zzOpResult zzArraySetGet(const zzArraySet *as, size_t idx, void *out);
  */
 void zzArraySetClear(zzArraySet *as);
 
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * Tests each element once and compacts the survivors in a single stable pass,
+ * so it runs in O(n) time however many elements are removed. Calls elemFree on
+ * every removed element if provided. The predicate must not modify the set.
+ *
+ * @param[in,out] as Pointer to the ArraySet to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArraySetRemoveIf(zzArraySet *as, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzArraySetRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] as Pointer to the ArraySet to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArraySetRetainIf(zzArraySet *as, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Initializes an iterator for the ArraySet.
  *
@@ -185,6 +185,36 @@ zzOpResult zzLinkedListRemove(zzLinkedList *ll, size_t idx);
  */
 void zzLinkedListClear(zzLinkedList *ll);
 
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, from head to tail, and unlinks the
+ * matching nodes during the same traversal, so it runs in O(n) time however many
+ * elements are removed. If a custom free function was provided, it is called on
+ * every removed element. The predicate must not modify the list.
+ *
+ * @param[in,out] ll Pointer to the LinkedList to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedListRemoveIf(zzLinkedList *ll, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzLinkedListRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) traversal.
+ *
+ * @param[in,out] ll Pointer to the LinkedList to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedListRetainIf(zzLinkedList *ll, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Initializes an iterator for the LinkedList.
  *
@@ -165,6 +165,37 @@ zzOpResult zzLinkedHashMapRemove(zzLinkedHashMap *lhm, const void *key);
  */
 void zzLinkedHashMapClear(zzLinkedHashMap *lhm);
 
+/**
+ * @brief Removes every entry for which the predicate returns true.
+ *
+ * This function tests each key-value pair once, in insertion order, and unlinks
+ * the matching nodes from both the hash table and the insertion order list during
+ * the same traversal, so it runs in O(n) expected time however many entries are
+ * removed. If custom free functions were provided, they are called on the key and
+ * value of every removed entry. The predicate must not modify the map.
+ *
+ * @param[in,out] lhm Pointer to the LinkedHashMap to filter
+ * @param[in] pred Function selecting the entries to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedHashMapRemoveIf(zzLinkedHashMap *lhm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the entries for which the predicate returns true.
+ *
+ * This function is the complement of zzLinkedHashMapRemoveIf and removes every entry
+ * that does not satisfy the predicate in the same single traversal.
+ *
+ * @param[in,out] lhm Pointer to the LinkedHashMap to filter
+ * @param[in] pred Function selecting the entries to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedHashMapRetainIf(zzLinkedHashMap *lhm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Gets the first key-value pair in insertion order from the LinkedHashMap.
  *
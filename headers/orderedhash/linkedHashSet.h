@@ -144,6 +144,37 @@ zzOpResult zzLinkedHashSetRemove(zzLinkedHashSet *lhs, const void *key);
  */
 void zzLinkedHashSetClear(zzLinkedHashSet *lhs);
 
+/**
+ * @brief Removes every key for which the predicate returns true.
+ *
+ * This function tests each key once, in insertion order, and unlinks the
+ * matching nodes from both the hash table and the insertion order list during
+ * the same traversal, so it runs in O(n) expected time however many keys are
+ * removed. If a custom free function was provided, it is called on every removed
+ * key. The predicate must not modify the set.
+ *
+ * @param[in,out] lhs Pointer to the LinkedHashSet to filter
+ * @param[in] pred Function selecting the keys to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedHashSetRemoveIf(zzLinkedHashSet *lhs, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the keys for which the predicate returns true.
+ *
+ * This function is the complement of zzLinkedHashSetRemoveIf and removes every key
+ * that does not satisfy the predicate in the same single traversal.
+ *
+ * @param[in,out] lhs Pointer to the LinkedHashSet to filter
+ * @param[in] pred Function selecting the keys to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedHashSetRetainIf(zzLinkedHashSet *lhs, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Gets the first key in insertion order from the LinkedHashSet.
  *
@@ -112,6 +112,35 @@ zzOpResult zzCircularBufferPop(zzCircularBuffer *cb, void *out);
  */
 zzOpResult zzCircularBufferGet(const zzCircularBuffer *cb, size_t idx, void *out);
 
+/**
+ * @brief Returns a pointer to the element at the specified index.
+ *
+ * This function gives direct access to the element inside the circular buffer
+ * instead of copying it out. The index is relative to the logical order of
+ * elements (from oldest to newest). The element may be modified through the pointer,
+ * which stays valid until the buffer is next modified.
+ *
+ * @param[in] cb Pointer to the CircularBuffer
+ * @param[in] idx Index of the element (0-based, 0 is the oldest)
+ * @return Pointer to the element, or NULL if cb is NULL or idx is out of bounds
+ */
+void *zzCircularBufferAt(const zzCircularBuffer *cb, size_t idx);
+
+/**
+ * @brief Describes the contents of the CircularBuffer as at most two contiguous spans.
+ *
+ * The elements occupy one run of the circular buffer, or two runs when they
+ * wrap around its end. Reading spans[0] and then spans[1] visits every element
+ * in logical order (from oldest to newest) without copying, so the spans can be
+ * passed directly to vectored I/O such as writev(). Unused spans are set to
+ * { NULL, 0 }. The spans stay valid until the buffer is next modified.
+ *
+ * @param[in] cb Pointer to the CircularBuffer
+ * @param[out] spans Array of two spans receiving the contents
+ * @return Number of non-empty spans written (0, 1 or 2)
+ */
+size_t zzCircularBufferSpans(const zzCircularBuffer *cb, zzSpan spans[2]);
+
 /**
  * @brief Peeks at the element at the front of the CircularBuffer without removing it.
  *
@@ -147,6 +176,37 @@ zzOpResult zzCircularBufferPeekBack(const zzCircularBuffer *cb, void *out);
  */
 void zzCircularBufferClear(zzCircularBuffer *cb);
 
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, from oldest to newest, and compacts
+ * the survivors towards the oldest position in a single stable pass, so it runs
+ * in O(n) time however many elements are removed. If a custom free function was
+ * provided, it is called on every removed element. The predicate must not modify
+ * the buffer.
+ *
+ * @param[in,out] cb Pointer to the CircularBuffer to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzCircularBufferRemoveIf(zzCircularBuffer *cb, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzCircularBufferRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] cb Pointer to the CircularBuffer to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzCircularBufferRetainIf(zzCircularBuffer *cb, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Initializes an iterator for the CircularBuffer.
  *
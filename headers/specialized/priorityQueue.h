@@ -85,6 +85,42 @@ void zzPriorityQueueFree(zzPriorityQueue *pq);
  */
 zzOpResult zzPriorityQueuePush(zzPriorityQueue *pq, const void *elem);
 
+/**
+ * @brief Transfers ownership of the PriorityQueue's buffer to the caller.
+ *
+ * This function hands out the underlying buffer without copying it. The size
+ * elements are stored contiguously in heap order, not in sorted order: the first
+ * element is the minimum. The caller becomes responsible for the elements and
+ * must release the buffer with free(); the free function of the queue is not
+ * called. The queue is left empty with no storage and can be reused: it
+ * allocates a new buffer on the next push.
+ *
+ * @param[in,out] pq Pointer to the PriorityQueue to detach the buffer from
+ * @param[out] bufferOut Pointer receiving the buffer, or NULL if the queue had no storage
+ * @param[out] sizeOut Pointer receiving the number of elements in the buffer
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPriorityQueueDetach(zzPriorityQueue *pq, void **bufferOut, size_t *sizeOut);
+
+/**
+ * @brief Makes the PriorityQueue take ownership of an existing buffer and heapifies it in place.
+ *
+ * This function replaces the contents of an initialized queue with the first size
+ * elements of a buffer allocated with malloc, calloc or realloc and room for
+ * capacity elements of the queue's element size. The elements may be in any
+ * order; they are arranged into a heap bottom-up in O(n) time, which is cheaper
+ * than pushing them one by one. The current elements are released first as by
+ * zzPriorityQueueFree. From then on the queue owns the buffer: it may reallocate
+ * it and frees it together with the queue.
+ *
+ * @param[in,out] pq Pointer to an initialized PriorityQueue
+ * @param[in] buffer Heap buffer to adopt, or NULL to leave the queue empty with no storage
+ * @param[in] size Number of elements stored at the start of the buffer
+ * @param[in] capacity Number of elements the buffer has room for (must be at least size)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPriorityQueueAdopt(zzPriorityQueue *pq, void *buffer, size_t size, size_t capacity);
+
 /**
  * @brief Pops the highest priority element from the PriorityQueue.
  *
@@ -123,6 +159,36 @@ zzOpResult zzPriorityQueuePeek(const zzPriorityQueue *pq, void *out);
  */
 void zzPriorityQueueClear(zzPriorityQueue *pq);
 
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, in heap order, compacts the survivors
+ * and then restores the heap property bottom-up, so it runs in O(n) time however
+ * many elements are removed. If a custom free function was provided, it is
+ * called on every removed element. The predicate must not modify the queue.
+ *
+ * @param[in,out] pq Pointer to the PriorityQueue to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPriorityQueueRemoveIf(zzPriorityQueue *pq, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzPriorityQueueRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] pq Pointer to the PriorityQueue to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPriorityQueueRetainIf(zzPriorityQueue *pq, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
 /**
  * @brief Initializes an iterator for the PriorityQueue.
  *
@@ -0,0 +1,132 @@
+/**
+ * @file frozenTreeSet.h
+ * @brief Read-only ordered set stored as a flat array in Eytzinger layout.
+ *
+ * This module turns a zzTreeSet into an immutable set whose keys are laid out in
+ * breadth-first (Eytzinger) order: the root in slot 1 and the children of slot k
+ * in slots 2k and 2k+1. A search is a loop of comparisons and index arithmetic
+ * without branches on the comparison result, and because the next four levels of
+ * a search sit in one contiguous block of slots they can be prefetched while the
+ * current level is compared. The set has no per-key pointer overhead, which makes
+ * it a good fit for lookup tables that are rebuilt periodically and read often.
+ */
+
+#ifndef FROZEN_TREE_SET_H
+#define FROZEN_TREE_SET_H
+
+#include "types.h"
+#include "utils.h"
+#include "result.h"
+#include "iterator.h"
+#include "treeSet.h"
+
+/**
+ * @brief Structure representing a frozen tree set.
+ *
+ * Keys are copied bytewise from the source set and are not owned by the frozen
+ * set, so keys that point to other memory must outlive it.
+ */
+typedef struct zzFrozenTreeSet {
+    unsigned char *keys;    /**< Key slots in Eytzinger order; slot 0 is unused */
+    size_t size;            /**< Number of keys in the set */
+    size_t keySize;         /**< Size in bytes of each key */
+    zzCompareFn compareFn;  /**< Function to compare keys for ordering */
+} zzFrozenTreeSet;
+
+/**
+ * @brief Structure representing an in-order iterator over a frozen tree set.
+ */
+typedef struct zzFrozenTreeSetIterator {
+    const zzFrozenTreeSet *set;     /**< Pointer to the frozen set being iterated */
+    size_t slot;                    /**< Slot of the key the next call returns, or 0 at the end */
+    zzIteratorState state;          /**< Current state of the iterator */
+} zzFrozenTreeSetIterator;
+
+/**
+ * @brief Creates a frozen copy of a TreeSet in Eytzinger layout.
+ *
+ * This function copies every key of the set into a single array in breadth-first
+ * order in O(n) time. The source set is not modified and can be changed or freed
+ * afterwards, as long as keys that point to other memory stay valid.
+ *
+ * @param[in] ts Pointer to the TreeSet to freeze
+ * @param[out] fs Pointer to the frozen set structure to initialize
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetFreeze(const zzTreeSet *ts, zzFrozenTreeSet *fs);
+
+/**
+ * @brief Frees the memory held by a frozen tree set.
+ *
+ * @param[in,out] fs Pointer to the frozen set to free
+ */
+void zzFrozenTreeSetFree(zzFrozenTreeSet *fs);
+
+/**
+ * @brief Checks if the frozen tree set contains the specified key.
+ *
+ * @param[in] fs Pointer to the frozen set to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the set, false otherwise
+ */
+bool zzFrozenTreeSetContains(const zzFrozenTreeSet *fs, const void *key);
+
+/**
+ * @brief Finds the smallest key greater than or equal to the given key.
+ *
+ * @param[in] fs Pointer to the frozen set to search
+ * @param[in] key Pointer to the key to search for
+ * @param[out] keyOut Pointer to a buffer where the key found will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzFrozenTreeSetCeiling(const zzFrozenTreeSet *fs, const void *key, void *keyOut);
+
+/**
+ * @brief Finds the largest key less than or equal to the given key.
+ *
+ * @param[in] fs Pointer to the frozen set to search
+ * @param[in] key Pointer to the key to search for
+ * @param[out] keyOut Pointer to a buffer where the key found will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzFrozenTreeSetFloor(const zzFrozenTreeSet *fs, const void *key, void *keyOut);
+
+/**
+ * @brief Initializes an iterator positioned at the smallest key of the frozen set.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] fs Pointer to the frozen set to iterate over
+ */
+void zzFrozenTreeSetIteratorInit(zzFrozenTreeSetIterator *it, const zzFrozenTreeSet *fs);
+
+/**
+ * @brief Repositions the iterator at the first key greater than or equal to the given key.
+ *
+ * @param[in,out] it Pointer to the iterator to reposition
+ * @param[in] key Pointer to the lower bound of the keys to iterate
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzFrozenTreeSetIteratorSeek(zzFrozenTreeSetIterator *it, const void *key);
+
+/**
+ * @brief Advances the iterator to the next key.
+ *
+ * This function copies the current key to the output buffer and moves the
+ * iterator to the next key in sorted order. Returns false when the iterator
+ * reaches the end of the set.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] keyOut Pointer to a buffer where the current key will be copied
+ * @return true if a key was retrieved, false if the iterator reached the end
+ */
+bool zzFrozenTreeSetIteratorNext(zzFrozenTreeSetIterator *it, void *keyOut);
+
+/**
+ * @brief Checks if the iterator has more elements.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more elements, false otherwise
+ */
+bool zzFrozenTreeSetIteratorHasNext(const zzFrozenTreeSetIterator *it);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,209 @@
+/**
+ * @file intervalTree.h
+ * @brief Red-black interval tree for overlap and stabbing queries over [start, end) ranges.
+ *
+ * This module implements an interval tree on top of the red-black tree algorithms
+ * used by zzTreeMap. Intervals are ordered by start and then end, and every node
+ * additionally stores the largest end point in its subtree. That augmentation is
+ * kept up to date through insertions, removals and rotations and lets queries skip
+ * every subtree that ends before the query begins, so reporting the k intervals
+ * that overlap a range or contain a point takes O(log n + k) time.
+ */
+
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include "types.h"
+#include "utils.h"
+#include "result.h"
+#include "iterator.h"
+
+/**
+ * @brief Structure representing a node in the interval tree.
+ *
+ * The data holds the start point, the end point, the largest end point of the
+ * subtree and the value. It starts at a max_align_t boundary so end points such as
+ * int64_t or double can be accessed in place by the comparison function.
+ */
+typedef struct IntervalTreeNode {
+    struct IntervalTreeNode *left;              /**< Pointer to the left child node */
+    struct IntervalTreeNode *right;             /**< Pointer to the right child node */
+    struct IntervalTreeNode *parent;            /**< Pointer to the parent node */
+    zzRBColor color;                            /**< Color of the node (RED or BLACK) for red-black tree balancing */
+    _Alignas(max_align_t) unsigned char data[]; /**< Flexible array member to store the interval, subtree maximum and value */
+} IntervalTreeNode;
+
+/**
+ * @brief Structure representing an interval tree.
+ *
+ * Each interval [start, end) is stored at most once; putting the same interval
+ * again replaces its value.
+ */
+typedef struct zzIntervalTree {
+    IntervalTreeNode *root;     /**< Pointer to the root node of the red-black tree */
+    size_t size;                /**< Current number of intervals in the tree */
+    size_t endpointSize;        /**< Size in bytes of each end point */
+    size_t valueSize;           /**< Size in bytes of each value */
+    zzCompareFn compareFn;      /**< Function to compare end points */
+    zzFreeFn valueFree;         /**< Function to free value memory, or NULL if not needed */
+} zzIntervalTree;
+
+/**
+ * @brief Structure representing an iterator over the intervals matching a query.
+ *
+ * The iterator visits the matching intervals in order of their start points,
+ * walking the tree through parent pointers and pruning subtrees by their largest
+ * end point. It refers to the query end points given at initialization, which must
+ * stay valid while the iterator is in use.
+ */
+typedef struct zzIntervalTreeIterator {
+    zzIntervalTree *tree;           /**< Pointer to the interval tree being queried */
+    IntervalTreeNode *current;      /**< Next matching node, or NULL when the query is exhausted */
+    const void *lo;                 /**< Lower end of the query */
+    const void *hi;                 /**< Upper end of the query */
+    bool closed;                    /**< Whether intervals starting at hi match (stabbing query) */
+    zzIteratorState state;          /**< Current state of the iterator */
+} zzIntervalTreeIterator;
+
+/**
+ * @brief Initializes a new interval tree with the specified end point and value sizes.
+ *
+ * This function initializes an empty interval tree. End points are copied by
+ * value and ordered by compareFn.
+ *
+ * @param[out] t Pointer to the interval tree structure to initialize
+ * @param[in] endpointSize Size in bytes of each start and end point
+ * @param[in] valueSize Size in bytes of each value that will be stored in the tree
+ * @param[in] compareFn Function to compare end points (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] valueFree Function to free value memory when intervals are removed or the tree is freed, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeInit(zzIntervalTree *t, size_t endpointSize, size_t valueSize, zzCompareFn compareFn, zzFreeFn valueFree);
+
+/**
+ * @brief Frees all resources associated with the interval tree.
+ *
+ * @param[in,out] t Pointer to the interval tree to free
+ */
+void zzIntervalTreeFree(zzIntervalTree *t);
+
+/**
+ * @brief Removes all intervals from the interval tree.
+ *
+ * @param[in,out] t Pointer to the interval tree to clear
+ */
+void zzIntervalTreeClear(zzIntervalTree *t);
+
+/**
+ * @brief Inserts an interval or updates its value.
+ *
+ * This function stores the half-open interval [start, end) with the given value,
+ * or replaces the value if the interval is already present. The interval must not
+ * be empty, so start has to compare less than end.
+ *
+ * @param[in,out] t Pointer to the interval tree to insert/update in
+ * @param[in] start Pointer to the first point of the interval (contents will be copied)
+ * @param[in] end Pointer to the first point past the interval (contents will be copied)
+ * @param[in] value Pointer to the value to insert/update (contents will be copied)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreePut(zzIntervalTree *t, const void *start, const void *end, const void *value);
+
+/**
+ * @brief Retrieves the value stored for exactly the interval [start, end).
+ *
+ * @param[in] t Pointer to the interval tree to retrieve from
+ * @param[in] start Pointer to the first point of the interval
+ * @param[in] end Pointer to the first point past the interval
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the interval is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeGet(const zzIntervalTree *t, const void *start, const void *end, void *valueOut);
+
+/**
+ * @brief Checks if the interval tree contains exactly the interval [start, end).
+ *
+ * @param[in] t Pointer to the interval tree to check
+ * @param[in] start Pointer to the first point of the interval
+ * @param[in] end Pointer to the first point past the interval
+ * @return true if the interval is stored in the tree, false otherwise
+ */
+bool zzIntervalTreeContains(const zzIntervalTree *t, const void *start, const void *end);
+
+/**
+ * @brief Removes the interval [start, end) from the interval tree.
+ *
+ * @param[in,out] t Pointer to the interval tree to remove from
+ * @param[in] start Pointer to the first point of the interval
+ * @param[in] end Pointer to the first point past the interval
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeRemove(zzIntervalTree *t, const void *start, const void *end);
+
+/**
+ * @brief Finds the interval with the smallest start point that overlaps [lo, hi).
+ *
+ * An interval [start, end) overlaps the query when start < hi and lo < end. This
+ * is the O(log n) existence check behind the overlap iterator.
+ *
+ * @param[in] t Pointer to the interval tree to search
+ * @param[in] lo Pointer to the first point of the query range
+ * @param[in] hi Pointer to the first point past the query range
+ * @param[out] startOut Pointer to a buffer receiving the start point of the interval found
+ * @param[out] endOut Pointer to a buffer receiving the end point of the interval found
+ * @param[out] valueOut Pointer to a buffer receiving the value of the interval found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeFindOverlap(const zzIntervalTree *t, const void *lo, const void *hi, void *startOut, void *endOut, void *valueOut);
+
+/**
+ * @brief Initializes an iterator over all intervals overlapping [lo, hi).
+ *
+ * The iterator yields every interval [start, end) with start < hi and lo < end in
+ * order of start points, in O(log n + k) time for k results. An empty query range
+ * (lo not less than hi) yields nothing.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] t Pointer to the interval tree to query
+ * @param[in] lo Pointer to the first point of the query range (must stay valid while iterating)
+ * @param[in] hi Pointer to the first point past the query range (must stay valid while iterating)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeIteratorInitOverlap(zzIntervalTreeIterator *it, zzIntervalTree *t, const void *lo, const void *hi);
+
+/**
+ * @brief Initializes an iterator over all intervals containing a point.
+ *
+ * The iterator yields every interval [start, end) with start <= point < end in
+ * order of start points, in O(log n + k) time for k results.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] t Pointer to the interval tree to query
+ * @param[in] point Pointer to the point to stab with (must stay valid while iterating)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeIteratorInitStab(zzIntervalTreeIterator *it, zzIntervalTree *t, const void *point);
+
+/**
+ * @brief Advances the iterator to the next matching interval.
+ *
+ * This function copies the interval and its value to the output buffers and moves
+ * on to the next matching interval. Returns false when no intervals are left.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] startOut Pointer to a buffer where the start point will be copied
+ * @param[out] endOut Pointer to a buffer where the end point will be copied
+ * @param[out] valueOut Pointer to a buffer where the value will be copied
+ * @return true if an interval was retrieved, false if the iterator reached the end
+ */
+bool zzIntervalTreeIteratorNext(zzIntervalTreeIterator *it, void *startOut, void *endOut, void *valueOut);
+
+/**
+ * @brief Checks if the iterator has more matching intervals.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more intervals, false otherwise
+ */
+bool zzIntervalTreeIteratorHasNext(const zzIntervalTreeIterator *it);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,249 @@
+/**
+ * @file persistentTreeMap.h
+ * @brief Persistent red-black tree map with immutable snapshots for concurrent readers.
+ *
+ * This module implements a left-leaning red-black tree whose updates copy only the
+ * O(log n) nodes along the modified path instead of changing shared nodes in place.
+ * Nodes are reference counted and shared between versions, so a reader can take an
+ * immutable snapshot of the map in O(1) and scan it at its own pace, from any thread,
+ * while a single writer keeps updating the map. Nodes that no snapshot can see are
+ * still updated in place, so a map without live snapshots costs about as much as an
+ * ordinary tree. Keys and values are copied by value into the nodes and shared between
+ * versions, so the map takes no free functions.
+ */
+
+#ifndef PERSISTENT_TREE_MAP_H
+#define PERSISTENT_TREE_MAP_H
+
+#include <stdatomic.h>
+#include "types.h"
+#include "utils.h"
+#include "result.h"
+#include "iterator.h"
+
+/**
+ * @brief Upper bound on the height of a persistent tree, used to size iterator stacks.
+ *
+ * A left-leaning red-black tree with n nodes is at most 2*log2(n+1) levels deep,
+ * which stays below this bound for any size_t-sized tree.
+ */
+#define ZZ_PERSISTENT_TREE_MAX_HEIGHT 128
+
+/**
+ * @brief Structure representing a node in the persistent tree map.
+ *
+ * Each node can be shared by several versions of the tree. The reference count
+ * tracks how many parents, map roots and snapshots point at the node; the node
+ * is freed when the last of them lets go.
+ */
+typedef struct PersistentTreeMapNode {
+    struct PersistentTreeMapNode *left;     /**< Pointer to the left child node */
+    struct PersistentTreeMapNode *right;    /**< Pointer to the right child node */
+    atomic_size_t refCount;                 /**< Number of references held on this node */
+    zzRBColor color;                        /**< Color of the link from the parent (RED or BLACK) */
+    unsigned char data[];                   /**< Flexible array member to store key and value data */
+} PersistentTreeMapNode;
+
+/**
+ * @brief Structure representing a persistent red-black tree map.
+ *
+ * The map holds the current version of the tree. All functions taking a
+ * zzPersistentTreeMap must be called by a single writer thread, except
+ * zzPersistentTreeMapAcquireSnapshot which any thread may call.
+ */
+typedef struct zzPersistentTreeMap {
+    PersistentTreeMapNode *root;        /**< Pointer to the root node of the current version */
+    size_t size;                        /**< Current number of key-value pairs in the map */
+    size_t keySize;                     /**< Size in bytes of each key */
+    size_t valueSize;                   /**< Size in bytes of each value */
+    zzCompareFn compareFn;              /**< Function to compare keys for ordering */
+    PersistentTreeMapNode *spares;      /**< Preallocated nodes so an update never fails halfway through its path copies */
+    size_t spareCount;                  /**< Number of nodes in the spares list */
+    atomic_flag lock;                   /**< Held while an update runs or a snapshot is taken */
+} zzPersistentTreeMap;
+
+/**
+ * @brief Structure representing an immutable snapshot of a persistent tree map.
+ *
+ * A snapshot keeps the version of the tree it was taken from alive until it is
+ * released. It may be read from any thread, concurrently with the writer and with
+ * other snapshots, without any locking.
+ */
+typedef struct zzPersistentTreeMapSnapshot {
+    PersistentTreeMapNode *root;    /**< Pointer to the root node of the captured version */
+    size_t size;                    /**< Number of key-value pairs in the captured version */
+    size_t keySize;                 /**< Size in bytes of each key */
+    size_t valueSize;               /**< Size in bytes of each value */
+    zzCompareFn compareFn;          /**< Function to compare keys for ordering */
+} zzPersistentTreeMapSnapshot;
+
+/**
+ * @brief Structure representing an iterator over a persistent tree map snapshot.
+ *
+ * This structure provides in-order iteration through a snapshot. Persistent nodes
+ * have no parent pointers, so the iterator keeps the pending ancestors on a stack.
+ */
+typedef struct zzPersistentTreeMapIterator {
+    const zzPersistentTreeMapSnapshot *snapshot;                            /**< Pointer to the snapshot being iterated */
+    const PersistentTreeMapNode *stack[ZZ_PERSISTENT_TREE_MAX_HEIGHT];      /**< Ancestors whose key has not been returned yet */
+    size_t depth;                                                           /**< Number of nodes on the stack */
+    zzIteratorState state;                                                  /**< Current state of the iterator */
+} zzPersistentTreeMapIterator;
+
+/**
+ * @brief Initializes a new persistent TreeMap with the specified key and value sizes.
+ *
+ * This function initializes a persistent TreeMap structure with the given key and
+ * value sizes and comparison function. The map will be empty after initialization.
+ *
+ * @param[out] pm Pointer to the persistent TreeMap structure to initialize
+ * @param[in] keySize Size in bytes of each key that will be stored in the map
+ * @param[in] valueSize Size in bytes of each value that will be stored in the map
+ * @param[in] compareFn Function to compare keys for ordering (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapInit(zzPersistentTreeMap *pm, size_t keySize, size_t valueSize, zzCompareFn compareFn);
+
+/**
+ * @brief Frees the persistent TreeMap.
+ *
+ * This function releases the map's reference on its current version and frees the
+ * nodes no snapshot still uses. Snapshots taken earlier remain valid until they are
+ * released.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to free
+ */
+void zzPersistentTreeMapFree(zzPersistentTreeMap *pm);
+
+/**
+ * @brief Inserts or updates a key-value pair in the persistent TreeMap.
+ *
+ * This function inserts a new key-value pair or replaces the value of an existing
+ * key. Nodes on the modified path that are shared with a snapshot are copied, so
+ * snapshots keep seeing the old contents.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to insert/update in
+ * @param[in] key Pointer to the key to insert/update (contents will be copied)
+ * @param[in] value Pointer to the value to insert/update (contents will be copied)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapPut(zzPersistentTreeMap *pm, const void *key, const void *value);
+
+/**
+ * @brief Retrieves the value associated with the given key from the current version.
+ *
+ * @param[in] pm Pointer to the persistent TreeMap to retrieve from
+ * @param[in] key Pointer to the key to look up
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the key is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapGet(const zzPersistentTreeMap *pm, const void *key, void *valueOut);
+
+/**
+ * @brief Checks if the current version of the persistent TreeMap contains the specified key.
+ *
+ * @param[in] pm Pointer to the persistent TreeMap to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the map, false otherwise
+ */
+bool zzPersistentTreeMapContains(const zzPersistentTreeMap *pm, const void *key);
+
+/**
+ * @brief Removes a key-value pair from the persistent TreeMap.
+ *
+ * This function removes the entry with the specified key. Nodes on the modified
+ * path that are shared with a snapshot are copied, so snapshots keep seeing the
+ * removed entry.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to remove from
+ * @param[in] key Pointer to the key to remove
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapRemove(zzPersistentTreeMap *pm, const void *key);
+
+/**
+ * @brief Removes all key-value pairs from the persistent TreeMap.
+ *
+ * This function empties the current version. Snapshots keep their contents.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to clear
+ */
+void zzPersistentTreeMapClear(zzPersistentTreeMap *pm);
+
+/**
+ * @brief Takes an immutable snapshot of the current version of the persistent TreeMap.
+ *
+ * This function shares the current root with the snapshot in O(1). It may be called
+ * from any thread; it waits at most for the update in progress to finish. The
+ * snapshot must be released with zzPersistentTreeMapReleaseSnapshot.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to take a snapshot of
+ * @param[out] snap Pointer to the snapshot structure to fill
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapAcquireSnapshot(zzPersistentTreeMap *pm, zzPersistentTreeMapSnapshot *snap);
+
+/**
+ * @brief Releases a snapshot of a persistent TreeMap.
+ *
+ * This function drops the snapshot's reference on its version and frees the nodes
+ * that are no longer used by the map or by other snapshots. The snapshot is empty
+ * afterwards. It may be called from any thread, even after the map was freed.
+ *
+ * @param[in,out] snap Pointer to the snapshot to release
+ */
+void zzPersistentTreeMapReleaseSnapshot(zzPersistentTreeMapSnapshot *snap);
+
+/**
+ * @brief Retrieves the value associated with the given key from a snapshot.
+ *
+ * @param[in] snap Pointer to the snapshot to retrieve from
+ * @param[in] key Pointer to the key to look up
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the key is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapSnapshotGet(const zzPersistentTreeMapSnapshot *snap, const void *key, void *valueOut);
+
+/**
+ * @brief Checks if a snapshot contains the specified key.
+ *
+ * @param[in] snap Pointer to the snapshot to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the snapshot, false otherwise
+ */
+bool zzPersistentTreeMapSnapshotContains(const zzPersistentTreeMapSnapshot *snap, const void *key);
+
+/**
+ * @brief Initializes an iterator over a persistent TreeMap snapshot.
+ *
+ * This function positions the iterator at the smallest key of the snapshot.
+ * The snapshot must stay acquired while the iterator is used.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] snap Pointer to the snapshot to iterate over
+ */
+void zzPersistentTreeMapIteratorInit(zzPersistentTreeMapIterator *it, const zzPersistentTreeMapSnapshot *snap);
+
+/**
+ * @brief Advances the iterator to the next key-value pair.
+ *
+ * This function copies the current key and value to the output buffers and moves
+ * the iterator to the next key-value pair in sorted order. Returns false when the
+ * iterator reaches the end of the snapshot.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] keyOut Pointer to a buffer where the current key will be copied
+ * @param[out] valueOut Pointer to a buffer where the current value will be copied
+ * @return true if a key-value pair was retrieved, false if the iterator reached the end
+ */
+bool zzPersistentTreeMapIteratorNext(zzPersistentTreeMapIterator *it, void *keyOut, void *valueOut);
+
+/**
+ * @brief Checks if the iterator has more elements.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more elements, false otherwise
+ */
+bool zzPersistentTreeMapIteratorHasNext(const zzPersistentTreeMapIterator *it);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,280 @@
+/**
+ * @file radixTreeMap.h
+ * @brief Adaptive radix tree map for ordered storage of integer and string keys.
+ *
+ * This module implements an adaptive radix tree (ART): keys are turned into
+ * binary-comparable byte strings and the tree branches on one byte per level, so
+ * lookups never call a comparison function and the depth depends on the key
+ * length instead of the number of entries. Inner nodes grow and shrink between
+ * four layouts (4, 16, 48 and 256 children) to stay compact, and chains of
+ * single-child nodes are collapsed into a stored prefix (path compression). The
+ * leaves are also kept on a sorted doubly linked list, so in-order, range and
+ * prefix iteration advance in O(1) per entry.
+ */
+
+#ifndef RADIX_TREE_MAP_H
+#define RADIX_TREE_MAP_H
+
+#include "types.h"
+#include "utils.h"
+#include "result.h"
+#include "iterator.h"
+
+/**
+ * @brief Number of compressed path bytes stored in each inner node.
+ *
+ * Longer prefixes keep only their length and first bytes in the node; the
+ * remaining bytes are checked against a leaf when needed.
+ */
+#define ZZ_RADIX_MAX_PREFIX 8
+
+/**
+ * @brief Enumeration of the key kinds a radix tree map can index.
+ *
+ * The kind decides how a key is turned into the byte string the tree branches
+ * on. Integer keys are stored big-endian (with the sign bit flipped for signed
+ * keys) so that byte order matches numeric order; string keys are ordered like
+ * strcmp.
+ */
+typedef enum {
+    ZZ_RADIX_KEY_UNSIGNED,  /**< Unsigned integers of 1, 2, 4 or 8 bytes */
+    ZZ_RADIX_KEY_SIGNED,    /**< Signed integers of 1, 2, 4 or 8 bytes */
+    ZZ_RADIX_KEY_STRING     /**< Null-terminated strings stored as char* keys */
+} zzRadixKeyType;
+
+/**
+ * @brief Structure representing a leaf holding one key-value pair.
+ *
+ * Leaves are linked in key order so iterators can step between them directly.
+ */
+typedef struct RadixTreeLeaf {
+    struct RadixTreeLeaf *prev;     /**< Pointer to the leaf with the next smaller key */
+    struct RadixTreeLeaf *next;     /**< Pointer to the leaf with the next larger key */
+    unsigned char data[];           /**< Flexible array member to store key and value data */
+} RadixTreeLeaf;
+
+/**
+ * @brief Enumeration of the inner node layouts, stored in the type field of RadixTreeNode.
+ *
+ * A node grows into the next layout when it runs out of child slots and shrinks
+ * back once it has clearly fewer children than the smaller layout holds.
+ */
+typedef enum {
+    ZZ_RADIX_NODE4 = 1,     /**< Up to 4 children in sorted key and child arrays */
+    ZZ_RADIX_NODE16,        /**< Up to 16 children in sorted arrays searched with SSE2 */
+    ZZ_RADIX_NODE48,        /**< Up to 48 children reached through a 256-entry index */
+    ZZ_RADIX_NODE256        /**< One child slot for every possible key byte */
+} zzRadixNodeType;
+
+/**
+ * @brief Header shared by the four inner node layouts.
+ *
+ * Child pointers with their lowest bit set refer to leaves.
+ */
+typedef struct RadixTreeNode {
+    uint8_t type;                               /**< Layout of the node, one of zzRadixNodeType */
+    uint16_t numChildren;                       /**< Number of children currently present */
+    uint32_t prefixLen;                         /**< Length of the compressed path above the node's children */
+    unsigned char prefix[ZZ_RADIX_MAX_PREFIX];  /**< First bytes of the compressed path */
+} RadixTreeNode;
+
+/**
+ * @brief Structure representing an adaptive radix tree map.
+ *
+ * This structure maintains the root of the tree, the sorted leaf list, the
+ * current size, and the key kind and memory management functions.
+ */
+typedef struct zzRadixTreeMap {
+    RadixTreeNode *root;        /**< Pointer to the root node or leaf, or NULL if the map is empty */
+    RadixTreeLeaf *first;       /**< Pointer to the leaf with the smallest key */
+    RadixTreeLeaf *last;        /**< Pointer to the leaf with the largest key */
+    size_t size;                /**< Current number of key-value pairs in the map */
+    size_t keySize;             /**< Size in bytes of each key */
+    size_t valueSize;           /**< Size in bytes of each value */
+    zzRadixKeyType keyType;     /**< How keys are turned into bytes */
+    zzFreeFn keyFree;           /**< Function to free key memory, or NULL if not needed */
+    zzFreeFn valueFree;         /**< Function to free value memory, or NULL if not needed */
+} zzRadixTreeMap;
+
+/**
+ * @brief Structure representing an iterator for a radix tree map.
+ *
+ * This structure provides in-order iteration over the whole map, a key range or
+ * the keys sharing a prefix by walking the sorted leaf list.
+ */
+typedef struct zzRadixTreeMapIterator {
+    zzRadixTreeMap *map;            /**< Pointer to the map being iterated */
+    RadixTreeLeaf *current;         /**< Leaf returned by the next call */
+    RadixTreeLeaf *end;             /**< First leaf past the iterated range, or NULL for the end of the map */
+    RadixTreeLeaf *lastReturned;    /**< Pointer to the last returned leaf */
+    zzIteratorState state;          /**< Current state of the iterator */
+} zzRadixTreeMapIterator;
+
+/**
+ * @brief Initializes a new radix tree map for the given key kind.
+ *
+ * This function initializes an empty radix tree map. Integer keys must be 1, 2,
+ * 4 or 8 bytes wide; string keys are char* values, so keySize must be sizeof(char*).
+ *
+ * @param[out] rm Pointer to the radix tree map structure to initialize
+ * @param[in] keyType Kind of the keys that will be stored in the map
+ * @param[in] keySize Size in bytes of each key that will be stored in the map
+ * @param[in] valueSize Size in bytes of each value that will be stored in the map
+ * @param[in] keyFree Function to free key memory when entries are removed or the map is freed, or NULL if not needed
+ * @param[in] valueFree Function to free value memory when entries are removed or the map is freed, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapInit(zzRadixTreeMap *rm, zzRadixKeyType keyType, size_t keySize, size_t valueSize, zzFreeFn keyFree, zzFreeFn valueFree);
+
+/**
+ * @brief Frees all memory associated with the radix tree map.
+ *
+ * This function frees all nodes and leaves, calling the free functions on every
+ * key and value.
+ *
+ * @param[in,out] rm Pointer to the radix tree map to free
+ */
+void zzRadixTreeMapFree(zzRadixTreeMap *rm);
+
+/**
+ * @brief Removes all key-value pairs from the radix tree map.
+ *
+ * @param[in,out] rm Pointer to the radix tree map to clear
+ */
+void zzRadixTreeMapClear(zzRadixTreeMap *rm);
+
+/**
+ * @brief Inserts or updates a key-value pair in the radix tree map.
+ *
+ * This function inserts a new key-value pair or replaces the value of an existing
+ * key, growing or splitting at most one inner node.
+ *
+ * @param[in,out] rm Pointer to the radix tree map to insert/update in
+ * @param[in] key Pointer to the key to insert/update (contents will be copied)
+ * @param[in] value Pointer to the value to insert/update (contents will be copied)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapPut(zzRadixTreeMap *rm, const void *key, const void *value);
+
+/**
+ * @brief Retrieves the value associated with the given key from the radix tree map.
+ *
+ * @param[in] rm Pointer to the radix tree map to retrieve from
+ * @param[in] key Pointer to the key to look up
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the key is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapGet(const zzRadixTreeMap *rm, const void *key, void *valueOut);
+
+/**
+ * @brief Checks if the radix tree map contains the specified key.
+ *
+ * @param[in] rm Pointer to the radix tree map to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the map, false otherwise
+ */
+bool zzRadixTreeMapContains(const zzRadixTreeMap *rm, const void *key);
+
+/**
+ * @brief Removes a key-value pair from the radix tree map.
+ *
+ * This function removes the entry with the specified key, shrinking the inner
+ * node it hung from and merging single-child nodes into their child's prefix.
+ *
+ * @param[in,out] rm Pointer to the radix tree map to remove from
+ * @param[in] key Pointer to the key to remove
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapRemove(zzRadixTreeMap *rm, const void *key);
+
+/**
+ * @brief Retrieves the entry with the smallest key in the radix tree map.
+ *
+ * @param[in] rm Pointer to the radix tree map
+ * @param[out] keyOut Pointer to a buffer where the smallest key will be copied
+ * @param[out] valueOut Pointer to a buffer where its value will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapGetMin(const zzRadixTreeMap *rm, void *keyOut, void *valueOut);
+
+/**
+ * @brief Retrieves the entry with the largest key in the radix tree map.
+ *
+ * @param[in] rm Pointer to the radix tree map
+ * @param[out] keyOut Pointer to a buffer where the largest key will be copied
+ * @param[out] valueOut Pointer to a buffer where its value will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapGetMax(const zzRadixTreeMap *rm, void *keyOut, void *valueOut);
+
+/**
+ * @brief Initializes an iterator over all entries of the radix tree map in key order.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] rm Pointer to the radix tree map to iterate over
+ */
+void zzRadixTreeMapIteratorInit(zzRadixTreeMapIterator *it, zzRadixTreeMap *rm);
+
+/**
+ * @brief Initializes an iterator over the entries whose keys lie in [lo, hi].
+ *
+ * This function locates both bounds with one descent each and then walks the
+ * leaf list between them.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] rm Pointer to the radix tree map to iterate over
+ * @param[in] lo Pointer to the smallest key of the range
+ * @param[in] hi Pointer to the largest key of the range
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapIteratorInitRange(zzRadixTreeMapIterator *it, zzRadixTreeMap *rm, const void *lo, const void *hi);
+
+/**
+ * @brief Initializes an iterator over the entries whose key bytes start with a prefix.
+ *
+ * For string keys the prefix is the leading characters of the strings (without a
+ * terminator); for integer keys it is the leading bytes of the big-endian key, so
+ * the first two bytes of a 4-byte IPv4 address select a /16 network. The matching
+ * entries form one subtree, which is found with a single descent.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] rm Pointer to the radix tree map to iterate over
+ * @param[in] prefix Pointer to the prefix bytes
+ * @param[in] prefixLen Number of prefix bytes
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapIteratorInitPrefix(zzRadixTreeMapIterator *it, zzRadixTreeMap *rm, const void *prefix, size_t prefixLen);
+
+/**
+ * @brief Advances the iterator to the next key-value pair.
+ *
+ * This function copies the current key and value to the output buffers and moves
+ * the iterator to the next key-value pair in sorted order. Returns false when the
+ * iterator reaches the end of its range.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] keyOut Pointer to a buffer where the current key will be copied
+ * @param[out] valueOut Pointer to a buffer where the current value will be copied
+ * @return true if a key-value pair was retrieved, false if the iterator reached the end
+ */
+bool zzRadixTreeMapIteratorNext(zzRadixTreeMapIterator *it, void *keyOut, void *valueOut);
+
+/**
+ * @brief Checks if the iterator has more elements.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more elements, false otherwise
+ */
+bool zzRadixTreeMapIteratorHasNext(const zzRadixTreeMapIterator *it);
+
+/**
+ * @brief Removes the last key-value pair returned by the iterator.
+ *
+ * The iterator stays positioned on the following entry.
+ *
+ * @param[in,out] it Pointer to the iterator
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapIteratorRemove(zzRadixTreeMapIterator *it);
+
+#endif
\ No newline at end of file
@@ -22,13 +22,19 @@
  *
  * Each node contains pointers to its left child, right child, and parent,
  * a color indicator for red-black tree balancing, and a flexible array member
- * to store both key and value data.
+ * to store both key and value data. When the library is built with ZZ_TREE_COMPACT_NODES
+ * defined, the color is packed into the lowest bit of the parent pointer, which
+ * shrinks the header to three words and starts the data pointer-aligned.
  */
 typedef struct TreeMapNode {
     struct TreeMapNode *left;   /**< Pointer to the left child node */
     struct TreeMapNode *right;  /**< Pointer to the right child node */
+#ifdef ZZ_TREE_COMPACT_NODES
+    uintptr_t parentColor;      /**< Pointer to the parent node, with the node color in its lowest bit */
+#else
     struct TreeMapNode *parent; /**< Pointer to the parent node */
     zzRBColor color;            /**< Color of the node (RED or BLACK) for red-black tree balancing */
+#endif
     unsigned char data[];       /**< Flexible array member to store key and value data */
 } TreeMapNode;
 
@@ -40,12 +46,19 @@ typedef struct TreeMapNode {
  */
 typedef struct zzTreeMap {
     TreeMapNode *root;      /**< Pointer to the root node of the red-black tree */
+    TreeMapNode *first;     /**< Pointer to the node with the smallest key, or NULL if the tree is empty */
+    TreeMapNode *last;      /**< Pointer to the node with the largest key, or NULL if the tree is empty */
     size_t size;            /**< Current number of key-value pairs in the tree */
     size_t keySize;         /**< Size in bytes of each key */
     size_t valueSize;       /**< Size in bytes of each value */
     zzCompareFn compareFn;  /**< Function to compare keys for ordering */
     zzFreeFn keyFree;       /**< Function to free key memory, or NULL if not needed */
     zzFreeFn valueFree;     /**< Function to free value memory, or NULL if not needed */
+    bool augmented;                     /**< Whether each node tracks its subtree size (order-statistic mode) */
+    size_t aggSize;                     /**< Size in bytes of the per-node value aggregate, or 0 if none is kept */
+    zzAggregateInitFn aggInit;          /**< Function to seed an aggregate from a single value, or NULL */
+    zzAggregateCombineFn aggCombine;    /**< Function to combine two adjacent aggregates, or NULL */
+    zzKeyPrefixFn prefixFn;             /**< Function extracting the key prefix cached in each node, or NULL */
 } zzTreeMap;
 
 /**
@@ -78,6 +91,46 @@ typedef struct zzTreeMapIterator {
  */
 zzOpResult zzTreeMapInit(zzTreeMap *tm, size_t keySize, size_t valueSize, zzCompareFn compareFn, zzFreeFn keyFree, zzFreeFn valueFree);
 
+/**
+ * @brief Initializes a new augmented TreeMap for order-statistic and aggregate queries.
+ *
+ * This function initializes a TreeMap like zzTreeMapInit, but every node additionally
+ * tracks the size of its subtree and, when aggregate functions are given, an aggregate
+ * of all values in its subtree. The augmentation is maintained through insertions,
+ * removals and rotations, enabling O(log n) rank, select and range-aggregate queries.
+ *
+ * @param[out] tm Pointer to the TreeMap structure to initialize
+ * @param[in] keySize Size in bytes of each key that will be stored in the map
+ * @param[in] valueSize Size in bytes of each value that will be stored in the map
+ * @param[in] compareFn Function to compare keys for ordering (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] keyFree Function to free key memory when entries are removed or the map is freed, or NULL if not needed
+ * @param[in] valueFree Function to free value memory when entries are removed or the map is freed, or NULL if not needed
+ * @param[in] aggSize Size in bytes of the value aggregate, or 0 to only track subtree sizes
+ * @param[in] aggInit Function to seed an aggregate from a single value (required if aggSize is non-zero)
+ * @param[in] aggCombine Associative function combining two adjacent aggregates (required if aggSize is non-zero)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapInitAugmented(zzTreeMap *tm, size_t keySize, size_t valueSize, zzCompareFn compareFn, zzFreeFn keyFree, zzFreeFn valueFree,
+                                  size_t aggSize, zzAggregateInitFn aggInit, zzAggregateCombineFn aggCombine);
+
+/**
+ * @brief Enables cached key prefixes on an empty TreeMap.
+ *
+ * This function makes every node also store a normalized 64-bit prefix of its
+ * key, computed by prefixFn. Lookups compare these prefixes with a single integer
+ * comparison first and only call the comparison function when two prefixes tie,
+ * so keys held out of line (such as strings) are rarely dereferenced during a
+ * descent. zzIntPrefix, zzLongPrefix and zzStringPrefix cover the built-in key
+ * types. The prefix must agree with the comparison function as described for
+ * zzKeyPrefixFn. Because it changes the node layout, the map must be empty;
+ * passing NULL turns the cache off again. Works with both plain and augmented maps.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to configure
+ * @param[in] prefixFn Function extracting the key prefix, or NULL to disable prefix caching
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapSetKeyPrefix(zzTreeMap *tm, zzKeyPrefixFn prefixFn);
+
 /**
  * @brief Frees all resources associated with the TreeMap.
  *
@@ -129,6 +182,44 @@ zzOpResult zzTreeMapGet(const zzTreeMap *tm, const void *key, void *valueOut);
  */
 bool zzTreeMapContains(const zzTreeMap *tm, const void *key);
 
+/**
+ * @brief Looks up a batch of independent keys with interleaved descents.
+ *
+ * This function keeps up to eight lookups in flight as a small state machine: after
+ * each comparison it prefetches the chosen child and switches to the next lookup,
+ * so the cache misses of the different descents overlap instead of being paid one
+ * after another. Each found value is copied to its slot in valuesOut; the slots of
+ * missing keys are left untouched.
+ *
+ * @param[in] tm Pointer to the TreeMap to retrieve from
+ * @param[in] keys Pointer to an array of count keys in any order
+ * @param[in] count Number of keys in the array
+ * @param[out] valuesOut Pointer to an array of count value slots receiving the found values
+ * @param[out] foundOut Pointer to an array of count flags telling which keys were found, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapGetBatch(const zzTreeMap *tm, const void *keys, size_t count, void *valuesOut, bool *foundOut);
+
+/**
+ * @brief Looks up a batch of keys sorted in ascending order, reusing the previous path.
+ *
+ * This function remembers the path of the previous lookup as a finger and resumes
+ * the next descent from the lowest remembered node whose subtree can still contain
+ * the key, so runs of nearby keys cost far fewer comparisons and cache misses than
+ * independent descents from the root. A key that is smaller than its predecessor
+ * simply restarts from the root, so unsorted input still yields correct results.
+ * Each found value is copied to its slot in valuesOut; the slots of missing keys
+ * are left untouched.
+ *
+ * @param[in] tm Pointer to the TreeMap to retrieve from
+ * @param[in] keys Pointer to an array of count keys, ideally in ascending order
+ * @param[in] count Number of keys in the array
+ * @param[out] valuesOut Pointer to an array of count value slots receiving the found values
+ * @param[out] foundOut Pointer to an array of count flags telling which keys were found, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapGetBatchSorted(const zzTreeMap *tm, const void *keys, size_t count, void *valuesOut, bool *foundOut);
+
 /**
  * @brief Removes the key-value pair associated with the given key from the TreeMap.
  *
@@ -155,12 +246,81 @@ zzOpResult zzTreeMapRemove(zzTreeMap *tm, const void *key);
  */
 void zzTreeMapClear(zzTreeMap *tm);
 
+/**
+ * @brief Removes every entry for which the predicate returns true.
+ *
+ * This function tests each key-value pair once, in ascending key order, frees
+ * the matching entries and relinks the remaining nodes into a balanced tree
+ * without any rotations, so it runs in O(n) time however many entries are
+ * removed. Subtree sizes and aggregates are recomputed during relinking. If
+ * custom free functions were provided, they are called on the key and value of
+ * every removed entry. The predicate must not modify the map. A temporary array
+ * of n node pointers is allocated; if that fails the map is left unchanged.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to filter
+ * @param[in] pred Function selecting the entries to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRemoveIf(zzTreeMap *tm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the entries for which the predicate returns true.
+ *
+ * This function is the complement of zzTreeMapRemoveIf and removes every entry
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to filter
+ * @param[in] pred Function selecting the entries to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRetainIf(zzTreeMap *tm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Replaces the contents of the TreeMap with entries from sorted arrays.
+ *
+ * This function builds a perfectly balanced red-black tree from count keys and
+ * values stored contiguously in the given arrays, in O(n) time and without any
+ * rotations. The keys must be in strictly ascending order according to the
+ * map's comparison function. Existing entries are cleared only after the input
+ * has been validated and all nodes have been allocated, so on failure the map
+ * is left unchanged.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to build
+ * @param[in] keys Pointer to an array of count keys in strictly ascending order (contents will be copied)
+ * @param[in] values Pointer to an array of count values matching the keys (contents will be copied)
+ * @param[in] count Number of entries in the arrays
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapBuildFromSorted(zzTreeMap *tm, const void *keys, const void *values, size_t count);
+
+/**
+ * @brief Inserts or updates a batch of key-value pairs in the TreeMap.
+ *
+ * This function stably sorts the (possibly unsorted) batch, merges it with the
+ * existing entries in a single in-order pass and relinks all nodes into a balanced
+ * tree, costing O(m log m + n) instead of m separate rebalancing insertions. Existing
+ * nodes are reused. Keys already present have their value replaced exactly as
+ * zzTreeMapPut would, and if a key repeats within the batch its last value wins.
+ * Batches that are small relative to the map are inserted one by one instead.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to insert into
+ * @param[in] keys Pointer to an array of count keys in any order (contents will be copied)
+ * @param[in] values Pointer to an array of count values matching the keys (contents will be copied)
+ * @param[in] count Number of entries in the arrays
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapPutAll(zzTreeMap *tm, const void *keys, const void *values, size_t count);
+
 /**
  * @brief Gets the minimum key-value pair from the TreeMap.
  *
  * This function retrieves the key-value pair with the smallest key in the tree map
- * and copies both the key and value to the output buffers. The minimum element
- * is the leftmost node in the binary search tree.
+ * and copies both the key and value to the output buffers. The map keeps a
+ * pointer to its leftmost node, so this takes O(1) time.
  *
  * @param[in] tm Pointer to the TreeMap to retrieve from
  * @param[out] keyOut Pointer to a buffer where the minimum key will be copied
@@ -173,8 +333,8 @@ zzOpResult zzTreeMapGetMin(const zzTreeMap *tm, void *keyOut, void *valueOut);
  * @brief Gets the maximum key-value pair from the TreeMap.
  *
  * This function retrieves the key-value pair with the largest key in the tree map
- * and copies both the key and value to the output buffers. The maximum element
- * is the rightmost node in the binary search tree.
+ * and copies both the key and value to the output buffers. The map keeps a
+ * pointer to its rightmost node, so this takes O(1) time.
  *
  * @param[in] tm Pointer to the TreeMap to retrieve from
  * @param[out] keyOut Pointer to a buffer where the maximum key will be copied
@@ -183,6 +343,169 @@ zzOpResult zzTreeMapGetMin(const zzTreeMap *tm, void *keyOut, void *valueOut);
  */
 zzOpResult zzTreeMapGetMax(const zzTreeMap *tm, void *keyOut, void *valueOut);
 
+/**
+ * @brief Removes the entry with the smallest key from the TreeMap and returns it.
+ *
+ * This function removes the leftmost entry in a single operation, without a
+ * separate lookup, so the map can serve as an updatable priority queue. The key
+ * and value are handed to the caller, so the free functions are not called on
+ * them; an output pointer may be NULL to discard that part, in which case the
+ * corresponding free function is called instead.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to remove from
+ * @param[out] keyOut Pointer to a buffer where the smallest key will be copied, or NULL
+ * @param[out] valueOut Pointer to a buffer where its value will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapPollFirst(zzTreeMap *tm, void *keyOut, void *valueOut);
+
+/**
+ * @brief Removes the entry with the largest key from the TreeMap and returns it.
+ *
+ * This function removes the rightmost entry in a single operation, without a
+ * separate lookup. The key and value are handed to the caller, so the free
+ * functions are not called on them; an output pointer may be NULL to discard
+ * that part, in which case the corresponding free function is called instead.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to remove from
+ * @param[out] keyOut Pointer to a buffer where the largest key will be copied, or NULL
+ * @param[out] valueOut Pointer to a buffer where its value will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapPollLast(zzTreeMap *tm, void *keyOut, void *valueOut);
+
+/**
+ * @brief Computes the rank of a key in an augmented TreeMap.
+ *
+ * This function counts how many keys in the tree map are strictly smaller than
+ * the given key, using the subtree sizes kept by an augmented map. The key does
+ * not need to be present in the map. Runs in O(log n).
+ *
+ * @param[in] tm Pointer to the augmented TreeMap to query
+ * @param[in] key Pointer to the key whose rank is requested
+ * @param[out] rankOut Pointer to where the number of smaller keys will be stored
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRank(const zzTreeMap *tm, const void *key, size_t *rankOut);
+
+/**
+ * @brief Retrieves the key-value pair at the given sorted position of an augmented TreeMap.
+ *
+ * This function finds the entry whose key is the rank-th smallest (0-based) in the
+ * tree map and copies its key and value to the output buffers. Runs in O(log n).
+ *
+ * @param[in] tm Pointer to the augmented TreeMap to query
+ * @param[in] rank Sorted position of the entry to retrieve (0-based)
+ * @param[out] keyOut Pointer to a buffer where the key will be copied, or NULL
+ * @param[out] valueOut Pointer to a buffer where the value will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapSelect(const zzTreeMap *tm, size_t rank, void *keyOut, void *valueOut);
+
+/**
+ * @brief Computes the aggregate of all values whose keys lie in [lo, hi).
+ *
+ * This function combines the per-subtree aggregates of an augmented TreeMap that
+ * was initialized with aggregate functions, touching O(log n) nodes. A NULL bound
+ * leaves that side of the range open. The function returns an error if no key
+ * falls inside the range, since an empty range has no aggregate.
+ *
+ * @param[in] tm Pointer to the augmented TreeMap to query
+ * @param[in] lo Pointer to the inclusive lower bound key, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound key, or NULL for no upper bound
+ * @param[out] aggOut Pointer to a buffer of aggSize bytes receiving the aggregate
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRangeAggregate(const zzTreeMap *tm, const void *lo, const void *hi, void *aggOut);
+
+/**
+ * @brief Splits a TreeMap around a key into two TreeMaps.
+ *
+ * This function moves every entry with a key smaller than the given key into
+ * left and every remaining entry into right, reusing the existing nodes without
+ * copying any keys or values. The tree is cut along the search path and the
+ * pieces are rejoined by black height. Both outputs are initialized with the
+ * configuration of tm (including augmentation); their previous contents are not
+ * freed. Unless it is passed as one of the outputs, tm is left empty and remains
+ * usable. Augmented maps know their subtree sizes, so the split takes O(log n)
+ * time; for plain maps the smaller half is additionally counted to set the
+ * sizes, which makes it O(log n + min(|L|, |R|)) for output sizes |L| and |R|.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to split
+ * @param[in] key Pointer to the key at which to split; entries with this key go to right
+ * @param[out] left Pointer to the TreeMap receiving the entries with smaller keys
+ * @param[out] right Pointer to the TreeMap receiving the entries with greater or equal keys
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapSplit(zzTreeMap *tm, const void *key, zzTreeMap *left, zzTreeMap *right);
+
+/**
+ * @brief Joins two TreeMaps whose key ranges do not overlap.
+ *
+ * This function moves every entry of right into left, reusing the existing
+ * nodes without copying any keys or values. Every key in left must be smaller
+ * than every key in right. The smaller tree is hung into the spine of the taller
+ * one at matching black height and rebalanced, which takes O(log n) time. Both
+ * maps must share key size, value size, comparison function, augmentation and
+ * key prefix function; left keeps its own free functions. Afterwards right is
+ * empty and remains usable.
+ *
+ * @param[in,out] left Pointer to the TreeMap receiving all entries
+ * @param[in,out] right Pointer to the TreeMap whose entries are moved; emptied on success
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapJoin(zzTreeMap *left, zzTreeMap *right);
+
+/**
+ * @brief Removes every entry whose key lies in the range [lo, hi).
+ *
+ * This function cuts the range out of the tree with two splits, joins the
+ * remaining halves back together and then frees the detached subtree in a
+ * single pass, instead of rebalancing once per removed key. It runs in
+ * O(log n + k) time for k removed entries. A NULL bound leaves that side of
+ * the range open. If a custom free function was provided for keys or values,
+ * it is called on every removed key and value.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to remove the entries from
+ * @param[in] lo Pointer to the inclusive lower bound, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound, or NULL for no upper bound
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRemoveRange(zzTreeMap *tm, const void *lo, const void *hi);
+
+/**
+ * @brief Counts the entries whose key lies in the range [lo, hi).
+ *
+ * This function counts the keys in the half-open range without modifying the
+ * map. On maps created with zzTreeMapInitAugmented the count is derived from the
+ * subtree sizes in O(log n) time; otherwise the entries in the range are walked
+ * in O(log n + k) time. A NULL bound leaves that side of the range open.
+ *
+ * @param[in] tm Pointer to the TreeMap to count in
+ * @param[in] lo Pointer to the inclusive lower bound, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound, or NULL for no upper bound
+ * @param[out] countOut Pointer to a size_t receiving the number of entries in the range
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapCountRange(const zzTreeMap *tm, const void *lo, const void *hi, size_t *countOut);
+
+/**
+ * @brief Relocates all nodes of the TreeMap into contiguous memory in key order.
+ *
+ * After many insertions and removals the nodes of a tree end up scattered over
+ * the heap, so an in-order walk takes a cache miss per node. This function
+ * copies every node into large size-aligned slab chunks in ascending key order
+ * and relinks them into a perfectly balanced tree, so iteration and range scans
+ * touch memory sequentially again. Keys and values are moved, not copied, so no
+ * free functions are called. Nodes inserted later are allocated individually as
+ * usual, and a chunk is returned to the system once all of its nodes are gone.
+ * Runs in O(n) time and invalidates all iterators over the map.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to compact
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapCompact(zzTreeMap *tm);
+
 /**
  * @brief Initializes an iterator for the TreeMap.
  *
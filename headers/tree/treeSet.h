@@ -22,13 +22,19 @@
  *
  * Each node contains pointers to its left child, right child, and parent,
  * a color indicator for red-black tree balancing, and a flexible array member
- * to store the key data.
+ * to store the key data. When the library is built with ZZ_TREE_COMPACT_NODES
+ * defined, the color is packed into the lowest bit of the parent pointer, which
+ * shrinks the header to three words and starts the data pointer-aligned.
  */
 typedef struct TreeSetNode {
     struct TreeSetNode *left;   /**< Pointer to the left child node */
     struct TreeSetNode *right;  /**< Pointer to the right child node */
+#ifdef ZZ_TREE_COMPACT_NODES
+    uintptr_t parentColor;      /**< Pointer to the parent node, with the node color in its lowest bit */
+#else
     struct TreeSetNode *parent; /**< Pointer to the parent node */
     zzRBColor color;            /**< Color of the node (RED or BLACK) for red-black tree balancing */
+#endif
     unsigned char key[];        /**< Flexible array member to store the key data */
 } TreeSetNode;
 
@@ -40,10 +46,17 @@ typedef struct TreeSetNode {
  */
 typedef struct zzTreeSet {
     TreeSetNode *root;      /**< Pointer to the root node of the red-black tree */
+    TreeSetNode *first;     /**< Pointer to the node with the smallest key, or NULL if the tree is empty */
+    TreeSetNode *last;      /**< Pointer to the node with the largest key, or NULL if the tree is empty */
     size_t size;            /**< Current number of keys in the set */
     size_t keySize;         /**< Size in bytes of each key */
     zzCompareFn compareFn;  /**< Function to compare keys for ordering */
     zzFreeFn keyFree;       /**< Function to free key memory, or NULL if not needed */
+    bool augmented;                     /**< Whether each node tracks its subtree size (order-statistic mode) */
+    size_t aggSize;                     /**< Size in bytes of the per-node key aggregate, or 0 if none is kept */
+    zzAggregateInitFn aggInit;          /**< Function to seed an aggregate from a single key, or NULL */
+    zzAggregateCombineFn aggCombine;    /**< Function to combine two adjacent aggregates, or NULL */
+    zzKeyPrefixFn prefixFn;             /**< Function extracting the key prefix cached in each node, or NULL */
 } zzTreeSet;
 
 /**
@@ -74,6 +87,44 @@ typedef struct zzTreeSetIterator {
  */
 zzOpResult zzTreeSetInit(zzTreeSet *ts, size_t keySize, zzCompareFn compareFn, zzFreeFn keyFree);
 
+/**
+ * @brief Initializes a new augmented TreeSet for order-statistic and aggregate queries.
+ *
+ * This function initializes a TreeSet like zzTreeSetInit, but every node additionally
+ * tracks the size of its subtree and, when aggregate functions are given, an aggregate
+ * of all keys in its subtree. The augmentation is maintained through insertions,
+ * removals and rotations, enabling O(log n) rank, select and range-aggregate queries.
+ *
+ * @param[out] ts Pointer to the TreeSet structure to initialize
+ * @param[in] keySize Size in bytes of each key that will be stored in the set
+ * @param[in] compareFn Function to compare keys for ordering (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] keyFree Function to free key memory when entries are removed or the set is freed, or NULL if not needed
+ * @param[in] aggSize Size in bytes of the key aggregate, or 0 to only track subtree sizes
+ * @param[in] aggInit Function to seed an aggregate from a single key (required if aggSize is non-zero)
+ * @param[in] aggCombine Associative function combining two adjacent aggregates (required if aggSize is non-zero)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetInitAugmented(zzTreeSet *ts, size_t keySize, zzCompareFn compareFn, zzFreeFn keyFree,
+                                  size_t aggSize, zzAggregateInitFn aggInit, zzAggregateCombineFn aggCombine);
+
+/**
+ * @brief Enables cached key prefixes on an empty TreeSet.
+ *
+ * This function makes every node also store a normalized 64-bit prefix of its
+ * key, computed by prefixFn. Lookups compare these prefixes with a single integer
+ * comparison first and only call the comparison function when two prefixes tie,
+ * so keys held out of line (such as strings) are rarely dereferenced during a
+ * descent. zzIntPrefix, zzLongPrefix and zzStringPrefix cover the built-in key
+ * types. The prefix must agree with the comparison function as described for
+ * zzKeyPrefixFn. Because it changes the node layout, the set must be empty;
+ * passing NULL turns the cache off again. Works with both plain and augmented sets.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to configure
+ * @param[in] prefixFn Function extracting the key prefix, or NULL to disable prefix caching
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSetKeyPrefix(zzTreeSet *ts, zzKeyPrefixFn prefixFn);
+
 /**
  * @brief Frees all resources associated with the TreeSet.
  *
@@ -135,11 +186,76 @@ zzOpResult zzTreeSetRemove(zzTreeSet *ts, const void *key);
  */
 void zzTreeSetClear(zzTreeSet *ts);
 
+/**
+ * @brief Removes every key for which the predicate returns true.
+ *
+ * This function tests each key once, in ascending order, frees the matching keys
+ * and relinks the remaining nodes into a balanced tree without any rotations, so
+ * it runs in O(n) time however many keys are removed. Subtree sizes and
+ * aggregates are recomputed during relinking. If a custom free function was
+ * provided, it is called on every removed key. The predicate must not modify the
+ * set. A temporary array of n node pointers is allocated; if that fails the set
+ * is left unchanged.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to filter
+ * @param[in] pred Function selecting the keys to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRemoveIf(zzTreeSet *ts, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Keeps only the keys for which the predicate returns true.
+ *
+ * This function is the complement of zzTreeSetRemoveIf and removes every key
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to filter
+ * @param[in] pred Function selecting the keys to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRetainIf(zzTreeSet *ts, zzPredicateFn pred, void *userdata, size_t *removedOut);
+
+/**
+ * @brief Replaces the contents of the TreeSet with keys from a sorted array.
+ *
+ * This function builds a perfectly balanced red-black tree from count keys stored
+ * contiguously in the given array, in O(n) time and without any rotations. The keys
+ * must be in strictly ascending order according to the set's comparison function.
+ * Existing keys are cleared only after the input has been validated and all nodes
+ * have been allocated, so on failure the set is left unchanged.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to build
+ * @param[in] keys Pointer to an array of count keys in strictly ascending order (contents will be copied)
+ * @param[in] count Number of keys in the array
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetBuildFromSorted(zzTreeSet *ts, const void *keys, size_t count);
+
+/**
+ * @brief Inserts a batch of keys into the TreeSet.
+ *
+ * This function stably sorts the (possibly unsorted) batch, merges it with the
+ * existing keys in a single in-order pass and relinks all nodes into a balanced
+ * tree, costing O(m log m + n) instead of m separate rebalancing insertions. Existing
+ * nodes are reused. Keys that are already present, or that repeat within the batch,
+ * are skipped. Batches that are small relative to the set are inserted one by one instead.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to insert into
+ * @param[in] keys Pointer to an array of count keys in any order (contents will be copied)
+ * @param[in] count Number of keys in the array
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetInsertAll(zzTreeSet *ts, const void *keys, size_t count);
+
 /**
  * @brief Gets the minimum key from the TreeSet.
  *
  * This function retrieves the smallest key in the tree set and copies it to the
- * output buffer. The minimum element is the leftmost node in the binary search tree.
+ * output buffer. The set keeps a pointer to its leftmost node, so this takes O(1) time.
  *
  * @param[in] ts Pointer to the TreeSet to retrieve from
  * @param[out] keyOut Pointer to a buffer where the minimum key will be copied
@@ -151,7 +267,7 @@ zzOpResult zzTreeSetGetMin(const zzTreeSet *ts, void *keyOut);
  * @brief Gets the maximum key from the TreeSet.
  *
  * This function retrieves the largest key in the tree set and copies it to the
- * output buffer. The maximum element is the rightmost node in the binary search tree.
+ * output buffer. The set keeps a pointer to its rightmost node, so this takes O(1) time.
  *
  * @param[in] ts Pointer to the TreeSet to retrieve from
  * @param[out] keyOut Pointer to a buffer where the maximum key will be copied
@@ -159,6 +275,282 @@ zzOpResult zzTreeSetGetMin(const zzTreeSet *ts, void *keyOut);
  */
 zzOpResult zzTreeSetGetMax(const zzTreeSet *ts, void *keyOut);
 
+/**
+ * @brief Removes the smallest key from the TreeSet and returns it.
+ *
+ * This function removes the leftmost key in a single operation, without a
+ * separate lookup, so the set can serve as an updatable priority queue. The key
+ * is handed to the caller, so the free function is not called on it; keyOut may
+ * be NULL to discard the key, in which case the free function is called instead.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to remove from
+ * @param[out] keyOut Pointer to a buffer where the smallest key will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetPollFirst(zzTreeSet *ts, void *keyOut);
+
+/**
+ * @brief Removes the largest key from the TreeSet and returns it.
+ *
+ * This function removes the rightmost key in a single operation, without a
+ * separate lookup. The key is handed to the caller, so the free function is not
+ * called on it; keyOut may be NULL to discard the key, in which case the free
+ * function is called instead.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to remove from
+ * @param[out] keyOut Pointer to a buffer where the largest key will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetPollLast(zzTreeSet *ts, void *keyOut);
+
+/**
+ * @brief Computes the rank of a key in an augmented TreeSet.
+ *
+ * This function counts how many keys in the tree set are strictly smaller than
+ * the given key, using the subtree sizes kept by an augmented set. The key does
+ * not need to be present in the set. Runs in O(log n).
+ *
+ * @param[in] ts Pointer to the augmented TreeSet to query
+ * @param[in] key Pointer to the key whose rank is requested
+ * @param[out] rankOut Pointer to where the number of smaller keys will be stored
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRank(const zzTreeSet *ts, const void *key, size_t *rankOut);
+
+/**
+ * @brief Retrieves the key at the given sorted position of an augmented TreeSet.
+ *
+ * This function finds the rank-th smallest key (0-based) in the tree set and
+ * copies it to the output buffer. Runs in O(log n).
+ *
+ * @param[in] ts Pointer to the augmented TreeSet to query
+ * @param[in] rank Sorted position of the key to retrieve (0-based)
+ * @param[out] keyOut Pointer to a buffer where the key will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSelect(const zzTreeSet *ts, size_t rank, void *keyOut);
+
+/**
+ * @brief Computes the aggregate of all keys in [lo, hi).
+ *
+ * This function combines the per-subtree aggregates of an augmented TreeSet that
+ * was initialized with aggregate functions, touching O(log n) nodes. A NULL bound
+ * leaves that side of the range open. The function returns an error if no key
+ * falls inside the range, since an empty range has no aggregate.
+ *
+ * @param[in] ts Pointer to the augmented TreeSet to query
+ * @param[in] lo Pointer to the inclusive lower bound key, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound key, or NULL for no upper bound
+ * @param[out] aggOut Pointer to a buffer of aggSize bytes receiving the aggregate
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRangeAggregate(const zzTreeSet *ts, const void *lo, const void *hi, void *aggOut);
+
+/**
+ * @brief Computes the union of two tree sets into a new set.
+ *
+ * This function walks both sets in sorted order, merges them in O(n + m) and builds
+ * the result as a balanced tree in a single pass. The result set is initialized by
+ * this function with the key size, comparison function, augmentation and key
+ * prefix settings of the first set. Both sets must share the same key size and comparison function.
+ *
+ * @param[in] s1 Pointer to the first TreeSet
+ * @param[in] s2 Pointer to the second TreeSet
+ * @param[out] result Pointer to the TreeSet where the union will be stored
+ * @param[in] keyFree Function to free key memory in the result set, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetUnion(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree);
+
+/**
+ * @brief Computes the intersection of two tree sets into a new set.
+ *
+ * This function walks both sets in sorted order and collects the keys present in
+ * both, in O(n + m), building the result as a balanced tree in a single pass. The
+ * result set is initialized by this function like the first set. Both sets must
+ * share the same key size and comparison function.
+ *
+ * @param[in] s1 Pointer to the first TreeSet
+ * @param[in] s2 Pointer to the second TreeSet
+ * @param[out] result Pointer to the TreeSet where the intersection will be stored
+ * @param[in] keyFree Function to free key memory in the result set, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetIntersection(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree);
+
+/**
+ * @brief Computes the difference of two tree sets into a new set.
+ *
+ * This function walks both sets in sorted order and collects the keys of the first
+ * set that are absent from the second, in O(n + m), building the result as a
+ * balanced tree in a single pass. The result set is initialized by this function
+ * like the first set. Both sets must share the same key size and comparison function.
+ *
+ * @param[in] s1 Pointer to the first TreeSet (minuend)
+ * @param[in] s2 Pointer to the second TreeSet (subtrahend)
+ * @param[out] result Pointer to the TreeSet where the difference will be stored
+ * @param[in] keyFree Function to free key memory in the result set, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetDifference(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree);
+
+/**
+ * @brief Computes the symmetric difference of two tree sets into a new set.
+ *
+ * This function walks both sets in sorted order and collects the keys present in
+ * exactly one of them, in O(n + m), building the result as a balanced tree in a
+ * single pass. The result set is initialized by this function like the first set.
+ * Both sets must share the same key size and comparison function.
+ *
+ * @param[in] s1 Pointer to the first TreeSet
+ * @param[in] s2 Pointer to the second TreeSet
+ * @param[out] result Pointer to the TreeSet where the symmetric difference will be stored
+ * @param[in] keyFree Function to free key memory in the result set, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSymmetricDifference(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree);
+
+/**
+ * @brief Adds every key of the second tree set to the first.
+ *
+ * This function merges both sets in sorted order in O(n + m) and relinks the first
+ * set as a balanced tree, reusing its existing nodes and copying only the keys that
+ * it did not already contain. On failure the first set is left unchanged.
+ *
+ * @param[in,out] s1 Pointer to the TreeSet that receives the union
+ * @param[in] s2 Pointer to the TreeSet whose keys are added
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetUnionInPlace(zzTreeSet *s1, const zzTreeSet *s2);
+
+/**
+ * @brief Removes from the first tree set every key absent from the second.
+ *
+ * This function merges both sets in sorted order in O(n + m), frees the nodes of
+ * the first set whose keys are not in the second (calling keyFree if provided) and
+ * relinks the remaining nodes as a balanced tree.
+ *
+ * @param[in,out] s1 Pointer to the TreeSet that keeps the intersection
+ * @param[in] s2 Pointer to the TreeSet to intersect with
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetIntersectionInPlace(zzTreeSet *s1, const zzTreeSet *s2);
+
+/**
+ * @brief Removes from the first tree set every key present in the second.
+ *
+ * This function merges both sets in sorted order in O(n + m), frees the nodes of
+ * the first set whose keys also appear in the second (calling keyFree if provided)
+ * and relinks the remaining nodes as a balanced tree.
+ *
+ * @param[in,out] s1 Pointer to the TreeSet that keeps the difference
+ * @param[in] s2 Pointer to the TreeSet whose keys are removed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetDifferenceInPlace(zzTreeSet *s1, const zzTreeSet *s2);
+
+/**
+ * @brief Replaces the first tree set with the symmetric difference of both sets.
+ *
+ * This function merges both sets in sorted order in O(n + m), frees the nodes of
+ * the first set whose keys also appear in the second (calling keyFree if provided),
+ * copies in the keys found only in the second set and relinks the result as a
+ * balanced tree. On allocation failure the first set is left unchanged.
+ *
+ * @param[in,out] s1 Pointer to the TreeSet that receives the symmetric difference
+ * @param[in] s2 Pointer to the other TreeSet
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSymmetricDifferenceInPlace(zzTreeSet *s1, const zzTreeSet *s2);
+
+/**
+ * @brief Splits a TreeSet around a key into two TreeSets.
+ *
+ * This function moves every key smaller than the given key into left and every
+ * remaining key into right, reusing the existing nodes without copying any keys.
+ * The tree is cut along the search path and the pieces are rejoined by black
+ * height. Both outputs are initialized with the configuration of ts (including
+ * augmentation); their previous contents are not freed. Unless it is passed as
+ * one of the outputs, ts is left empty and remains usable. Augmented sets know
+ * their subtree sizes, so the split takes O(log n) time; for plain sets the
+ * smaller half is additionally counted to set the sizes, which makes it
+ * O(log n + min(|L|, |R|)) for output sizes |L| and |R|.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to split
+ * @param[in] key Pointer to the key at which to split; this key itself goes to right
+ * @param[out] left Pointer to the TreeSet receiving the smaller keys
+ * @param[out] right Pointer to the TreeSet receiving the greater or equal keys
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSplit(zzTreeSet *ts, const void *key, zzTreeSet *left, zzTreeSet *right);
+
+/**
+ * @brief Joins two TreeSets whose key ranges do not overlap.
+ *
+ * This function moves every key of right into left, reusing the existing
+ * nodes without copying any keys. Every key in left must be smaller
+ * than every key in right. The smaller tree is hung into the spine of the taller
+ * one at matching black height and rebalanced, which takes O(log n) time. Both
+ * sets must share key size, comparison function, augmentation and key prefix
+ * function; left keeps its own free function. Afterwards right is empty and
+ * remains usable.
+ *
+ * @param[in,out] left Pointer to the TreeSet receiving all keys
+ * @param[in,out] right Pointer to the TreeSet whose keys are moved; emptied on success
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetJoin(zzTreeSet *left, zzTreeSet *right);
+
+/**
+ * @brief Removes every key that lies in the range [lo, hi).
+ *
+ * This function cuts the range out of the tree with two splits, joins the
+ * remaining halves back together and then frees the detached subtree in a
+ * single pass, instead of rebalancing once per removed key. It runs in
+ * O(log n + k) time for k removed keys. A NULL bound leaves that side of the
+ * range open. If a custom free function was provided for keys, it is called
+ * on every removed key.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to remove the keys from
+ * @param[in] lo Pointer to the inclusive lower bound, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound, or NULL for no upper bound
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRemoveRange(zzTreeSet *ts, const void *lo, const void *hi);
+
+/**
+ * @brief Counts the keys that lie in the range [lo, hi).
+ *
+ * This function counts the keys in the half-open range without modifying the
+ * set. On sets created with zzTreeSetInitAugmented the count is derived from the
+ * subtree sizes in O(log n) time; otherwise the keys in the range are walked
+ * in O(log n + k) time. A NULL bound leaves that side of the range open.
+ *
+ * @param[in] ts Pointer to the TreeSet to count in
+ * @param[in] lo Pointer to the inclusive lower bound, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound, or NULL for no upper bound
+ * @param[out] countOut Pointer to a size_t receiving the number of keys in the range
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetCountRange(const zzTreeSet *ts, const void *lo, const void *hi, size_t *countOut);
+
+/**
+ * @brief Relocates all nodes of the TreeSet into contiguous memory in key order.
+ *
+ * After many insertions and removals the nodes of a tree end up scattered over
+ * the heap, so an in-order walk takes a cache miss per node. This function
+ * copies every node into large size-aligned slab chunks in ascending key order
+ * and relinks them into a perfectly balanced tree, so iteration and range scans
+ * touch memory sequentially again. Keys are moved, not copied, so the free
+ * function is not called. Nodes inserted later are allocated individually as
+ * usual, and a chunk is returned to the system once all of its nodes are gone.
+ * Runs in O(n) time and invalidates all iterators over the set.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to compact
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetCompact(zzTreeSet *ts);
+
 /**
  * @brief Initializes an iterator for the TreeSet.
  *
@@ -0,0 +1,224 @@
+/**
+ * @file parallelSort.c
+ * @brief Implementation of the multi-threaded sort for large contiguous buffers.
+ *
+ * This module provides a parallel merge sort built on POSIX threads: every
+ * thread sorts one chunk with zzSort, then rounds of pairwise merges halve the
+ * number of sorted runs until one is left.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "parallelSort.h"
+#include "sort.h"
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct {
+    unsigned char *src;     // Buffer holding the sorted runs of the current round
+    unsigned char *dst;     // Buffer receiving the merged runs
+    size_t count;           // Number of elements
+    size_t es;              // Element size in bytes
+    zzCompareFn cmp;        // Element comparison function
+    size_t threads;         // Number of workers
+    size_t *bounds;         // Run i covers elements [bounds[i], bounds[i + 1])
+    size_t runs;            // Number of runs in src
+    zzOpResult *results;    // Result of each worker's chunk sort
+} ParallelSortCtx;
+
+typedef struct {
+    ParallelSortCtx *ctx;
+    size_t index;
+} ParallelSortWorker;
+
+static inline void copyElem(void *dst, const void *src, size_t es) {
+    switch (es) {
+        case 4: memcpy(dst, src, 4); break;
+        case 8: memcpy(dst, src, 8); break;
+        case 16: memcpy(dst, src, 16); break;
+        default: memcpy(dst, src, es); break;
+    }
+}
+
+// First element of worker i's share when count elements are split over the workers
+static size_t shareStart(const ParallelSortCtx *ctx, size_t i) {
+    size_t q = ctx->count / ctx->threads, r = ctx->count % ctx->threads;
+    return q * i + (i < r ? i : r);
+}
+
+// Runs fn once for every worker, on new threads and the calling thread, and waits for all of them
+static void runWorkers(ParallelSortCtx *ctx, ParallelSortWorker *workers, pthread_t *tids, bool *started, void *(*fn)(void*)) {
+    for (size_t i = 1; i < ctx->threads; i++) {
+        started[i] = pthread_create(&tids[i], NULL, fn, &workers[i]) == 0;
+    }
+    fn(&workers[0]);
+    for (size_t i = 1; i < ctx->threads; i++) {
+        if (started[i]) pthread_join(tids[i], NULL);
+        else fn(&workers[i]);
+    }
+}
+
+static void *sortChunk(void *arg) {
+    ParallelSortWorker *w = arg;
+    ParallelSortCtx *ctx = w->ctx;
+    size_t from = ctx->bounds[w->index], to = ctx->bounds[w->index + 1];
+
+    ctx->results[w->index] = zzSort(ctx->src + from * ctx->es, to - from, ctx->es, ctx->cmp);
+    return NULL;
+}
+
+// Number of elements of a among the first k elements of the stable merge of a and b
+static size_t coRank(const ParallelSortCtx *ctx, const unsigned char *a, size_t lenA, const unsigned char *b, size_t lenB, size_t k) {
+    size_t es = ctx->es;
+    size_t lo = k > lenB ? k - lenB : 0;
+    size_t hi = k < lenA ? k : lenA;
+
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        // a[i] precedes b[k - i - 1] in the merge, so more than i elements come from a
+        if (ctx->cmp(b + (k - i - 1) * es, a + i * es) >= 0) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+static void mergeSlices(const ParallelSortCtx *ctx, const unsigned char *a, const unsigned char *aEnd, const unsigned char *b, const unsigned char *bEnd, unsigned char *out) {
+    size_t es = ctx->es;
+
+    while (a < aEnd && b < bEnd) {
+        // Taking from a on ties keeps the merge stable
+        if (ctx->cmp(b, a) < 0) {
+            copyElem(out, b, es);
+            b += es;
+        } else {
+            copyElem(out, a, es);
+            a += es;
+        }
+        out += es;
+    }
+    memcpy(out, a, (size_t)(aEnd - a));
+    out += aEnd - a;
+    memcpy(out, b, (size_t)(bEnd - b));
+}
+
+// Produces the worker's share of the output of one round, which merges runs 2g and 2g + 1
+// into one run for every g. A run left without a partner is copied through unchanged.
+static void *mergeShare(void *arg) {
+    ParallelSortWorker *w = arg;
+    ParallelSortCtx *ctx = w->ctx;
+    size_t es = ctx->es;
+    size_t lo = shareStart(ctx, w->index), hi = shareStart(ctx, w->index + 1);
+
+    for (size_t g = 0; 2 * g < ctx->runs; g++) {
+        size_t start = ctx->bounds[2 * g];
+        size_t mid = ctx->bounds[2 * g + 1];
+        size_t end = 2 * g + 2 <= ctx->runs ? ctx->bounds[2 * g + 2] : mid;
+        if (end <= lo) continue;
+        if (start >= hi) break;
+
+        size_t kLo = (lo > start ? lo : start) - start;
+        size_t kHi = (hi < end ? hi : end) - start;
+        unsigned char *out = ctx->dst + (start + kLo) * es;
+        if (mid == end) {
+            memcpy(out, ctx->src + (start + kLo) * es, (kHi - kLo) * es);
+            continue;
+        }
+
+        const unsigned char *a = ctx->src + start * es, *b = ctx->src + mid * es;
+        size_t lenA = mid - start, lenB = end - mid;
+        size_t i0 = coRank(ctx, a, lenA, b, lenB, kLo);
+        size_t i1 = coRank(ctx, a, lenA, b, lenB, kHi);
+        mergeSlices(ctx, a + i0 * es, a + i1 * es, b + (kLo - i0) * es, b + (kHi - i1) * es, out);
+    }
+    return NULL;
+}
+
+// Sorts one chunk per worker and merges the runs until ctx->src holds a single sorted run
+static zzOpResult sortAndMerge(ParallelSortCtx *ctx, ParallelSortWorker *workers, pthread_t *tids, bool *started) {
+    for (size_t i = 0; i < ctx->threads; i++) {
+        workers[i].ctx = ctx;
+        workers[i].index = i;
+        ctx->bounds[i] = shareStart(ctx, i);
+    }
+    ctx->bounds[ctx->threads] = ctx->count;
+
+    runWorkers(ctx, workers, tids, started, sortChunk);
+    for (size_t i = 0; i < ctx->threads; i++) {
+        if (ZZ_IS_ERR(ctx->results[i])) return ctx->results[i];
+    }
+
+    while (ctx->runs > 1) {
+        runWorkers(ctx, workers, tids, started, mergeShare);
+
+        size_t runs = (ctx->runs + 1) / 2;
+        for (size_t g = 0; g < runs; g++) ctx->bounds[g] = ctx->bounds[2 * g];
+        ctx->bounds[runs] = ctx->count;
+        ctx->runs = runs;
+
+        unsigned char *t = ctx->src;
+        ctx->src = ctx->dst;
+        ctx->dst = t;
+    }
+    return ZZ_OK();
+}
+
+/**
+ * @brief Sorts a buffer in ascending order using several threads.
+ *
+ * This function sorts the buffer in place. The sort is not stable. It uses at
+ * most threads threads, including the calling one, and fewer when the buffer
+ * has less than ZZ_PARALLEL_SORT_MIN_CHUNK elements per thread; small buffers are
+ * sorted with zzSort directly. A threads value of 0 uses one thread per online
+ * processor. The merge phase allocates a temporary buffer of count elements.
+ * If a thread cannot be started its share of the work runs on the calling thread.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer to sort
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b); called concurrently from several threads
+ * @param[in] threads Maximum number of threads to use, or 0 for one per online processor
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzParallelSort(void *base, size_t count, size_t elSize, zzCompareFn cmp, size_t threads) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t)online : 1;
+    }
+    if (threads > count / ZZ_PARALLEL_SORT_MIN_CHUNK) threads = count / ZZ_PARALLEL_SORT_MIN_CHUNK;
+    if (threads <= 1) return zzSort(base, count, elSize, cmp);
+
+    unsigned char *scratch = malloc(count * elSize);
+    size_t *bounds = malloc((threads + 1) * sizeof(size_t));
+    zzOpResult *results = malloc(threads * sizeof(zzOpResult));
+    ParallelSortWorker *workers = malloc(threads * sizeof(ParallelSortWorker));
+    pthread_t *tids = malloc(threads * sizeof(pthread_t));
+    bool *started = malloc(threads * sizeof(bool));
+
+    zzOpResult result;
+    if (!scratch || !bounds || !results || !workers || !tids || !started) {
+        result = ZZ_ERR("Memory allocation failed");
+    } else {
+        ParallelSortCtx ctx = { base, scratch, count, elSize, cmp, threads, bounds, threads, results };
+        result = sortAndMerge(&ctx, workers, tids, started);
+
+        // A single run is copied through, so an odd number of rounds ends with a parallel copy back
+        if (ZZ_IS_OK(result) && ctx.src != (unsigned char*)base) {
+            ctx.dst = base;
+            runWorkers(&ctx, workers, tids, started, mergeShare);
+        }
+    }
+
+    free(started);
+    free(tids);
+    free(workers);
+    free(results);
+    free(bounds);
+    free(scratch);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+/**
+ * @file scan.c
+ * @brief Implementation of the vectorized linear scans over built-in numeric elements.
+ *
+ * This module provides one set of scan kernels per element type and instruction
+ * set. A scan looks up the best set for its type once and then runs it over the
+ * whole buffer, so the only indirect call is per scan rather than per element.
+ */
+
+#include "scan.h"
+#include "utils.h"
+#include <string.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define SCAN_SSE2 1
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SCAN_AVX2 1
+#define AVX2_FN static inline __attribute__((target("avx2")))
+#endif
+
+typedef struct {
+    size_t (*find)(const void *base, size_t count, const void *key);     // Index of the first match, or count
+    size_t (*count)(const void *base, size_t count, const void *key);    // Number of matches
+    void (*min)(const void *base, size_t count, void *out);              // Smallest of count >= 1 elements
+    void (*max)(const void *base, size_t count, void *out);              // Largest of count >= 1 elements
+} ScanKernels;
+
+// Defines the portable kernels for element type T
+#define DEFINE_SCALAR_KERNELS(SUFFIX, T)                                \
+static size_t find##SUFFIX(const void *base, size_t n, const void *k) { \
+    const T *a = base;                                                  \
+    T key;                                                              \
+    memcpy(&key, k, sizeof key);                                        \
+    for (size_t i = 0; i < n; i++) {                                    \
+        if (a[i] == key) return i;                                      \
+    }                                                                   \
+    return n;                                                           \
+}                                                                       \
+static size_t count##SUFFIX(const void *base, size_t n, const void *k) { \
+    const T *a = base;                                                  \
+    T key;                                                              \
+    memcpy(&key, k, sizeof key);                                        \
+    size_t c = 0;                                                       \
+    for (size_t i = 0; i < n; i++) c += a[i] == key;                    \
+    return c;                                                           \
+}                                                                       \
+static void min##SUFFIX(const void *base, size_t n, void *out) {        \
+    const T *a = base;                                                  \
+    T m = a[0];                                                         \
+    for (size_t i = 1; i < n; i++) m = a[i] < m ? a[i] : m;             \
+    memcpy(out, &m, sizeof m);                                          \
+}                                                                       \
+static void max##SUFFIX(const void *base, size_t n, void *out) {        \
+    const T *a = base;                                                  \
+    T m = a[0];                                                         \
+    for (size_t i = 1; i < n; i++) m = a[i] > m ? a[i] : m;             \
+    memcpy(out, &m, sizeof m);                                          \
+}
+
+DEFINE_SCALAR_KERNELS(Int8, int8_t)
+DEFINE_SCALAR_KERNELS(UInt8, uint8_t)
+DEFINE_SCALAR_KERNELS(Int16, int16_t)
+DEFINE_SCALAR_KERNELS(UInt16, uint16_t)
+DEFINE_SCALAR_KERNELS(Int32, int32_t)
+DEFINE_SCALAR_KERNELS(UInt32, uint32_t)
+DEFINE_SCALAR_KERNELS(Int64, int64_t)
+DEFINE_SCALAR_KERNELS(UInt64, uint64_t)
+DEFINE_SCALAR_KERNELS(Float, float)
+DEFINE_SCALAR_KERNELS(Double, double)
+
+static const ScanKernels scalarKernels[] = {
+    [ZZ_ELEM_INT8]   = { findInt8, countInt8, minInt8, maxInt8 },
+    [ZZ_ELEM_UINT8]  = { findUInt8, countUInt8, minUInt8, maxUInt8 },
+    [ZZ_ELEM_INT16]  = { findInt16, countInt16, minInt16, maxInt16 },
+    [ZZ_ELEM_UINT16] = { findUInt16, countUInt16, minUInt16, maxUInt16 },
+    [ZZ_ELEM_INT32]  = { findInt32, countInt32, minInt32, maxInt32 },
+    [ZZ_ELEM_UINT32] = { findUInt32, countUInt32, minUInt32, maxUInt32 },
+    [ZZ_ELEM_INT64]  = { findInt64, countInt64, minInt64, maxInt64 },
+    [ZZ_ELEM_UINT64] = { findUInt64, countUInt64, minUInt64, maxUInt64 },
+    [ZZ_ELEM_FLOAT]  = { findFloat, countFloat, minFloat, maxFloat },
+    [ZZ_ELEM_DOUBLE] = { findDouble, countDouble, minDouble, maxDouble },
+};
+
+// Defines vectorized find and count kernels. The find loop tests four vectors per step and
+// leaves the exact position within the block that matched to the scalar tail loop.
+#define DEFINE_SIMD_FIND_COUNT(SUFFIX, T, ATTR, VEC, LANES, SET1, LOAD, EQ, OR, MASK)    \
+ATTR size_t find##SUFFIX(const void *base, size_t n, const void *k) {                    \
+    const T *a = base;                                                                  \
+    T key;                                                                              \
+    memcpy(&key, k, sizeof key);                                                        \
+    const VEC kv = SET1(key);                                                           \
+    size_t i = 0;                                                                       \
+    for (; i + 4 * LANES <= n; i += 4 * LANES) {                                        \
+        VEC e = OR(OR(EQ(LOAD(a + i), kv), EQ(LOAD(a + i + LANES), kv)),                \
+                   OR(EQ(LOAD(a + i + 2 * LANES), kv), EQ(LOAD(a + i + 3 * LANES), kv))); \
+        if (MASK(e)) break;                                                             \
+    }                                                                                   \
+    for (; i < n; i++) {                                                                \
+        if (a[i] == key) return i;                                                      \
+    }                                                                                   \
+    return n;                                                                           \
+}                                                                                       \
+ATTR size_t count##SUFFIX(const void *base, size_t n, const void *k) {                   \
+    const T *a = base;                                                                  \
+    T key;                                                                              \
+    memcpy(&key, k, sizeof key);                                                        \
+    const VEC kv = SET1(key);                                                           \
+    size_t i = 0, c = 0;                                                                \
+    for (; i + LANES <= n; i += LANES) {                                                \
+        c += (size_t)__builtin_popcount((unsigned)MASK(EQ(LOAD(a + i), kv)));           \
+    }                                                                                   \
+    for (; i < n; i++) c += a[i] == key;                                                \
+    return c;                                                                           \
+}
+
+// Defines vectorized minimum and maximum kernels that reduce one vector of running
+// extremes and fold its lanes together at the end
+#define DEFINE_SIMD_MIN_MAX(SUFFIX, T, ATTR, VEC, LANES, LOAD, MIN, MAX, STORE)  \
+ATTR void min##SUFFIX(const void *base, size_t n, void *out) {                  \
+    const T *a = base;                                                          \
+    T m = a[0];                                                                 \
+    size_t i = 0;                                                               \
+    if (n >= LANES) {                                                           \
+        VEC v = LOAD(a);                                                        \
+        for (i = LANES; i + LANES <= n; i += LANES) v = MIN(v, LOAD(a + i));    \
+        T lanes[LANES];                                                         \
+        STORE(lanes, v);                                                        \
+        for (size_t j = 0; j < LANES; j++) m = lanes[j] < m ? lanes[j] : m;     \
+    }                                                                           \
+    for (; i < n; i++) m = a[i] < m ? a[i] : m;                                 \
+    memcpy(out, &m, sizeof m);                                                  \
+}                                                                               \
+ATTR void max##SUFFIX(const void *base, size_t n, void *out) {                  \
+    const T *a = base;                                                          \
+    T m = a[0];                                                                 \
+    size_t i = 0;                                                               \
+    if (n >= LANES) {                                                           \
+        VEC v = LOAD(a);                                                        \
+        for (i = LANES; i + LANES <= n; i += LANES) v = MAX(v, LOAD(a + i));    \
+        T lanes[LANES];                                                         \
+        STORE(lanes, v);                                                        \
+        for (size_t j = 0; j < LANES; j++) m = lanes[j] > m ? lanes[j] : m;     \
+    }                                                                           \
+    for (; i < n; i++) m = a[i] > m ? a[i] : m;                                 \
+    memcpy(out, &m, sizeof m);                                                  \
+}
+
+#ifdef SCAN_SSE2
+static inline __m128i sseLoad(const void *p) { return _mm_loadu_si128((const __m128i*)p); }
+static inline void sseStore(void *p, __m128i v) { _mm_storeu_si128((__m128i*)p, v); }
+static inline int sseMask32(__m128i v) { return _mm_movemask_ps(_mm_castsi128_ps(v)); }
+static inline int sseMask64(__m128i v) { return _mm_movemask_pd(_mm_castsi128_pd(v)); }
+
+// SSE2 has no 64-bit equality: both 32-bit halves of a lane have to match
+static inline __m128i sseEq64(__m128i a, __m128i b) {
+    __m128i e = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+// SSE2 has no 32-bit minimum and maximum, so they are blended from a comparison
+static inline __m128i sseMin32(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+static inline __m128i sseMax32(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+
+DEFINE_SIMD_FIND_COUNT(Int32Sse2, int32_t, static, __m128i, 4, _mm_set1_epi32, sseLoad, _mm_cmpeq_epi32, _mm_or_si128, sseMask32)
+DEFINE_SIMD_MIN_MAX(Int32Sse2, int32_t, static, __m128i, 4, sseLoad, sseMin32, sseMax32, sseStore)
+DEFINE_SIMD_FIND_COUNT(Int64Sse2, int64_t, static, __m128i, 2, _mm_set1_epi64x, sseLoad, sseEq64, _mm_or_si128, sseMask64)
+DEFINE_SIMD_FIND_COUNT(FloatSse2, float, static, __m128, 4, _mm_set1_ps, _mm_loadu_ps, _mm_cmpeq_ps, _mm_or_ps, _mm_movemask_ps)
+DEFINE_SIMD_MIN_MAX(FloatSse2, float, static, __m128, 4, _mm_loadu_ps, _mm_min_ps, _mm_max_ps, _mm_storeu_ps)
+DEFINE_SIMD_FIND_COUNT(DoubleSse2, double, static, __m128d, 2, _mm_set1_pd, _mm_loadu_pd, _mm_cmpeq_pd, _mm_or_pd, _mm_movemask_pd)
+DEFINE_SIMD_MIN_MAX(DoubleSse2, double, static, __m128d, 2, _mm_loadu_pd, _mm_min_pd, _mm_max_pd, _mm_storeu_pd)
+
+// 64-bit integer comparisons need SSE4.2, so the SSE2 set keeps the portable minimum and maximum
+static const ScanKernels sse2Int32 = { findInt32Sse2, countInt32Sse2, minInt32Sse2, maxInt32Sse2 };
+static const ScanKernels sse2Int64 = { findInt64Sse2, countInt64Sse2, minInt64, maxInt64 };
+static const ScanKernels sse2Float = { findFloatSse2, countFloatSse2, minFloatSse2, maxFloatSse2 };
+static const ScanKernels sse2Double = { findDoubleSse2, countDoubleSse2, minDoubleSse2, maxDoubleSse2 };
+#endif
+
+#ifdef SCAN_AVX2
+AVX2_FN __m256i avxLoad(const void *p) { return _mm256_loadu_si256((const __m256i*)p); }
+AVX2_FN void avxStore(void *p, __m256i v) { _mm256_storeu_si256((__m256i*)p, v); }
+AVX2_FN int avxMask32(__m256i v) { return _mm256_movemask_ps(_mm256_castsi256_ps(v)); }
+AVX2_FN int avxMask64(__m256i v) { return _mm256_movemask_pd(_mm256_castsi256_pd(v)); }
+AVX2_FN __m256i avxEq32(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+AVX2_FN __m256i avxEq64(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+AVX2_FN __m256i avxOr(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+AVX2_FN __m256i avxMin32(__m256i a, __m256i b) { return _mm256_min_epi32(a, b); }
+AVX2_FN __m256i avxMax32(__m256i a, __m256i b) { return _mm256_max_epi32(a, b); }
+AVX2_FN __m256i avxMin64(__m256i a, __m256i b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+AVX2_FN __m256i avxMax64(__m256i a, __m256i b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+AVX2_FN __m256i avxSet1Epi32(int32_t x) { return _mm256_set1_epi32(x); }
+AVX2_FN __m256i avxSet1Epi64(int64_t x) { return _mm256_set1_epi64x(x); }
+
+AVX2_FN __m256 avxLoadPs(const float *p) { return _mm256_loadu_ps(p); }
+AVX2_FN void avxStorePs(float *p, __m256 v) { _mm256_storeu_ps(p, v); }
+AVX2_FN __m256 avxSet1Ps(float x) { return _mm256_set1_ps(x); }
+AVX2_FN __m256 avxEqPs(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+AVX2_FN __m256 avxOrPs(__m256 a, __m256 b) { return _mm256_or_ps(a, b); }
+AVX2_FN int avxMaskPs(__m256 v) { return _mm256_movemask_ps(v); }
+AVX2_FN __m256 avxMinPs(__m256 a, __m256 b) { return _mm256_min_ps(a, b); }
+AVX2_FN __m256 avxMaxPs(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+
+AVX2_FN __m256d avxLoadPd(const double *p) { return _mm256_loadu_pd(p); }
+AVX2_FN void avxStorePd(double *p, __m256d v) { _mm256_storeu_pd(p, v); }
+AVX2_FN __m256d avxSet1Pd(double x) { return _mm256_set1_pd(x); }
+AVX2_FN __m256d avxEqPd(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+AVX2_FN __m256d avxOrPd(__m256d a, __m256d b) { return _mm256_or_pd(a, b); }
+AVX2_FN int avxMaskPd(__m256d v) { return _mm256_movemask_pd(v); }
+AVX2_FN __m256d avxMinPd(__m256d a, __m256d b) { return _mm256_min_pd(a, b); }
+AVX2_FN __m256d avxMaxPd(__m256d a, __m256d b) { return _mm256_max_pd(a, b); }
+
+DEFINE_SIMD_FIND_COUNT(Int32Avx2, int32_t, AVX2_FN, __m256i, 8, avxSet1Epi32, avxLoad, avxEq32, avxOr, avxMask32)
+DEFINE_SIMD_MIN_MAX(Int32Avx2, int32_t, AVX2_FN, __m256i, 8, avxLoad, avxMin32, avxMax32, avxStore)
+DEFINE_SIMD_FIND_COUNT(Int64Avx2, int64_t, AVX2_FN, __m256i, 4, avxSet1Epi64, avxLoad, avxEq64, avxOr, avxMask64)
+DEFINE_SIMD_MIN_MAX(Int64Avx2, int64_t, AVX2_FN, __m256i, 4, avxLoad, avxMin64, avxMax64, avxStore)
+DEFINE_SIMD_FIND_COUNT(FloatAvx2, float, AVX2_FN, __m256, 8, avxSet1Ps, avxLoadPs, avxEqPs, avxOrPs, avxMaskPs)
+DEFINE_SIMD_MIN_MAX(FloatAvx2, float, AVX2_FN, __m256, 8, avxLoadPs, avxMinPs, avxMaxPs, avxStorePs)
+DEFINE_SIMD_FIND_COUNT(DoubleAvx2, double, AVX2_FN, __m256d, 4, avxSet1Pd, avxLoadPd, avxEqPd, avxOrPd, avxMaskPd)
+DEFINE_SIMD_MIN_MAX(DoubleAvx2, double, AVX2_FN, __m256d, 4, avxLoadPd, avxMinPd, avxMaxPd, avxStorePd)
+
+static const ScanKernels avx2Int32 = { findInt32Avx2, countInt32Avx2, minInt32Avx2, maxInt32Avx2 };
+static const ScanKernels avx2Int64 = { findInt64Avx2, countInt64Avx2, minInt64Avx2, maxInt64Avx2 };
+static const ScanKernels avx2Float = { findFloatAvx2, countFloatAvx2, minFloatAvx2, maxFloatAvx2 };
+static const ScanKernels avx2Double = { findDoubleAvx2, countDoubleAvx2, minDoubleAvx2, maxDoubleAvx2 };
+#endif
+
+// Picks the fastest kernels for a type the running processor supports
+static const ScanKernels *selectKernels(zzElemType type) {
+#ifdef SCAN_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        switch (type) {
+            case ZZ_ELEM_INT32: return &avx2Int32;
+            case ZZ_ELEM_INT64: return &avx2Int64;
+            case ZZ_ELEM_FLOAT: return &avx2Float;
+            case ZZ_ELEM_DOUBLE: return &avx2Double;
+            default: break;
+        }
+    }
+#endif
+#ifdef SCAN_SSE2
+    switch (type) {
+        case ZZ_ELEM_INT32: return &sse2Int32;
+        case ZZ_ELEM_INT64: return &sse2Int64;
+        case ZZ_ELEM_FLOAT: return &sse2Float;
+        case ZZ_ELEM_DOUBLE: return &sse2Double;
+        default: break;
+    }
+#endif
+    return &scalarKernels[type];
+}
+
+// Size in bytes of an element of the given type, or 0 if the type is unknown
+static size_t typeSize(zzElemType type) {
+    switch (type) {
+        case ZZ_ELEM_INT8: case ZZ_ELEM_UINT8: return 1;
+        case ZZ_ELEM_INT16: case ZZ_ELEM_UINT16: return 2;
+        case ZZ_ELEM_INT32: case ZZ_ELEM_UINT32: return 4;
+        case ZZ_ELEM_INT64: case ZZ_ELEM_UINT64: return 8;
+        case ZZ_ELEM_FLOAT: return sizeof(float);
+        case ZZ_ELEM_DOUBLE: return sizeof(double);
+        default: return 0;
+    }
+}
+
+static zzOpResult checkBuffer(const void *base, size_t count, size_t elSize, zzElemType type) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    size_t size = typeSize(type);
+    if (size == 0) return ZZ_ERR("Unsupported element type");
+    if (elSize != size) return ZZ_ERR("Element size does not match element type");
+    return ZZ_OK();
+}
+
+/**
+ * @brief Finds the first element equal to the key in a buffer of a built-in type.
+ *
+ * Floating-point elements are compared with ==, so NaN never matches and -0.0
+ * matches +0.0.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index of the first matching element
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzFindTyped(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *indexOut) {
+    zzOpResult res = checkBuffer(base, count, elSize, type);
+    if (ZZ_IS_ERR(res)) return res;
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!indexOut) return ZZ_ERR("Index output pointer is NULL");
+
+    size_t idx = count > 0 ? selectKernels(type)->find(base, count, key) : 0;
+    if (idx == count) return ZZ_ERR("Element not found");
+    *indexOut = idx;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Counts the elements equal to the key in a buffer of a built-in type.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer and of the key
+ * @param[in] key Pointer to the key to count
+ * @param[out] countOut Pointer receiving the number of matching elements
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzCountTyped(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *countOut) {
+    zzOpResult res = checkBuffer(base, count, elSize, type);
+    if (ZZ_IS_ERR(res)) return res;
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!countOut) return ZZ_ERR("Count output pointer is NULL");
+
+    *countOut = count > 0 ? selectKernels(type)->count(base, count, key) : 0;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Finds the smallest element of a non-empty buffer of a built-in type.
+ *
+ * Floating-point buffers must not contain NaNs.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer
+ * @param[out] minOut Pointer to a buffer where the smallest element will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzMinTyped(const void *base, size_t count, size_t elSize, zzElemType type, void *minOut) {
+    zzOpResult res = checkBuffer(base, count, elSize, type);
+    if (ZZ_IS_ERR(res)) return res;
+    if (!minOut) return ZZ_ERR("Output buffer is NULL");
+    if (count == 0) return ZZ_ERR("Buffer is empty");
+
+    selectKernels(type)->min(base, count, minOut);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Finds the largest element of a non-empty buffer of a built-in type.
+ *
+ * Floating-point buffers must not contain NaNs.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer
+ * @param[out] maxOut Pointer to a buffer where the largest element will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzMaxTyped(const void *base, size_t count, size_t elSize, zzElemType type, void *maxOut) {
+    zzOpResult res = checkBuffer(base, count, elSize, type);
+    if (ZZ_IS_ERR(res)) return res;
+    if (!maxOut) return ZZ_ERR("Output buffer is NULL");
+    if (count == 0) return ZZ_ERR("Buffer is empty");
+
+    selectKernels(type)->max(base, count, maxOut);
+    return ZZ_OK();
+}
+
+// Element type of a signed integer of the given size
+static zzElemType signedType(size_t size) {
+    switch (size) {
+        case 1: return ZZ_ELEM_INT8;
+        case 2: return ZZ_ELEM_INT16;
+        case 4: return ZZ_ELEM_INT32;
+        default: return ZZ_ELEM_INT64;
+    }
+}
+
+/**
+ * @brief Reports the built-in element type whose equality matches an equality function.
+ *
+ * Containers use this to replace per-element calls to zzCharEquals, zzIntEquals,
+ * zzLongEquals, zzFloatEquals or zzDoubleEquals with the typed scan kernels.
+ *
+ * @param[in] equalsFn Equality function of the container
+ * @param[in] elSize Size in bytes of each element of the container
+ * @param[out] typeOut Pointer receiving the matching element type
+ * @return true if equalsFn is one of the built-in equality functions for elements of elSize bytes, false otherwise
+ */
+bool zzElemTypeForEquals(zzEqualsFn equalsFn, size_t elSize, zzElemType *typeOut) {
+    if (equalsFn == zzCharEquals && elSize == sizeof(char)) *typeOut = ZZ_ELEM_INT8;
+    else if (equalsFn == zzIntEquals && elSize == sizeof(int)) *typeOut = signedType(sizeof(int));
+    else if (equalsFn == zzLongEquals && elSize == sizeof(long)) *typeOut = signedType(sizeof(long));
+    else if (equalsFn == zzFloatEquals && elSize == sizeof(float)) *typeOut = ZZ_ELEM_FLOAT;
+    else if (equalsFn == zzDoubleEquals && elSize == sizeof(double)) *typeOut = ZZ_ELEM_DOUBLE;
+    else return false;
+    return true;
+}
+
+/**
+ * @brief Reports the built-in element type whose equality matches a comparison function returning 0.
+ *
+ * Only zzCharCompare, zzIntCompare and zzLongCompare qualify: the floating-point
+ * comparisons also return 0 for NaN, which typed equality does not.
+ *
+ * @param[in] cmp Comparison function used to match elements
+ * @param[in] elSize Size in bytes of each element
+ * @param[out] typeOut Pointer receiving the matching element type
+ * @return true if cmp is one of the built-in comparison functions for elements of elSize bytes, false otherwise
+ */
+bool zzElemTypeForCompare(zzCompareFn cmp, size_t elSize, zzElemType *typeOut) {
+    if (cmp == zzCharCompare && elSize == sizeof(char)) *typeOut = ZZ_ELEM_INT8;
+    else if (cmp == zzIntCompare && elSize == sizeof(int)) *typeOut = signedType(sizeof(int));
+    else if (cmp == zzLongCompare && elSize == sizeof(long)) *typeOut = signedType(sizeof(long));
+    else return false;
+    return true;
+}
\ No newline at end of file
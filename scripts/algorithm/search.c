@@ -0,0 +1,200 @@
+/**
+ * @file search.c
+ * @brief Implementation of binary search over sorted contiguous buffers.
+ *
+ * This module provides branchless binary searches: every step moves the base of
+ * the remaining range by either zero or half its length depending on one
+ * comparison, which compilers turn into a conditional move.
+ */
+
+#include "search.h"
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr) ((void)(addr))
+#endif
+
+// Number of leading elements for which cmp(elem, key) < bias: the lower bound with bias 0,
+// the upper bound with bias 1
+static size_t boundIndex(const unsigned char *base, size_t count, size_t es, const void *key, zzCompareFn cmp, int bias) {
+    if (count == 0) return 0;
+
+    const unsigned char *p = base;
+    size_t len = count;
+    while (len > 1) {
+        size_t half = len / 2;
+        p += cmp(p + half * es, key) < bias ? half * es : 0;
+        len -= half;
+    }
+    return (size_t)(p - base) / es + (cmp(p, key) < bias);
+}
+
+/**
+ * @brief Finds the first element that does not compare less than the key.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Function to compare an element with the key (returns negative if elem<key, 0 if equal, positive if elem>key)
+ * @param[out] indexOut Pointer receiving the index found, or count if every element is less than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLowerBound(const void *base, size_t count, size_t elSize, const void *key, zzCompareFn cmp, size_t *indexOut) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+    if (!indexOut) return ZZ_ERR("Index output pointer is NULL");
+
+    *indexOut = boundIndex(base, count, elSize, key, cmp, 0);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Finds the first element that compares greater than the key.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Function to compare an element with the key (returns negative if elem<key, 0 if equal, positive if elem>key)
+ * @param[out] indexOut Pointer receiving the index found, or count if no element is greater than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzUpperBound(const void *base, size_t count, size_t elSize, const void *key, zzCompareFn cmp, size_t *indexOut) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+    if (!indexOut) return ZZ_ERR("Index output pointer is NULL");
+
+    *indexOut = boundIndex(base, count, elSize, key, cmp, 1);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Finds the first element equal to the key.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Function to compare an element with the key (returns negative if elem<key, 0 if equal, positive if elem>key)
+ * @param[out] indexOut Pointer receiving the index of the first matching element
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzBinarySearch(const void *base, size_t count, size_t elSize, const void *key, zzCompareFn cmp, size_t *indexOut) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+    if (!indexOut) return ZZ_ERR("Index output pointer is NULL");
+
+    size_t idx = boundIndex(base, count, elSize, key, cmp, 0);
+    if (idx == count || cmp((const unsigned char*)base + idx * elSize, key) != 0) {
+        return ZZ_ERR("Element not found");
+    }
+    *indexOut = idx;
+    return ZZ_OK();
+}
+
+// Defines NAME, returning the number of leading elements x of a sorted T array with x OP key.
+// Both candidates for the next probe are prefetched while the current one is compared.
+#define DEFINE_TYPED_BOUND(NAME, T, OP)                                     \
+static size_t NAME(const void *base, size_t count, const void *keyPtr) {    \
+    const T *a = base;                                                      \
+    T key;                                                                  \
+    memcpy(&key, keyPtr, sizeof key);                                       \
+    if (count == 0) return 0;                                               \
+                                                                            \
+    const T *p = a;                                                         \
+    size_t len = count;                                                     \
+    while (len > 1) {                                                       \
+        size_t half = len / 2;                                              \
+        PREFETCH(p + half / 2);                                             \
+        PREFETCH(p + half + half / 2);                                      \
+        p += (p[half] OP key) ? half : 0;                                   \
+        len -= half;                                                        \
+    }                                                                       \
+    return (size_t)(p - a) + (*p OP key);                                   \
+}
+
+#define DEFINE_TYPED_BOUNDS(SUFFIX, T)              \
+    DEFINE_TYPED_BOUND(lowerBound##SUFFIX, T, <)    \
+    DEFINE_TYPED_BOUND(upperBound##SUFFIX, T, <=)
+
+DEFINE_TYPED_BOUNDS(Int8, int8_t)
+DEFINE_TYPED_BOUNDS(UInt8, uint8_t)
+DEFINE_TYPED_BOUNDS(Int16, int16_t)
+DEFINE_TYPED_BOUNDS(UInt16, uint16_t)
+DEFINE_TYPED_BOUNDS(Int32, int32_t)
+DEFINE_TYPED_BOUNDS(UInt32, uint32_t)
+DEFINE_TYPED_BOUNDS(Int64, int64_t)
+DEFINE_TYPED_BOUNDS(UInt64, uint64_t)
+DEFINE_TYPED_BOUNDS(Float, float)
+DEFINE_TYPED_BOUNDS(Double, double)
+
+#define TYPED_BOUND_CASE(TYPE, SUFFIX, T)                                                       \
+    case TYPE:                                                                                  \
+        if (elSize != sizeof(T)) return ZZ_ERR("Element size does not match element type");    \
+        *indexOut = upper ? upperBound##SUFFIX(base, count, key) : lowerBound##SUFFIX(base, count, key); \
+        return ZZ_OK();
+
+static zzOpResult typedBound(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *indexOut, bool upper) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!indexOut) return ZZ_ERR("Index output pointer is NULL");
+
+    switch (type) {
+        TYPED_BOUND_CASE(ZZ_ELEM_INT8, Int8, int8_t)
+        TYPED_BOUND_CASE(ZZ_ELEM_UINT8, UInt8, uint8_t)
+        TYPED_BOUND_CASE(ZZ_ELEM_INT16, Int16, int16_t)
+        TYPED_BOUND_CASE(ZZ_ELEM_UINT16, UInt16, uint16_t)
+        TYPED_BOUND_CASE(ZZ_ELEM_INT32, Int32, int32_t)
+        TYPED_BOUND_CASE(ZZ_ELEM_UINT32, UInt32, uint32_t)
+        TYPED_BOUND_CASE(ZZ_ELEM_INT64, Int64, int64_t)
+        TYPED_BOUND_CASE(ZZ_ELEM_UINT64, UInt64, uint64_t)
+        TYPED_BOUND_CASE(ZZ_ELEM_FLOAT, Float, float)
+        TYPED_BOUND_CASE(ZZ_ELEM_DOUBLE, Double, double)
+        default: return ZZ_ERR("Unsupported element type");
+    }
+}
+
+/**
+ * @brief Finds the first element not less than the key in a sorted buffer of a built-in type.
+ *
+ * This function compares elements directly as the given type without calling a
+ * comparison function. Floating-point buffers must not contain NaNs.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index found, or count if every element is less than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLowerBoundTyped(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *indexOut) {
+    return typedBound(base, count, elSize, type, key, indexOut, false);
+}
+
+/**
+ * @brief Finds the first element greater than the key in a sorted buffer of a built-in type.
+ *
+ * This function compares elements directly as the given type without calling a
+ * comparison function. Floating-point buffers must not contain NaNs.
+ *
+ * @param[in] base Pointer to the first element of a buffer sorted in ascending order
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index found, or count if no element is greater than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzUpperBoundTyped(const void *base, size_t count, size_t elSize, zzElemType type, const void *key, size_t *indexOut) {
+    return typedBound(base, count, elSize, type, key, indexOut, true);
+}
\ No newline at end of file
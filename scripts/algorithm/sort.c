@@ -0,0 +1,742 @@
+/**
+ * @file sort.c
+ * @brief Implementation of the sorting algorithms for contiguous buffers.
+ *
+ * This module provides the implementation of pattern-defeating quicksort
+ * (after Orson Peters' pdqsort), a stable merge sort, introselect-based
+ * selection and an LSD radix sort for the built-in numeric types.
+ */
+
+#include "sort.h"
+#include <string.h>
+#include <stdlib.h>
+
+// Ranges shorter than this are finished with insertion sort
+#define INSERTION_SORT_THRESHOLD 24
+
+// Ranges longer than this pick their pivot as the median of three medians of three
+#define NINTHER_THRESHOLD 128
+
+// Partial insertion sort gives up once it has moved this many elements
+#define PARTIAL_INSERTION_SORT_LIMIT 8
+
+// Merge sort sorts runs up to this length with insertion sort before merging
+#define MERGE_RUN_LENGTH 32
+
+// Elements up to this size use a temporary on the stack
+#define STACK_ELEM_SIZE 64
+
+typedef struct {
+    size_t es;              // Element size in bytes
+    zzCompareFn cmp;        // Element comparison function
+    bool descending;        // Whether the order of cmp is reversed
+    unsigned char *tmp;     // Scratch space for one element
+} SortCtx;
+
+static inline void copyElem(void *dst, const void *src, size_t es) {
+    switch (es) {
+        case 4: memcpy(dst, src, 4); break;
+        case 8: memcpy(dst, src, 8); break;
+        case 16: memcpy(dst, src, 16); break;
+        default: memcpy(dst, src, es); break;
+    }
+}
+
+static inline void swapElems(unsigned char *a, unsigned char *b, size_t es) {
+    switch (es) {
+        case 4: {
+            uint32_t t;
+            memcpy(&t, a, 4); memcpy(a, b, 4); memcpy(b, &t, 4);
+            return;
+        }
+        case 8: {
+            uint64_t t;
+            memcpy(&t, a, 8); memcpy(a, b, 8); memcpy(b, &t, 8);
+            return;
+        }
+        case 16: {
+            uint64_t t[2];
+            memcpy(t, a, 16); memcpy(a, b, 16); memcpy(b, t, 16);
+            return;
+        }
+        default: {
+            unsigned char t[STACK_ELEM_SIZE];
+            while (es > sizeof t) {
+                memcpy(t, a, sizeof t); memcpy(a, b, sizeof t); memcpy(b, t, sizeof t);
+                a += sizeof t;
+                b += sizeof t;
+                es -= sizeof t;
+            }
+            memcpy(t, a, es); memcpy(a, b, es); memcpy(b, t, es);
+            return;
+        }
+    }
+}
+
+static inline bool less(const SortCtx *c, const void *a, const void *b) {
+    int r = c->cmp(a, b);
+    return c->descending ? r > 0 : r < 0;
+}
+
+// Prepares a context, using stackTmp as the element scratch space when the element fits
+static zzOpResult ctxInit(SortCtx *c, size_t es, zzCompareFn cmp, bool descending, unsigned char *stackTmp) {
+    c->es = es;
+    c->cmp = cmp;
+    c->descending = descending;
+    c->tmp = stackTmp;
+    if (es > STACK_ELEM_SIZE) {
+        c->tmp = malloc(es);
+        if (!c->tmp) return ZZ_ERR("Memory allocation failed");
+    }
+    return ZZ_OK();
+}
+
+static void ctxRelease(SortCtx *c, unsigned char *stackTmp) {
+    if (c->tmp != stackTmp) free(c->tmp);
+}
+
+// Insertion sort of [begin, end), stable since elements only move past strictly greater ones
+static void insertionSort(const SortCtx *c, unsigned char *begin, unsigned char *end) {
+    size_t es = c->es;
+    if (begin == end) return;
+
+    for (unsigned char *cur = begin + es; cur < end; cur += es) {
+        if (!less(c, cur, cur - es)) continue;
+
+        unsigned char *sift = cur;
+        copyElem(c->tmp, cur, es);
+        do {
+            copyElem(sift, sift - es, es);
+            sift -= es;
+        } while (sift != begin && less(c, c->tmp, sift - es));
+        copyElem(sift, c->tmp, es);
+    }
+}
+
+// Insertion sort of [begin, end) where the element before begin is not greater than any in the range
+static void unguardedInsertionSort(const SortCtx *c, unsigned char *begin, unsigned char *end) {
+    size_t es = c->es;
+    if (begin == end) return;
+
+    for (unsigned char *cur = begin + es; cur < end; cur += es) {
+        if (!less(c, cur, cur - es)) continue;
+
+        unsigned char *sift = cur;
+        copyElem(c->tmp, cur, es);
+        do {
+            copyElem(sift, sift - es, es);
+            sift -= es;
+        } while (less(c, c->tmp, sift - es));
+        copyElem(sift, c->tmp, es);
+    }
+}
+
+// Insertion sort that gives up after a few moves; returns whether the range got sorted
+static bool partialInsertionSort(const SortCtx *c, unsigned char *begin, unsigned char *end) {
+    size_t es = c->es;
+    size_t moved = 0;
+    if (begin == end) return true;
+
+    for (unsigned char *cur = begin + es; cur < end; cur += es) {
+        if (moved > PARTIAL_INSERTION_SORT_LIMIT) return false;
+        if (!less(c, cur, cur - es)) continue;
+
+        unsigned char *sift = cur;
+        copyElem(c->tmp, cur, es);
+        do {
+            copyElem(sift, sift - es, es);
+            sift -= es;
+        } while (sift != begin && less(c, c->tmp, sift - es));
+        copyElem(sift, c->tmp, es);
+        moved += (size_t)(cur - sift) / es;
+    }
+    return true;
+}
+
+static inline void sort2(const SortCtx *c, unsigned char *a, unsigned char *b) {
+    if (less(c, b, a)) swapElems(a, b, c->es);
+}
+
+static inline void sort3(const SortCtx *c, unsigned char *a, unsigned char *b, unsigned char *d) {
+    sort2(c, a, b);
+    sort2(c, b, d);
+    sort2(c, a, b);
+}
+
+static void siftDown(const SortCtx *c, unsigned char *base, size_t root, size_t n) {
+    size_t es = c->es;
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= n) return;
+        if (child + 1 < n && less(c, base + child * es, base + (child + 1) * es)) child++;
+        if (!less(c, base + root * es, base + child * es)) return;
+        swapElems(base + root * es, base + child * es, es);
+        root = child;
+    }
+}
+
+static void heapSort(const SortCtx *c, unsigned char *begin, unsigned char *end) {
+    size_t es = c->es;
+    size_t n = (size_t)(end - begin) / es;
+
+    for (size_t i = n / 2; i-- > 0;) siftDown(c, begin, i, n);
+    for (size_t i = n; i-- > 1;) {
+        swapElems(begin, begin + i * es, es);
+        siftDown(c, begin, 0, i);
+    }
+}
+
+// Partitions [begin, end) around the pivot at begin into elements less than the pivot and
+// elements not less than it. Returns the final pivot position and reports whether no
+// elements had to be swapped.
+static unsigned char *partitionRight(const SortCtx *c, unsigned char *begin, unsigned char *end, bool *alreadyPartitioned) {
+    size_t es = c->es;
+    unsigned char *pivot = c->tmp;
+    unsigned char *first = begin;
+    unsigned char *last = end;
+    copyElem(pivot, begin, es);
+
+    // The median-of-three selection guarantees an element not less than the pivot exists
+    do first += es; while (less(c, first, pivot));
+
+    // If no element was less than the pivot the search from the right has to be guarded
+    if (first - es == begin) {
+        while (first < last) {
+            last -= es;
+            if (less(c, last, pivot)) break;
+        }
+    } else {
+        do last -= es; while (!less(c, last, pivot));
+    }
+
+    *alreadyPartitioned = first >= last;
+
+    while (first < last) {
+        swapElems(first, last, es);
+        do first += es; while (less(c, first, pivot));
+        do last -= es; while (!less(c, last, pivot));
+    }
+
+    unsigned char *pivotPos = first - es;
+    copyElem(begin, pivotPos, es);
+    copyElem(pivotPos, pivot, es);
+    return pivotPos;
+}
+
+// Partitions [begin, end) around the pivot at begin into elements equal to the pivot and
+// elements greater than it. Used when the pivot equals the element before the range, so
+// the whole left part is a run of equal keys that needs no further sorting.
+static unsigned char *partitionLeft(const SortCtx *c, unsigned char *begin, unsigned char *end) {
+    size_t es = c->es;
+    unsigned char *pivot = c->tmp;
+    unsigned char *first = begin;
+    unsigned char *last = end;
+    copyElem(pivot, begin, es);
+
+    do last -= es; while (less(c, pivot, last));
+
+    if (last + es == end) {
+        while (first < last) {
+            first += es;
+            if (less(c, pivot, first)) break;
+        }
+    } else {
+        do first += es; while (!less(c, pivot, first));
+    }
+
+    while (first < last) {
+        swapElems(first, last, es);
+        do last -= es; while (less(c, pivot, last));
+        do first += es; while (!less(c, pivot, first));
+    }
+
+    copyElem(begin, last, es);
+    copyElem(last, pivot, es);
+    return last;
+}
+
+// Moves the median of three (or of three medians of three) of [begin, end) to begin as the pivot
+static void choosePivot(const SortCtx *c, unsigned char *begin, unsigned char *end, size_t size) {
+    size_t es = c->es;
+    size_t half = size / 2;
+    if (size > NINTHER_THRESHOLD) {
+        sort3(c, begin, begin + half * es, end - es);
+        sort3(c, begin + es, begin + (half - 1) * es, end - 2 * es);
+        sort3(c, begin + 2 * es, begin + (half + 1) * es, end - 3 * es);
+        sort3(c, begin + (half - 1) * es, begin + half * es, begin + (half + 1) * es);
+        swapElems(begin, begin + half * es, es);
+    } else {
+        sort3(c, begin + half * es, begin, end - es);
+    }
+}
+
+static void pdqSortLoop(const SortCtx *c, unsigned char *begin, unsigned char *end, int badAllowed, bool leftmost) {
+    size_t es = c->es;
+
+    for (;;) {
+        size_t size = (size_t)(end - begin) / es;
+        if (size < INSERTION_SORT_THRESHOLD) {
+            if (leftmost) insertionSort(c, begin, end);
+            else unguardedInsertionSort(c, begin, end);
+            return;
+        }
+
+        choosePivot(c, begin, end, size);
+
+        // A pivot equal to the element before the range means the equal keys can be split off
+        if (!leftmost && !less(c, begin - es, begin)) {
+            begin = partitionLeft(c, begin, end) + es;
+            continue;
+        }
+
+        bool alreadyPartitioned;
+        unsigned char *pivotPos = partitionRight(c, begin, end, &alreadyPartitioned);
+        size_t leftSize = (size_t)(pivotPos - begin) / es;
+        size_t rightSize = (size_t)(end - (pivotPos + es)) / es;
+
+        if (leftSize < size / 8 || rightSize < size / 8) {
+            // Too many bad partitions: switch to heapsort to keep O(n log n)
+            if (--badAllowed == 0) {
+                heapSort(c, begin, end);
+                return;
+            }
+
+            // Shuffle a few elements to break the pattern that caused the bad partition
+            if (leftSize >= INSERTION_SORT_THRESHOLD) {
+                size_t q = leftSize / 4;
+                swapElems(begin, begin + q * es, es);
+                swapElems(pivotPos - es, pivotPos - q * es, es);
+                if (leftSize > NINTHER_THRESHOLD) {
+                    swapElems(begin + es, begin + (q + 1) * es, es);
+                    swapElems(begin + 2 * es, begin + (q + 2) * es, es);
+                    swapElems(pivotPos - 2 * es, pivotPos - (q + 1) * es, es);
+                    swapElems(pivotPos - 3 * es, pivotPos - (q + 2) * es, es);
+                }
+            }
+            if (rightSize >= INSERTION_SORT_THRESHOLD) {
+                size_t q = rightSize / 4;
+                swapElems(pivotPos + es, pivotPos + (1 + q) * es, es);
+                swapElems(end - es, end - q * es, es);
+                if (rightSize > NINTHER_THRESHOLD) {
+                    swapElems(pivotPos + 2 * es, pivotPos + (2 + q) * es, es);
+                    swapElems(pivotPos + 3 * es, pivotPos + (3 + q) * es, es);
+                    swapElems(end - 2 * es, end - (1 + q) * es, es);
+                    swapElems(end - 3 * es, end - (2 + q) * es, es);
+                }
+            }
+        } else if (alreadyPartitioned
+                   && partialInsertionSort(c, begin, pivotPos)
+                   && partialInsertionSort(c, pivotPos + es, end)) {
+            // A balanced partition that moved nothing suggests the input is (nearly) sorted
+            return;
+        }
+
+        // Recurse into the left part and loop on the right one
+        pdqSortLoop(c, begin, pivotPos, badAllowed, leftmost);
+        begin = pivotPos + es;
+        leftmost = false;
+    }
+}
+
+static int floorLog2(size_t n) {
+    int log = 0;
+    while (n >>= 1) log++;
+    return log;
+}
+
+/**
+ * @brief Sorts a buffer in ascending order using pattern-defeating quicksort.
+ *
+ * This function sorts the buffer in place. The sort is not stable: elements that
+ * compare equal may end up in any order. It runs in O(n log n) time in the worst
+ * case, falling back to heapsort when partitioning keeps going badly, and uses
+ * O(log n) stack space. Elements larger than 64 bytes need a temporary buffer
+ * of one element, which is the only allocation.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer to sort
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzSort(void *base, size_t count, size_t elSize, zzCompareFn cmp) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+    if (count < 2) return ZZ_OK();
+
+    _Alignas(max_align_t) unsigned char stackTmp[STACK_ELEM_SIZE];
+    SortCtx c;
+    zzOpResult res = ctxInit(&c, elSize, cmp, false, stackTmp);
+    if (ZZ_IS_ERR(res)) return res;
+
+    unsigned char *begin = base;
+    pdqSortLoop(&c, begin, begin + count * elSize, floorLog2(count), true);
+
+    ctxRelease(&c, stackTmp);
+    return ZZ_OK();
+}
+
+// Merges the sorted runs [begin, mid) and [mid, end), moving the left run through buf
+static void mergeRuns(const SortCtx *c, unsigned char *begin, unsigned char *mid, unsigned char *end, unsigned char *buf) {
+    size_t es = c->es;
+
+    // Runs that are already in order need no merge
+    if (!less(c, mid, mid - es)) return;
+
+    // Elements of the left run not greater than the first of the right run stay in place
+    while (!less(c, mid, begin)) begin += es;
+
+    size_t leftBytes = (size_t)(mid - begin);
+    memcpy(buf, begin, leftBytes);
+
+    unsigned char *left = buf, *leftEnd = buf + leftBytes;
+    unsigned char *right = mid, *out = begin;
+    while (left < leftEnd && right < end) {
+        // Taking from the left on ties keeps the merge stable
+        if (less(c, right, left)) {
+            copyElem(out, right, es);
+            right += es;
+        } else {
+            copyElem(out, left, es);
+            left += es;
+        }
+        out += es;
+    }
+    memcpy(out, left, (size_t)(leftEnd - left));
+}
+
+static void mergeSort(const SortCtx *c, unsigned char *begin, unsigned char *end, unsigned char *buf) {
+    size_t es = c->es;
+    size_t n = (size_t)(end - begin) / es;
+    if (n <= MERGE_RUN_LENGTH) {
+        insertionSort(c, begin, end);
+        return;
+    }
+
+    unsigned char *mid = begin + (n / 2) * es;
+    mergeSort(c, begin, mid, buf);
+    mergeSort(c, mid, end, buf);
+    mergeRuns(c, begin, mid, end, buf);
+}
+
+/**
+ * @brief Sorts a buffer in ascending order, keeping equal elements in their original order.
+ *
+ * This function sorts the buffer in place with a merge sort that uses insertion
+ * sort for short runs and skips merges of runs that are already in order. It
+ * runs in O(n log n) time and allocates a temporary buffer of count / 2 elements.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer to sort
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzStableSort(void *base, size_t count, size_t elSize, zzCompareFn cmp) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+    if (count < 2) return ZZ_OK();
+
+    _Alignas(max_align_t) unsigned char stackTmp[STACK_ELEM_SIZE];
+    SortCtx c;
+    zzOpResult res = ctxInit(&c, elSize, cmp, false, stackTmp);
+    if (ZZ_IS_ERR(res)) return res;
+
+    unsigned char *begin = base;
+    unsigned char *end = begin + count * elSize;
+    unsigned char *buf = NULL;
+    if (count > MERGE_RUN_LENGTH) {
+        buf = malloc((count / 2) * elSize);
+        if (!buf) {
+            ctxRelease(&c, stackTmp);
+            return ZZ_ERR("Memory allocation failed");
+        }
+    }
+
+    mergeSort(&c, begin, end, buf);
+
+    free(buf);
+    ctxRelease(&c, stackTmp);
+    return ZZ_OK();
+}
+
+// Introselect: partitions like pdqSortLoop but only continues into the part holding nth
+static void selectLoop(const SortCtx *c, unsigned char *begin, unsigned char *nth, unsigned char *end) {
+    size_t es = c->es;
+    int badAllowed = 2 * floorLog2((size_t)(end - begin) / es);
+    bool leftmost = true;
+
+    for (;;) {
+        size_t size = (size_t)(end - begin) / es;
+        if (size < INSERTION_SORT_THRESHOLD) {
+            if (leftmost) insertionSort(c, begin, end);
+            else unguardedInsertionSort(c, begin, end);
+            return;
+        }
+        if (badAllowed-- == 0) {
+            heapSort(c, begin, end);
+            return;
+        }
+
+        choosePivot(c, begin, end, size);
+
+        // Elements equal to the one before the range are all in their final place
+        if (!leftmost && !less(c, begin - es, begin)) {
+            unsigned char *last = partitionLeft(c, begin, end);
+            if (nth <= last) return;
+            begin = last + es;
+            continue;
+        }
+
+        bool alreadyPartitioned;
+        unsigned char *pivotPos = partitionRight(c, begin, end, &alreadyPartitioned);
+        if (pivotPos == nth) return;
+        if (nth < pivotPos) {
+            end = pivotPos;
+        } else {
+            begin = pivotPos + es;
+            leftmost = false;
+        }
+    }
+}
+
+/**
+ * @brief Rearranges a buffer so that the element at index nth is the one a full sort would put there.
+ *
+ * This function partially orders the buffer in place with introselect: after it
+ * returns, no element before nth compares greater than it and no element after
+ * nth compares less than it. It runs in O(n) expected time and falls back to
+ * heapsort of the remaining range if partitioning keeps going badly.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] nth Index of the element to put in its sorted position (must be less than count)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzNthElement(void *base, size_t count, size_t elSize, zzCompareFn cmp, size_t nth) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+    if (nth >= count) return ZZ_ERR("Index out of bounds");
+
+    _Alignas(max_align_t) unsigned char stackTmp[STACK_ELEM_SIZE];
+    SortCtx c;
+    zzOpResult res = ctxInit(&c, elSize, cmp, false, stackTmp);
+    if (ZZ_IS_ERR(res)) return res;
+
+    unsigned char *begin = base;
+    selectLoop(&c, begin, begin + nth * elSize, begin + count * elSize);
+
+    ctxRelease(&c, stackTmp);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Sorts the k smallest elements of a buffer into its first k positions.
+ *
+ * This function selects the k smallest elements with introselect and sorts only
+ * those, in O(n + k log k) expected time. The order of the remaining elements is
+ * unspecified. A k of count or more sorts the whole buffer.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] k Number of leading elements to sort
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPartialSort(void *base, size_t count, size_t elSize, zzCompareFn cmp, size_t k) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+    if (k > count) k = count;
+    if (k == 0) return ZZ_OK();
+
+    _Alignas(max_align_t) unsigned char stackTmp[STACK_ELEM_SIZE];
+    SortCtx c;
+    zzOpResult res = ctxInit(&c, elSize, cmp, false, stackTmp);
+    if (ZZ_IS_ERR(res)) return res;
+
+    unsigned char *begin = base;
+    if (k < count) selectLoop(&c, begin, begin + (k - 1) * elSize, begin + count * elSize);
+    pdqSortLoop(&c, begin, begin + k * elSize, floorLog2(k), true);
+
+    ctxRelease(&c, stackTmp);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Copies the k smallest or largest elements of a buffer, best first, without modifying it.
+ *
+ * This function streams over the buffer keeping candidates in a scratch buffer of
+ * 2k elements. Whenever the scratch buffer fills up the best k are selected and
+ * become the bar every later element must beat, so most elements cost a single
+ * comparison. It runs in O(n + k log k) expected time. The result is written in
+ * ascending order for the smallest elements and in descending order for the
+ * largest; when count is less than k all count elements are written.
+ *
+ * @param[in] base Pointer to the first element of the buffer
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element
+ * @param[in] cmp Function to compare elements (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] k Number of elements to return
+ * @param[in] largest Whether to return the largest elements instead of the smallest
+ * @param[out] out Pointer to a buffer with room for k elements receiving the result
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTopK(const void *base, size_t count, size_t elSize, zzCompareFn cmp, size_t k, bool largest, void *out) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (!cmp) return ZZ_ERR("Comparison function is NULL");
+    if (!out && k > 0) return ZZ_ERR("Output buffer is NULL");
+
+    size_t m = k < count ? k : count;
+    if (m == 0) return ZZ_OK();
+
+    _Alignas(max_align_t) unsigned char stackTmp[STACK_ELEM_SIZE];
+    SortCtx c;
+    zzOpResult res = ctxInit(&c, elSize, cmp, largest, stackTmp);
+    if (ZZ_IS_ERR(res)) return res;
+
+    size_t cap = count / 2 < m ? count : 2 * m;
+    unsigned char *buf = malloc(cap * elSize);
+    if (!buf) {
+        ctxRelease(&c, stackTmp);
+        return ZZ_ERR("Memory allocation failed");
+    }
+
+    // Once the buffer has been trimmed, buf[m - 1] is the worst of the best m seen so far
+    const unsigned char *src = base;
+    unsigned char *bar = buf + (m - 1) * elSize;
+    size_t fill = 0;
+    bool trimmed = false;
+    for (size_t i = 0; i < count; i++) {
+        const unsigned char *elem = src + i * elSize;
+        if (trimmed && !less(&c, elem, bar)) continue;
+
+        copyElem(buf + fill * elSize, elem, elSize);
+        if (++fill == cap && i + 1 < count) {
+            selectLoop(&c, buf, bar, buf + fill * elSize);
+            fill = m;
+            trimmed = true;
+        }
+    }
+
+    selectLoop(&c, buf, bar, buf + fill * elSize);
+    pdqSortLoop(&c, buf, buf + m * elSize, floorLog2(m), true);
+    memcpy(out, buf, m * elSize);
+
+    free(buf);
+    ctxRelease(&c, stackTmp);
+    return ZZ_OK();
+}
+
+// How radix sort maps the bits of an element to an unsigned key with the same order
+typedef enum { KEY_UNSIGNED, KEY_SIGNED, KEY_FLOAT } KeyKind;
+
+// Defines radixSortN for unsigned type UT of BYTES bytes. Keys are first made order-preserving
+// in place (flipping the sign bit of integers, and all bits of negative floats), then scattered
+// one byte at a time between the buffer and the scratch space, and finally mapped back.
+#define DEFINE_RADIX_SORT(NAME, UT, BYTES)                                                      \
+static void NAME(unsigned char *base, unsigned char *scratch, size_t n, KeyKind kind) {         \
+    const UT top = (UT)((UT)1 << (BYTES * 8 - 1));                                              \
+    size_t counts[BYTES][256];                                                                  \
+    memset(counts, 0, sizeof counts);                                                           \
+                                                                                                \
+    for (size_t i = 0; i < n; i++) {                                                            \
+        UT x;                                                                                   \
+        memcpy(&x, base + i * BYTES, BYTES);                                                    \
+        if (kind == KEY_SIGNED) x ^= top;                                                       \
+        else if (kind == KEY_FLOAT) x = (x & top) ? (UT)~x : (UT)(x ^ top);                     \
+        memcpy(base + i * BYTES, &x, BYTES);                                                    \
+        for (int d = 0; d < BYTES; d++) counts[d][(x >> (d * 8)) & 0xFF]++;                     \
+    }                                                                                           \
+                                                                                                \
+    unsigned char *src = base, *dst = scratch;                                                  \
+    for (int d = 0; d < BYTES; d++) {                                                           \
+        UT first;                                                                               \
+        memcpy(&first, src, BYTES);                                                             \
+        if (counts[d][(first >> (d * 8)) & 0xFF] == n) continue;                                \
+                                                                                                \
+        size_t offsets[256], sum = 0;                                                           \
+        for (int b = 0; b < 256; b++) {                                                         \
+            offsets[b] = sum;                                                                   \
+            sum += counts[d][b];                                                                \
+        }                                                                                       \
+        for (size_t i = 0; i < n; i++) {                                                        \
+            UT x;                                                                               \
+            memcpy(&x, src + i * BYTES, BYTES);                                                 \
+            memcpy(dst + offsets[(x >> (d * 8)) & 0xFF]++ * BYTES, &x, BYTES);                  \
+        }                                                                                       \
+        unsigned char *t = src; src = dst; dst = t;                                             \
+    }                                                                                           \
+    if (src != base) memcpy(base, src, n * BYTES);                                              \
+                                                                                                \
+    if (kind == KEY_UNSIGNED) return;                                                           \
+    for (size_t i = 0; i < n; i++) {                                                            \
+        UT x;                                                                                   \
+        memcpy(&x, base + i * BYTES, BYTES);                                                    \
+        if (kind == KEY_SIGNED) x ^= top;                                                       \
+        else x = (x & top) ? (UT)(x ^ top) : (UT)~x;                                            \
+        memcpy(base + i * BYTES, &x, BYTES);                                                    \
+    }                                                                                           \
+}
+
+DEFINE_RADIX_SORT(radixSort8, uint8_t, 1)
+DEFINE_RADIX_SORT(radixSort16, uint16_t, 2)
+DEFINE_RADIX_SORT(radixSort32, uint32_t, 4)
+DEFINE_RADIX_SORT(radixSort64, uint64_t, 8)
+
+/**
+ * @brief Sorts a buffer of built-in numeric elements in ascending order using LSD radix sort.
+ *
+ * This function sorts by the binary representation of the elements, one byte per
+ * pass, skipping bytes that are equal in every element. It runs in O(n) time per
+ * byte of the element type, is stable, and allocates a temporary buffer of count
+ * elements. Floating-point values are ordered by their sign, exponent and
+ * mantissa, so -0.0 sorts before +0.0 and NaNs sort to the ends by their sign bit.
+ *
+ * @param[in,out] base Pointer to the first element of the buffer to sort
+ * @param[in] count Number of elements in the buffer
+ * @param[in] elSize Size in bytes of each element (must match the size of type)
+ * @param[in] type Type of the elements stored in the buffer
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixSort(void *base, size_t count, size_t elSize, zzElemType type) {
+    if (!base && count > 0) return ZZ_ERR("Buffer pointer is NULL");
+
+    size_t typeSize;
+    KeyKind kind;
+    switch (type) {
+        case ZZ_ELEM_INT8:   typeSize = 1; kind = KEY_SIGNED; break;
+        case ZZ_ELEM_UINT8:  typeSize = 1; kind = KEY_UNSIGNED; break;
+        case ZZ_ELEM_INT16:  typeSize = 2; kind = KEY_SIGNED; break;
+        case ZZ_ELEM_UINT16: typeSize = 2; kind = KEY_UNSIGNED; break;
+        case ZZ_ELEM_INT32:  typeSize = 4; kind = KEY_SIGNED; break;
+        case ZZ_ELEM_UINT32: typeSize = 4; kind = KEY_UNSIGNED; break;
+        case ZZ_ELEM_INT64:  typeSize = 8; kind = KEY_SIGNED; break;
+        case ZZ_ELEM_UINT64: typeSize = 8; kind = KEY_UNSIGNED; break;
+        case ZZ_ELEM_FLOAT:  typeSize = sizeof(float); kind = KEY_FLOAT; break;
+        case ZZ_ELEM_DOUBLE: typeSize = sizeof(double); kind = KEY_FLOAT; break;
+        default: return ZZ_ERR("Unsupported element type");
+    }
+    if (elSize != typeSize) return ZZ_ERR("Element size does not match element type");
+    if (count < 2) return ZZ_OK();
+
+    unsigned char *scratch = malloc(count * elSize);
+    if (!scratch) return ZZ_ERR("Memory allocation failed");
+
+    switch (typeSize) {
+        case 1: radixSort8(base, scratch, count, kind); break;
+        case 2: radixSort16(base, scratch, count, kind); break;
+        case 4: radixSort32(base, scratch, count, kind); break;
+        default: radixSort64(base, scratch, count, kind); break;
+    }
+
+    free(scratch);
+    return ZZ_OK();
+}
\ No newline at end of file
@@ -0,0 +1,557 @@
+#include "concurrentSkipListMap.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define MARK ((uintptr_t)1)
+#define IS_MARKED(link) (((link) & MARK) != 0)
+#define UNMARKED(link) ((SkipListNode*)((link) & ~MARK))
+#define KEY_PTR(node) ((unsigned char*)((node)->next + (node)->height))
+
+// Entries retired between two attempts to advance the epoch
+#define RETIRES_PER_ADVANCE 64
+
+static atomic_size_t nextStripe;
+static _Thread_local size_t threadStripe = SIZE_MAX;
+static _Thread_local uint32_t threadSeed;
+
+// Returns the epoch stripe of the calling thread, assigning stripes round-robin on first use
+static size_t currentStripe(void) {
+    if (threadStripe == SIZE_MAX) {
+        threadStripe = atomic_fetch_add_explicit(&nextStripe, 1, memory_order_relaxed) % ZZ_SKIPLIST_EPOCH_STRIPES;
+        threadSeed = (uint32_t)(((uintptr_t)&threadSeed >> 4) ^ (threadStripe * 2654435761u)) | 1;
+    }
+    return threadStripe;
+}
+
+// Draws a node height from a geometric distribution with p = 1/2 using a per-thread xorshift generator
+static int randomHeight(void) {
+    uint32_t x = threadSeed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    threadSeed = x;
+
+    int height = 1;
+    while (height < ZZ_SKIPLIST_MAX_LEVEL && (x & 1)) {
+        height++;
+        x >>= 1;
+    }
+    return height;
+}
+
+// Announces the calling thread in the current epoch; nothing it reads from now on is reclaimed until it leaves
+static size_t enterEpoch(zzConcurrentSkipListMap *sl, size_t stripe) {
+    for (;;) {
+        size_t epoch = atomic_load(&sl->epoch);
+        atomic_fetch_add(&sl->stripes[stripe].active[epoch % 3], 1);
+        if (atomic_load(&sl->epoch) == epoch) return epoch;
+        // The epoch moved on before the announcement became visible, so announce again in the new one
+        atomic_fetch_sub(&sl->stripes[stripe].active[epoch % 3], 1);
+    }
+}
+
+static void leaveEpoch(zzConcurrentSkipListMap *sl, size_t stripe, size_t epoch) {
+    atomic_fetch_sub_explicit(&sl->stripes[stripe].active[epoch % 3], 1, memory_order_release);
+}
+
+static void freeRetired(zzConcurrentSkipListMap *sl, SkipListRetired *item) {
+    while (item) {
+        SkipListRetired *next = item->next;
+        if (item->isNode) {
+            SkipListNode *node = (SkipListNode*)item;
+            SkipListValue *value = atomic_load_explicit(&node->value, memory_order_relaxed);
+            if (sl->keyFree) sl->keyFree(KEY_PTR(node));
+            if (sl->valueFree) sl->valueFree(value->data);
+            free(value);
+        } else if (sl->valueFree) {
+            sl->valueFree(((SkipListValue*)item)->data);
+        }
+        free(item);
+        item = next;
+    }
+}
+
+// Moves the epoch forward once no thread is left in the previous one. Entries retired two epochs
+// ago can then no longer be referenced by anyone, so they are freed.
+static void tryAdvanceEpoch(zzConcurrentSkipListMap *sl) {
+    if (atomic_flag_test_and_set_explicit(&sl->advancing, memory_order_acquire)) return;
+
+    size_t epoch = atomic_load(&sl->epoch);
+    bool quiet = true;
+    for (size_t i = 0; i < ZZ_SKIPLIST_EPOCH_STRIPES && quiet; i++) {
+        quiet = atomic_load(&sl->stripes[i].active[(epoch + 2) % 3]) == 0;
+    }
+
+    SkipListRetired *garbage = NULL;
+    if (quiet) {
+        garbage = atomic_exchange(&sl->limbo[(epoch + 1) % 3], NULL);
+        atomic_store(&sl->epoch, epoch + 1);
+    }
+    atomic_flag_clear_explicit(&sl->advancing, memory_order_release);
+    freeRetired(sl, garbage);
+}
+
+// Hands an unlinked node or replaced value to reclamation in the epoch the calling thread is in
+static void retire(zzConcurrentSkipListMap *sl, SkipListRetired *item, size_t epoch) {
+    _Atomic(SkipListRetired*) *list = &sl->limbo[epoch % 3];
+    item->next = atomic_load_explicit(list, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(list, &item->next, item, memory_order_release, memory_order_relaxed)) {
+    }
+    if (atomic_fetch_add_explicit(&sl->retireCount, 1, memory_order_relaxed) % RETIRES_PER_ADVANCE == RETIRES_PER_ADVANCE - 1) {
+        tryAdvanceEpoch(sl);
+    }
+}
+
+static SkipListValue *newValue(const zzConcurrentSkipListMap *sl, const void *value) {
+    SkipListValue *box = malloc(sizeof(SkipListValue) + sl->valueSize);
+    if (!box) return NULL;
+    box->retired.isNode = false;
+    memcpy(box->data, value, sl->valueSize);
+    return box;
+}
+
+static SkipListNode *newNode(int height, size_t keySize) {
+    SkipListNode *node = malloc(sizeof(SkipListNode) + height * sizeof(uintptr_t) + keySize);
+    if (!node) return NULL;
+    node->retired.isNode = true;
+    node->height = height;
+    atomic_init(&node->value, NULL);
+    atomic_init(&node->pending, 2);
+    for (int i = 0; i < height; i++) atomic_init(&node->next[i], 0);
+    return node;
+}
+
+// Fills preds and succs with the nodes around key at every level, unlinking marked nodes on the way.
+// Returns the node holding key at the bottom level, or NULL. With cleanup set, the search runs past all
+// nodes equal to key so that every removed copy of it gets unlinked.
+static SkipListNode *findPosition(zzConcurrentSkipListMap *sl, const void *key, SkipListNode **preds, SkipListNode **succs, bool cleanup) {
+retry:;
+    SkipListNode *pred = sl->head;
+    SkipListNode *curr = NULL;
+    int cmp = 1;
+    for (int level = ZZ_SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+        curr = UNMARKED(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        cmp = 1;
+        while (curr) {
+            uintptr_t succ = atomic_load_explicit(&curr->next[level], memory_order_acquire);
+            if (IS_MARKED(succ)) {
+                uintptr_t expected = (uintptr_t)curr;
+                if (!atomic_compare_exchange_strong_explicit(&pred->next[level], &expected, succ & ~MARK,
+                                                             memory_order_acq_rel, memory_order_acquire)) {
+                    goto retry;
+                }
+                curr = UNMARKED(succ);
+                continue;
+            }
+            cmp = sl->compareFn(KEY_PTR(curr), key);
+            if (cmp > 0 || (cmp == 0 && !cleanup)) break;
+            pred = curr;
+            curr = UNMARKED(succ);
+        }
+        if (preds) preds[level] = pred;
+        if (succs) succs[level] = curr;
+    }
+    return (curr && cmp == 0) ? curr : NULL;
+}
+
+// Read-only search that steps over removed nodes instead of unlinking them. Returns the first node
+// at the bottom level whose key is not less than key, or NULL; exact tells whether it holds key.
+static SkipListNode *seekNode(zzConcurrentSkipListMap *sl, const void *key, bool *exact) {
+    SkipListNode *pred = sl->head;
+    SkipListNode *curr = NULL;
+    int cmp = 1;
+    for (int level = ZZ_SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+        curr = UNMARKED(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        cmp = 1;
+        while (curr) {
+            uintptr_t succ = atomic_load_explicit(&curr->next[level], memory_order_acquire);
+            if (IS_MARKED(succ)) {
+                curr = UNMARKED(succ);
+                continue;
+            }
+            cmp = sl->compareFn(KEY_PTR(curr), key);
+            if (cmp >= 0) break;
+            pred = curr;
+            curr = UNMARKED(succ);
+        }
+    }
+    if (exact) *exact = curr && cmp == 0;
+    return curr;
+}
+
+// Called by the inserter once it stopped linking and by the remover once the node is marked. The
+// last of the two unlinks the node from every level it may still be reachable at and retires it.
+static void releaseLinks(zzConcurrentSkipListMap *sl, SkipListNode *node, size_t epoch) {
+    if (atomic_fetch_sub_explicit(&node->pending, 1, memory_order_acq_rel) != 1) return;
+    findPosition(sl, KEY_PTR(node), NULL, NULL, true);
+    retire(sl, &node->retired, epoch);
+}
+
+/**
+ * @brief Initializes a new concurrent skip list map with the specified key and value sizes.
+ *
+ * This function initializes the map with the given key and value sizes and custom
+ * functions for comparison and memory management. The map will be empty after
+ * initialization. It must complete before other threads use the map.
+ *
+ * @param[out] sl Pointer to the skip list map structure to initialize
+ * @param[in] keySize Size in bytes of each key that will be stored in the map
+ * @param[in] valueSize Size in bytes of each value that will be stored in the map
+ * @param[in] compareFn Function to compare keys for ordering (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] keyFree Function to free key memory when entries are reclaimed, or NULL if not needed
+ * @param[in] valueFree Function to free value memory when values are reclaimed, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapInit(zzConcurrentSkipListMap *sl, size_t keySize, size_t valueSize, zzCompareFn compareFn, zzFreeFn keyFree, zzFreeFn valueFree) {
+    if (!sl) return ZZ_ERR("ConcurrentSkipListMap pointer is NULL");
+    if (keySize == 0) return ZZ_ERR("Key size cannot be zero");
+    if (valueSize == 0) return ZZ_ERR("Value size cannot be zero");
+    if (!compareFn) return ZZ_ERR("Comparison function is NULL");
+
+    sl->head = newNode(ZZ_SKIPLIST_MAX_LEVEL, 0);
+    if (!sl->head) return ZZ_ERR("Memory allocation failed");
+
+    atomic_init(&sl->size, 0);
+    sl->keySize = keySize;
+    sl->valueSize = valueSize;
+    sl->compareFn = compareFn;
+    sl->keyFree = keyFree;
+    sl->valueFree = valueFree;
+    atomic_init(&sl->epoch, 0);
+    atomic_flag_clear(&sl->advancing);
+    atomic_init(&sl->retireCount, 0);
+    for (size_t i = 0; i < 3; i++) atomic_init(&sl->limbo[i], NULL);
+    for (size_t i = 0; i < ZZ_SKIPLIST_EPOCH_STRIPES; i++) {
+        for (size_t j = 0; j < 3; j++) atomic_init(&sl->stripes[i].active[j], 0);
+    }
+    return ZZ_OK();
+}
+
+/**
+ * @brief Frees all memory associated with the concurrent skip list map.
+ *
+ * This function frees all entries, including those still waiting for reclamation,
+ * calling the free functions on their keys and values. No other thread may use
+ * the map during or after this call.
+ *
+ * @param[in,out] sl Pointer to the skip list map to free
+ */
+void zzConcurrentSkipListMapFree(zzConcurrentSkipListMap *sl) {
+    if (!sl || !sl->head) return;
+
+    SkipListNode *cur = UNMARKED(atomic_load(&sl->head->next[0]));
+    while (cur) {
+        SkipListNode *next = UNMARKED(atomic_load(&cur->next[0]));
+        cur->retired.next = NULL;
+        freeRetired(sl, &cur->retired);
+        cur = next;
+    }
+    for (size_t i = 0; i < 3; i++) freeRetired(sl, atomic_exchange(&sl->limbo[i], NULL));
+
+    free(sl->head);
+    sl->head = NULL;
+    atomic_store(&sl->size, 0);
+}
+
+/**
+ * @brief Inserts or updates a key-value pair in the concurrent skip list map.
+ *
+ * This function links a new node with compare-and-swap, or atomically replaces the
+ * value of an existing key. A replaced value is reclaimed once no reader can still
+ * be copying it.
+ *
+ * @param[in,out] sl Pointer to the skip list map to insert/update in
+ * @param[in] key Pointer to the key to insert/update (contents will be copied)
+ * @param[in] value Pointer to the value to insert/update (contents will be copied)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapPut(zzConcurrentSkipListMap *sl, const void *key, const void *value) {
+    if (!sl) return ZZ_ERR("ConcurrentSkipListMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!value) return ZZ_ERR("Value pointer is NULL");
+
+    SkipListValue *box = newValue(sl, value);
+    if (!box) return ZZ_ERR("Memory allocation failed");
+
+    size_t stripe = currentStripe();
+    size_t epoch = enterEpoch(sl, stripe);
+    SkipListNode *preds[ZZ_SKIPLIST_MAX_LEVEL], *succs[ZZ_SKIPLIST_MAX_LEVEL];
+    SkipListNode *node = NULL;
+
+    for (;;) {
+        SkipListNode *found = findPosition(sl, key, preds, succs, false);
+        if (found) {
+            SkipListValue *old = atomic_exchange_explicit(&found->value, box, memory_order_acq_rel);
+            retire(sl, &old->retired, epoch);
+            leaveEpoch(sl, stripe, epoch);
+            free(node);
+            return ZZ_OK();
+        }
+
+        if (!node) {
+            node = newNode(randomHeight(), sl->keySize);
+            if (!node) {
+                leaveEpoch(sl, stripe, epoch);
+                free(box);
+                return ZZ_ERR("Memory allocation failed");
+            }
+            memcpy(KEY_PTR(node), key, sl->keySize);
+            atomic_init(&node->value, box);
+        }
+        for (int level = 0; level < node->height; level++) {
+            atomic_store_explicit(&node->next[level], (uintptr_t)succs[level], memory_order_relaxed);
+        }
+
+        // Publishing the node at the bottom level is the linearization point of the insertion
+        uintptr_t expected = (uintptr_t)succs[0];
+        if (atomic_compare_exchange_strong_explicit(&preds[0]->next[0], &expected, (uintptr_t)node,
+                                                    memory_order_release, memory_order_relaxed)) {
+            break;
+        }
+    }
+    atomic_fetch_add_explicit(&sl->size, 1, memory_order_relaxed);
+
+    // Link the index levels bottom-up; a concurrent removal marks them and ends this early
+    for (int level = 1; level < node->height; level++) {
+        for (;;) {
+            uintptr_t next = atomic_load_explicit(&node->next[level], memory_order_acquire);
+            if (IS_MARKED(next)) goto linked;
+            if (UNMARKED(next) != succs[level] &&
+                !atomic_compare_exchange_strong_explicit(&node->next[level], &next, (uintptr_t)succs[level],
+                                                         memory_order_release, memory_order_relaxed)) {
+                continue;
+            }
+
+            uintptr_t expected = (uintptr_t)succs[level];
+            if (atomic_compare_exchange_strong_explicit(&preds[level]->next[level], &expected, (uintptr_t)node,
+                                                        memory_order_release, memory_order_relaxed)) {
+                break;
+            }
+            if (findPosition(sl, key, preds, succs, false) != node) goto linked;
+        }
+    }
+
+linked:
+    releaseLinks(sl, node, epoch);
+    leaveEpoch(sl, stripe, epoch);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Retrieves the value associated with the given key.
+ *
+ * This function searches the skip list without writing to shared memory other
+ * than its epoch counter.
+ *
+ * @param[in] sl Pointer to the skip list map to retrieve from
+ * @param[in] key Pointer to the key to look up
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the key is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapGet(zzConcurrentSkipListMap *sl, const void *key, void *valueOut) {
+    if (!sl) return ZZ_ERR("ConcurrentSkipListMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!valueOut) return ZZ_ERR("Value output pointer is NULL");
+
+    size_t stripe = currentStripe();
+    size_t epoch = enterEpoch(sl, stripe);
+    bool exact;
+    SkipListNode *node = seekNode(sl, key, &exact);
+    if (exact) {
+        SkipListValue *box = atomic_load_explicit(&node->value, memory_order_acquire);
+        memcpy(valueOut, box->data, sl->valueSize);
+    }
+    leaveEpoch(sl, stripe, epoch);
+    return exact ? ZZ_OK() : ZZ_ERR("Key not found");
+}
+
+/**
+ * @brief Checks if the concurrent skip list map contains the specified key.
+ *
+ * @param[in] sl Pointer to the skip list map to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the map, false otherwise
+ */
+bool zzConcurrentSkipListMapContains(zzConcurrentSkipListMap *sl, const void *key) {
+    if (!sl || !key) return false;
+
+    size_t stripe = currentStripe();
+    size_t epoch = enterEpoch(sl, stripe);
+    bool exact;
+    seekNode(sl, key, &exact);
+    leaveEpoch(sl, stripe, epoch);
+    return exact;
+}
+
+/**
+ * @brief Removes a key-value pair from the concurrent skip list map.
+ *
+ * This function marks the node as removed at every level, unlinks it and hands it
+ * to epoch-based reclamation. If several threads remove the same key at once,
+ * exactly one of them succeeds.
+ *
+ * @param[in,out] sl Pointer to the skip list map to remove from
+ * @param[in] key Pointer to the key to remove
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapRemove(zzConcurrentSkipListMap *sl, const void *key) {
+    if (!sl) return ZZ_ERR("ConcurrentSkipListMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+
+    size_t stripe = currentStripe();
+    size_t epoch = enterEpoch(sl, stripe);
+    SkipListNode *node = findPosition(sl, key, NULL, NULL, false);
+    if (!node) {
+        leaveEpoch(sl, stripe, epoch);
+        return ZZ_ERR("Key not found");
+    }
+
+    // Mark the index levels top-down, then the bottom level, whose mark decides which remover wins
+    for (int level = node->height - 1; level >= 1; level--) {
+        uintptr_t next = atomic_load_explicit(&node->next[level], memory_order_acquire);
+        while (!IS_MARKED(next) &&
+               !atomic_compare_exchange_weak_explicit(&node->next[level], &next, next | MARK,
+                                                      memory_order_acq_rel, memory_order_acquire)) {
+        }
+    }
+    uintptr_t next = atomic_load_explicit(&node->next[0], memory_order_acquire);
+    for (;;) {
+        if (IS_MARKED(next)) {
+            leaveEpoch(sl, stripe, epoch);
+            return ZZ_ERR("Key not found");
+        }
+        if (atomic_compare_exchange_weak_explicit(&node->next[0], &next, next | MARK,
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            break;
+        }
+    }
+    atomic_fetch_sub_explicit(&sl->size, 1, memory_order_relaxed);
+
+    releaseLinks(sl, node, epoch);
+    leaveEpoch(sl, stripe, epoch);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Returns the number of key-value pairs in the concurrent skip list map.
+ *
+ * While other threads are updating the map the result is only a snapshot.
+ *
+ * @param[in] sl Pointer to the skip list map
+ * @return Number of key-value pairs in the map
+ */
+size_t zzConcurrentSkipListMapSize(const zzConcurrentSkipListMap *sl) {
+    if (!sl) return 0;
+    return atomic_load_explicit(&((zzConcurrentSkipListMap*)sl)->size, memory_order_relaxed);
+}
+
+// Moves the iterator past removed nodes; leaves the epoch once the end is reached
+static void settleIterator(zzConcurrentSkipListMapIterator *it, SkipListNode *node) {
+    while (node) {
+        uintptr_t next = atomic_load_explicit(&node->next[0], memory_order_acquire);
+        if (!IS_MARKED(next)) break;
+        node = UNMARKED(next);
+    }
+    it->current = node;
+    if (!node) zzConcurrentSkipListMapIteratorRelease(it);
+}
+
+/**
+ * @brief Initializes an iterator positioned at the smallest key of the map.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] sl Pointer to the skip list map to iterate over
+ */
+void zzConcurrentSkipListMapIteratorInit(zzConcurrentSkipListMapIterator *it, zzConcurrentSkipListMap *sl) {
+    if (!it) return;
+    it->map = sl;
+    it->current = NULL;
+    it->guarded = false;
+    if (!sl) {
+        it->state = ZZ_ITER_ERROR;
+        return;
+    }
+
+    it->stripe = currentStripe();
+    it->epoch = enterEpoch(sl, it->stripe);
+    it->guarded = true;
+    it->state = ZZ_ITER_VALID;
+    settleIterator(it, UNMARKED(atomic_load_explicit(&sl->head->next[0], memory_order_acquire)));
+}
+
+/**
+ * @brief Repositions the iterator at the first key greater than or equal to the given key.
+ *
+ * This function uses the index levels to find the position in O(log n) expected
+ * time, so a range scan starts with a seek and stops once a key passes the
+ * upper bound.
+ *
+ * @param[in,out] it Pointer to the iterator to reposition
+ * @param[in] key Pointer to the lower bound of the keys to iterate
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzConcurrentSkipListMapIteratorSeek(zzConcurrentSkipListMapIterator *it, const void *key) {
+    if (!it || !it->map || it->state == ZZ_ITER_ERROR) return ZZ_ERR("Invalid iterator state");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+
+    if (!it->guarded) {
+        it->stripe = currentStripe();
+        it->epoch = enterEpoch(it->map, it->stripe);
+        it->guarded = true;
+    }
+    it->state = ZZ_ITER_VALID;
+    settleIterator(it, seekNode(it->map, key, NULL));
+    return ZZ_OK();
+}
+
+/**
+ * @brief Advances the iterator to the next key-value pair.
+ *
+ * This function copies the current key and value to the output buffers and moves
+ * the iterator to the next key-value pair in sorted order. Returns false when the
+ * iterator reaches the end of the map.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] keyOut Pointer to a buffer where the current key will be copied
+ * @param[out] valueOut Pointer to a buffer where the current value will be copied
+ * @return true if a key-value pair was retrieved, false if the iterator reached the end
+ */
+bool zzConcurrentSkipListMapIteratorNext(zzConcurrentSkipListMapIterator *it, void *keyOut, void *valueOut) {
+    if (!it || !keyOut || !valueOut || it->state != ZZ_ITER_VALID || !it->current) return false;
+
+    SkipListNode *current = it->current;
+    SkipListValue *box = atomic_load_explicit(&current->value, memory_order_acquire);
+    memcpy(keyOut, KEY_PTR(current), it->map->keySize);
+    memcpy(valueOut, box->data, it->map->valueSize);
+
+    settleIterator(it, UNMARKED(atomic_load_explicit(&current->next[0], memory_order_acquire)));
+    return true;
+}
+
+/**
+ * @brief Checks if the iterator has more elements.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more elements, false otherwise
+ */
+bool zzConcurrentSkipListMapIteratorHasNext(const zzConcurrentSkipListMapIterator *it) {
+    return it && it->state == ZZ_ITER_VALID && it->current != NULL;
+}
+
+/**
+ * @brief Ends an iteration before it reached the end of the map.
+ *
+ * This function leaves the epoch held by the iterator so that removed entries can
+ * be reclaimed again. Calling it on a finished iterator has no effect.
+ *
+ * @param[in,out] it Pointer to the iterator to release
+ */
+void zzConcurrentSkipListMapIteratorRelease(zzConcurrentSkipListMapIterator *it) {
+    if (!it) return;
+    if (it->guarded) {
+        leaveEpoch(it->map, it->stripe, it->epoch);
+        it->guarded = false;
+    }
+    it->current = NULL;
+    if (it->state == ZZ_ITER_VALID) it->state = ZZ_ITER_END;
+}
\ No newline at end of file
@@ -147,6 +147,20 @@ int zzIntCompare(const void *a, const void *b) {
     return (ia > ib) - (ia < ib);
 }
 
+/**
+ * @brief Computes an order-preserving prefix for an integer value.
+ *
+ * This function maps an integer to an unsigned 64-bit value with the same
+ * ordering by flipping its sign bit. It's designed for use as the key prefix
+ * function of ordered structures like trees that use zzIntCompare.
+ *
+ * @param key Pointer to the integer to extract the prefix from
+ * @return 64-bit prefix ordered like the integer values
+ */
+uint64_t zzIntPrefix(const void *key) {
+    return (uint64_t)(int64_t)*(const int*)key ^ 0x8000000000000000u;
+}
+
 /**
  * @brief Computes a hash for a long integer value.
  *
@@ -196,6 +210,20 @@ int zzLongCompare(const void *a, const void *b) {
     return (la > lb) - (la < lb);
 }
 
+/**
+ * @brief Computes an order-preserving prefix for a long integer value.
+ *
+ * This function maps a long integer to an unsigned 64-bit value with the same
+ * ordering by flipping its sign bit. It's designed for use as the key prefix
+ * function of ordered structures like trees that use zzLongCompare.
+ *
+ * @param key Pointer to the long integer to extract the prefix from
+ * @return 64-bit prefix ordered like the long integer values
+ */
+uint64_t zzLongPrefix(const void *key) {
+    return (uint64_t)(int64_t)*(const long*)key ^ 0x8000000000000000u;
+}
+
 /**
  * @brief Computes a hash for a float value.
  *
@@ -330,4 +358,25 @@ bool zzStringEquals(const void *a, const void *b) {
  */
 int zzStringCompare(const void *a, const void *b) {
     return strcmp(*(const char**)a, *(const char**)b);
+}
+
+/**
+ * @brief Computes an order-preserving prefix for a string value.
+ *
+ * This function packs the first eight bytes of a null-terminated string into a
+ * big-endian 64-bit value, padding shorter strings with zero bytes, so that
+ * prefixes compare like strcmp. It's designed for use as the key prefix function
+ * of ordered structures like trees that use zzStringCompare.
+ *
+ * @param key Pointer to the null-terminated string to extract the prefix from
+ * @return 64-bit prefix holding the leading bytes of the string
+ */
+uint64_t zzStringPrefix(const void *key) {
+    const char *str = *(const char**)key;
+    uint64_t prefix = 0;
+    for (int i = 0; i < 8; i++) {
+        prefix <<= 8;
+        if (*str) prefix |= (uint8_t)*str++;
+    }
+    return prefix;
 }
\ No newline at end of file
@@ -275,6 +275,73 @@ void zzHashMapClear(zzHashMap *hm) {
     }
     hm->size = 0;
 }
+
+// Unlinks and frees the entries for which pred returns verdict in one pass over the buckets
+static size_t zzHashMapRemoveMatching(zzHashMap *hm, zzEntryPredicateFn pred, void *userdata, bool verdict) {
+    size_t removed = 0;
+    for (size_t i = 0; i < hm->capacity; i++) {
+        MapNode **cur = &hm->buckets[i];
+        while (*cur) {
+            MapNode *node = *cur;
+            if (pred(node->data, node->data + hm->keySize, userdata) != verdict) {
+                cur = &node->next;
+                continue;
+            }
+            *cur = node->next;
+            if (hm->keyFree) hm->keyFree(node->data);
+            if (hm->valueFree) hm->valueFree(node->data + hm->keySize);
+            free(node);
+            removed++;
+        }
+    }
+    hm->size -= removed;
+    return removed;
+}
+
+/**
+ * @brief Removes every entry for which the predicate returns true.
+ *
+ * This function tests each key-value pair once, in bucket order, and unlinks the
+ * matching nodes during the same pass, so it runs in O(n + capacity) time however
+ * many entries are removed. If custom free functions were provided, they are
+ * called on the key and value of every removed entry. The predicate must not
+ * modify the map.
+ *
+ * @param[in,out] hm Pointer to the HashMap to filter
+ * @param[in] pred Function selecting the entries to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzHashMapRemoveIf(zzHashMap *hm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!hm) return ZZ_ERR("HashMap pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzHashMapRemoveMatching(hm, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the entries for which the predicate returns true.
+ *
+ * This function is the complement of zzHashMapRemoveIf and removes every entry
+ * that does not satisfy the predicate in the same single pass.
+ *
+ * @param[in,out] hm Pointer to the HashMap to filter
+ * @param[in] pred Function selecting the entries to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzHashMapRetainIf(zzHashMap *hm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!hm) return ZZ_ERR("HashMap pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzHashMapRemoveMatching(hm, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
 /**
  * @brief Initializes an iterator for the HashMap.
  *
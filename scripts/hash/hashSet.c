@@ -229,6 +229,71 @@ void zzHashSetClear(zzHashSet *s) {
     s->size = 0;
 }
 
+// Unlinks and frees the keys for which pred returns verdict in one pass over the buckets
+static size_t zzHashSetRemoveMatching(zzHashSet *s, zzPredicateFn pred, void *userdata, bool verdict) {
+    size_t removed = 0;
+    for (size_t i = 0; i < s->capacity; i++) {
+        SetNode **cur = &s->buckets[i];
+        while (*cur) {
+            SetNode *node = *cur;
+            if (pred(node->key, userdata) != verdict) {
+                cur = &node->next;
+                continue;
+            }
+            *cur = node->next;
+            if (s->keyFree) s->keyFree(node->key);
+            free(node);
+            removed++;
+        }
+    }
+    s->size -= removed;
+    return removed;
+}
+
+/**
+ * @brief Removes every key for which the predicate returns true.
+ *
+ * This function tests each key once, in bucket order, and unlinks the matching
+ * nodes during the same pass, so it runs in O(n + capacity) time however many
+ * keys are removed. If a custom free function was provided, it is called on
+ * every removed key. The predicate must not modify the set.
+ *
+ * @param[in,out] s Pointer to the HashSet to filter
+ * @param[in] pred Function selecting the keys to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzHashSetRemoveIf(zzHashSet *s, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!s) return ZZ_ERR("HashSet pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzHashSetRemoveMatching(s, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the keys for which the predicate returns true.
+ *
+ * This function is the complement of zzHashSetRemoveIf and removes every key
+ * that does not satisfy the predicate in the same single pass.
+ *
+ * @param[in,out] s Pointer to the HashSet to filter
+ * @param[in] pred Function selecting the keys to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzHashSetRetainIf(zzHashSet *s, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!s) return ZZ_ERR("HashSet pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzHashSetRemoveMatching(s, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Applies a function to each element in the HashSet.
  *
@@ -64,6 +64,105 @@ void zzArrayDequeFree(zzArrayDeque *ad) {
     ad->buffer = NULL;
 }
 
+// Moves the elements to the start of the buffer in logical order. Wrapped contents are
+// rotated by parking the shorter of the two runs in a scratch block while the longer
+// one is moved into place, so every element is copied at most twice.
+static zzOpResult zzArrayDequeLinearize(zzArrayDeque *ad) {
+    if (ad->front == 0) return ZZ_OK();
+
+    unsigned char *buf = ad->buffer;
+    size_t elSize = ad->elSize;
+    if (ad->front + ad->size <= ad->capacity) {
+        memmove(buf, buf + ad->front * elSize, ad->size * elSize);
+        ad->front = 0;
+        return ZZ_OK();
+    }
+
+    // The head run fills [front, capacity) and the tail run wraps around to [0, tailCount)
+    size_t headCount = ad->capacity - ad->front;
+    size_t tailCount = ad->size - headCount;
+    size_t parked = headCount < tailCount ? headCount : tailCount;
+    unsigned char *scratch = malloc(parked * elSize);
+    if (!scratch) return ZZ_ERR("Failed to allocate scratch memory");
+
+    if (tailCount <= headCount) {
+        memcpy(scratch, buf, tailCount * elSize);
+        memmove(buf, buf + ad->front * elSize, headCount * elSize);
+        memcpy(buf + headCount * elSize, scratch, tailCount * elSize);
+    } else {
+        memcpy(scratch, buf + ad->front * elSize, headCount * elSize);
+        memmove(buf + headCount * elSize, buf, tailCount * elSize);
+        memcpy(buf, scratch, headCount * elSize);
+    }
+    free(scratch);
+    ad->front = 0;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Transfers ownership of the ArrayDeque's buffer to the caller.
+ *
+ * This function hands out the underlying buffer with the size elements stored
+ * contiguously from its start, in order from front to back. If the elements
+ * wrap around the end of the circular buffer they are first rotated into place,
+ * which temporarily allocates room for the shorter of the two wrapped runs; if
+ * that fails the deque is left unchanged. The caller becomes responsible for the
+ * elements and must release the buffer with free(); the free function of the
+ * deque is not called. The deque is left empty with no storage and can be
+ * reused: it allocates a new buffer on the next insertion.
+ *
+ * @param[in,out] ad Pointer to the ArrayDeque to detach the buffer from
+ * @param[out] bufferOut Pointer receiving the buffer, or NULL if the deque had no storage
+ * @param[out] sizeOut Pointer receiving the number of elements in the buffer
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayDequeDetach(zzArrayDeque *ad, void **bufferOut, size_t *sizeOut) {
+    if (!ad) return ZZ_ERR("ArrayDeque pointer is NULL");
+    if (!bufferOut) return ZZ_ERR("Buffer output pointer is NULL");
+    if (!sizeOut) return ZZ_ERR("Size output pointer is NULL");
+
+    if (ad->buffer) {
+        zzOpResult res = zzArrayDequeLinearize(ad);
+        if (ZZ_IS_ERR(res)) return res;
+    }
+    *bufferOut = ad->buffer;
+    *sizeOut = ad->size;
+    ad->buffer = NULL;
+    ad->capacity = 0;
+    ad->front = 0;
+    ad->size = 0;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Makes the ArrayDeque take ownership of an existing buffer without copying it.
+ *
+ * This function replaces the contents of an initialized deque with the first size
+ * elements of a buffer allocated with malloc, calloc or realloc and room for
+ * capacity elements of the deque's element size. The first element of the buffer
+ * becomes the front. The current elements are released first as by
+ * zzArrayDequeFree. From then on the deque owns the buffer and frees it together
+ * with the deque.
+ *
+ * @param[in,out] ad Pointer to an initialized ArrayDeque
+ * @param[in] buffer Heap buffer to adopt, or NULL to leave the deque empty with no storage
+ * @param[in] size Number of elements stored at the start of the buffer
+ * @param[in] capacity Number of elements the buffer has room for (must be at least size)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayDequeAdopt(zzArrayDeque *ad, void *buffer, size_t size, size_t capacity) {
+    if (!ad) return ZZ_ERR("ArrayDeque pointer is NULL");
+    if (!buffer && capacity > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (size > capacity) return ZZ_ERR("Size exceeds capacity");
+
+    zzArrayDequeFree(ad);
+    ad->buffer = buffer;
+    ad->capacity = capacity;
+    ad->front = 0;
+    ad->size = size;
+    return ZZ_OK();
+}
+
 /**
  * @brief Internal function to resize the ArrayDeque buffer when capacity is exceeded.
  *
@@ -110,7 +209,7 @@ zzOpResult zzArrayDequePushFront(zzArrayDeque *ad, const void *elem) {
     if (!elem) return ZZ_ERR("Element pointer is NULL");
 
     if (ad->size == ad->capacity) {
-        zzOpResult resizeResult = zzArrayDequeResize(ad, ad->capacity * 2);
+        zzOpResult resizeResult = zzArrayDequeResize(ad, ad->capacity ? ad->capacity * 2 : 4);
         if (ZZ_IS_ERR(resizeResult)) return resizeResult;
     }
 
@@ -136,7 +235,7 @@ zzOpResult zzArrayDequePushBack(zzArrayDeque *ad, const void *elem) {
     if (!elem) return ZZ_ERR("Element pointer is NULL");
 
     if (ad->size == ad->capacity) {
-        zzOpResult resizeResult = zzArrayDequeResize(ad, ad->capacity * 2);
+        zzOpResult resizeResult = zzArrayDequeResize(ad, ad->capacity ? ad->capacity * 2 : 4);
         if (ZZ_IS_ERR(resizeResult)) return resizeResult;
     }
 
@@ -255,6 +354,51 @@ zzOpResult zzArrayDequeGet(const zzArrayDeque *ad, size_t idx, void *out) {
     return ZZ_OK();
 }
 
+/**
+ * @brief Returns a pointer to the element at the specified index.
+ *
+ * This function gives direct access to the element inside the circular buffer
+ * instead of copying it out. The index is relative to the logical order of
+ * elements (from front to back). The element may be modified through the pointer,
+ * which stays valid until the deque is next modified.
+ *
+ * @param[in] ad Pointer to the ArrayDeque
+ * @param[in] idx Index of the element (0-based, relative to front)
+ * @return Pointer to the element, or NULL if ad is NULL or idx is out of bounds
+ */
+void *zzArrayDequeAt(const zzArrayDeque *ad, size_t idx) {
+    if (!ad || idx >= ad->size) return NULL;
+    return (char*)ad->buffer + ((ad->front + idx) % ad->capacity) * ad->elSize;
+}
+
+/**
+ * @brief Describes the contents of the ArrayDeque as at most two contiguous spans.
+ *
+ * The elements occupy one run of the circular buffer, or two runs when they
+ * wrap around its end. Reading spans[0] and then spans[1] visits every element
+ * in logical order (from front to back) without copying, so the spans can be
+ * passed directly to vectored I/O such as writev(). Unused spans are set to
+ * { NULL, 0 }. The spans stay valid until the deque is next modified.
+ *
+ * @param[in] ad Pointer to the ArrayDeque
+ * @param[out] spans Array of two spans receiving the contents
+ * @return Number of non-empty spans written (0, 1 or 2)
+ */
+size_t zzArrayDequeSpans(const zzArrayDeque *ad, zzSpan spans[2]) {
+    if (!spans) return 0;
+    spans[0] = (zzSpan){ NULL, 0 };
+    spans[1] = (zzSpan){ NULL, 0 };
+    if (!ad || ad->size == 0) return 0;
+
+    size_t firstCount = ad->capacity - ad->front;
+    if (firstCount > ad->size) firstCount = ad->size;
+    spans[0] = (zzSpan){ (char*)ad->buffer + ad->front * ad->elSize, firstCount };
+    if (firstCount == ad->size) return 1;
+
+    spans[1] = (zzSpan){ ad->buffer, ad->size - firstCount };
+    return 2;
+}
+
 /**
  * @brief Clears all elements from the ArrayDeque.
  *
@@ -278,6 +422,71 @@ void zzArrayDequeClear(zzArrayDeque *ad) {
     ad->front = 0;
 }
 
+// Frees the elements for which pred returns verdict and shifts the survivors towards the
+// front in one stable pass over the logical order
+static size_t zzArrayDequeRemoveMatching(zzArrayDeque *ad, zzPredicateFn pred, void *userdata, bool verdict) {
+    char *buf = ad->buffer;
+    const size_t es = ad->elSize, cap = ad->capacity, count = ad->size;
+    size_t write = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        char *elem = buf + ((ad->front + i) % cap) * es;
+        if (pred(elem, userdata) == verdict) {
+            if (ad->elemFree) ad->elemFree(elem);
+            continue;
+        }
+        if (write != i) memcpy(buf + ((ad->front + write) % cap) * es, elem, es);
+        write++;
+    }
+
+    ad->size = write;
+    return count - write;
+}
+
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, from front to back, and compacts the
+ * survivors towards the front in a single stable pass, so it runs in O(n) time
+ * however many elements are removed. If a custom free function was provided, it
+ * is called on every removed element. The predicate must not modify the deque.
+ *
+ * @param[in,out] ad Pointer to the ArrayDeque to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayDequeRemoveIf(zzArrayDeque *ad, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!ad) return ZZ_ERR("ArrayDeque pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzArrayDequeRemoveMatching(ad, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzArrayDequeRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] ad Pointer to the ArrayDeque to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayDequeRetainIf(zzArrayDeque *ad, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!ad) return ZZ_ERR("ArrayDeque pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzArrayDequeRemoveMatching(ad, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Initializes an iterator for the ArrayDeque.
  *
@@ -9,9 +9,24 @@
  */
 
 #include "arrayList.h"
+#include "sort.h"
+#include "parallelSort.h"
+#include "search.h"
+#include "scan.h"
 #include <string.h>
 #include <stdlib.h>
 
+// Offset of the inline storage from the start of the list in a ZZ_ARRAY_LIST_INLINE structure
+#define INLINE_OFFSET \
+    ((sizeof(zzArrayList) + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t))
+
+// Start of the element storage: the heap buffer, the inline storage while the list has
+// not spilled, or NULL for a list without storage
+static inline char *listData(const zzArrayList *al) {
+    if (al->buffer) return al->buffer;
+    return al->inlineCap ? (char*)al + INLINE_OFFSET : NULL;
+}
+
 /**
  * @brief Initializes a new ArrayList with the specified element size and capacity.
  *
@@ -33,6 +48,7 @@ zzOpResult zzArrayListInit(zzArrayList *al, size_t elSize, size_t capacity, zzFr
     al->elSize = elSize;
     al->size = 0;
     al->capacity = capacity;
+    al->inlineCap = 0;
     al->elemFree = elemFree;
     al->buffer = malloc(elSize * capacity);
 
@@ -40,6 +56,35 @@ zzOpResult zzArrayListInit(zzArrayList *al, size_t elSize, size_t capacity, zzFr
     return ZZ_OK();
 }
 
+/**
+ * @brief Initializes an ArrayList that keeps its first elements in inline storage.
+ *
+ * This function initializes the list member of a ZZ_ARRAY_LIST_INLINE structure
+ * without allocating. Elements are stored in the inline storage until the list
+ * outgrows it; the elements are then moved to a heap buffer that grows as in
+ * zzArrayListInit. If the storage cannot hold a single element, the list is
+ * initialized as by zzArrayListInit with the default capacity.
+ *
+ * @param[out] al Pointer to the list member of a ZZ_ARRAY_LIST_INLINE structure
+ * @param[in] inlineBytes Size in bytes of the storage member of that structure
+ * @param[in] elSize Size in bytes of each element that will be stored in the list
+ * @param[in] elemFree Function to free individual elements when they are removed or the list is freed, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListInitInline(zzArrayList *al, size_t inlineBytes, size_t elSize, zzFreeFn elemFree) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (inlineBytes < elSize) return zzArrayListInit(al, elSize, 0, elemFree);
+
+    al->buffer = NULL;
+    al->elSize = elSize;
+    al->size = 0;
+    al->capacity = inlineBytes / elSize;
+    al->inlineCap = al->capacity;
+    al->elemFree = elemFree;
+    return ZZ_OK();
+}
+
 /**
  * @brief Frees all resources associated with the ArrayList.
  *
@@ -50,17 +95,106 @@ zzOpResult zzArrayListInit(zzArrayList *al, size_t elSize, size_t capacity, zzFr
  * @param[in,out] al Pointer to the ArrayList to free
  */
 void zzArrayListFree(zzArrayList *al) {
-    if (!al || !al->buffer) return;
+    if (!al || !listData(al)) return;
 
     if (al->elemFree) {
         for (size_t i = 0; i < al->size; i++) {
-            void *elem = (char*)al->buffer + i * al->elSize;
+            void *elem = listData(al) + i * al->elSize;
             al->elemFree(elem);
         }
     }
     free(al->buffer);
     al->buffer = NULL;
     al->size = 0;
+    al->capacity = al->inlineCap;
+}
+
+/**
+ * @brief Transfers ownership of the ArrayList's buffer to the caller.
+ *
+ * This function hands out the underlying buffer, holding size contiguous
+ * elements, without copying it. The caller becomes responsible for the elements
+ * and must release the buffer with free(); the free function of the list is not
+ * called. Elements held in inline storage are first copied to a new heap
+ * buffer. The list is left empty and can be reused: it returns to its inline
+ * storage, if any, or allocates a new buffer on the next insertion.
+ *
+ * @param[in,out] al Pointer to the ArrayList to detach the buffer from
+ * @param[out] bufferOut Pointer receiving the buffer, or NULL if the list held no heap storage and no elements
+ * @param[out] sizeOut Pointer receiving the number of elements in the buffer
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListDetach(zzArrayList *al, void **bufferOut, size_t *sizeOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    if (!bufferOut) return ZZ_ERR("Buffer output pointer is NULL");
+    if (!sizeOut) return ZZ_ERR("Size output pointer is NULL");
+
+    if (!al->buffer && al->size > 0) {
+        // Elements held inline are copied out: the caller always receives a heap buffer
+        void *copy = malloc(al->size * al->elSize);
+        if (!copy) return ZZ_ERR("Failed to allocate buffer memory");
+        memcpy(copy, listData(al), al->size * al->elSize);
+        *bufferOut = copy;
+    } else {
+        *bufferOut = al->buffer;
+    }
+    *sizeOut = al->size;
+    al->buffer = NULL;
+    al->size = 0;
+    al->capacity = al->inlineCap;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Makes the ArrayList take ownership of an existing buffer without copying it.
+ *
+ * This function replaces the contents of an initialized list with the first size
+ * elements of a buffer allocated with malloc, calloc or realloc and room for
+ * capacity elements of the list's element size. The current elements are
+ * released first as by zzArrayListFree. From then on the list owns the buffer:
+ * it may reallocate it and frees it together with the list.
+ *
+ * @param[in,out] al Pointer to an initialized ArrayList
+ * @param[in] buffer Heap buffer to adopt, or NULL to leave the list empty on its inline storage, if any
+ * @param[in] size Number of elements stored at the start of the buffer
+ * @param[in] capacity Number of elements the buffer has room for (must be at least size)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListAdopt(zzArrayList *al, void *buffer, size_t size, size_t capacity) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    if (!buffer && capacity > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (size > capacity) return ZZ_ERR("Size exceeds capacity");
+
+    zzArrayListFree(al);
+    if (!buffer) return ZZ_OK();
+    al->buffer = buffer;
+    al->size = size;
+    al->capacity = capacity;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Internal function to move the elements to a heap buffer of the given capacity.
+ *
+ * This helper function reallocates the heap buffer, or allocates one and copies
+ * the elements out of the inline storage when the list has not spilled yet.
+ *
+ * @param[in,out] al Pointer to the ArrayList to resize
+ * @param[in] newCap Number of elements the new buffer must be able to hold
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+static zzOpResult zzArrayListRealloc(zzArrayList *al, size_t newCap) {
+    void *newBuf;
+    if (al->buffer || al->inlineCap == 0) {
+        newBuf = realloc(al->buffer, al->elSize * newCap);
+    } else {
+        newBuf = malloc(al->elSize * newCap);
+        if (newBuf) memcpy(newBuf, listData(al), al->size * al->elSize);
+    }
+    if (!newBuf) return ZZ_ERR("Failed to grow buffer (realloc failed)");
+    al->buffer = newBuf;
+    al->capacity = newCap;
+    return ZZ_OK();
 }
 
 /**
@@ -76,11 +210,7 @@ void zzArrayListFree(zzArrayList *al) {
 static zzOpResult zzArrayListGrow(zzArrayList *al) {
     size_t newCap = al->capacity + (al->capacity >> 1);
     if (newCap < al->capacity + 8) newCap = al->capacity + 8;
-    void *newBuf = realloc(al->buffer, al->elSize * newCap);
-    if (!newBuf) return ZZ_ERR("Failed to grow buffer (realloc failed)");
-    al->buffer = newBuf;
-    al->capacity = newCap;
-    return ZZ_OK();
+    return zzArrayListRealloc(al, newCap);
 }
 
 /**
@@ -105,7 +235,7 @@ zzOpResult zzArrayListAdd(zzArrayList *al, const void *elem) {
         }
     }
 
-    memcpy((char*)al->buffer + al->size * al->elSize, elem, al->elSize);
+    memcpy(listData(al) + al->size * al->elSize, elem, al->elSize);
     al->size++;
     return ZZ_OK();
 }
@@ -126,10 +256,42 @@ zzOpResult zzArrayListGet(const zzArrayList *al, size_t idx, void *out) {
     if (!out) return ZZ_ERR("Output buffer is NULL");
     if (idx >= al->size) return ZZ_ERR("Index out of bounds");
 
-    memcpy(out, (char*)al->buffer + idx * al->elSize, al->elSize);
+    memcpy(out, listData(al) + idx * al->elSize, al->elSize);
     return ZZ_OK();
 }
 
+/**
+ * @brief Returns a pointer to the contiguous storage of the ArrayList.
+ *
+ * The size elements of the list are laid out back to back starting at the
+ * returned address, so callers can read or modify them in place without the copy
+ * made by zzArrayListGet. The pointer is invalidated by any operation that adds
+ * elements (the buffer may be reallocated) and the data it points to is shifted
+ * by insertions and removals.
+ *
+ * @param[in] al Pointer to the ArrayList
+ * @return Pointer to the first element, or NULL if al is NULL
+ */
+void *zzArrayListData(const zzArrayList *al) {
+    return al ? listData(al) : NULL;
+}
+
+/**
+ * @brief Returns a pointer to the element at the specified index.
+ *
+ * This function gives direct access to the element inside the list's buffer
+ * instead of copying it out. The element may be modified through the pointer.
+ * The same invalidation rules as for zzArrayListData apply.
+ *
+ * @param[in] al Pointer to the ArrayList
+ * @param[in] idx Index of the element (0-based)
+ * @return Pointer to the element, or NULL if al is NULL or idx is out of bounds
+ */
+void *zzArrayListAt(const zzArrayList *al, size_t idx) {
+    if (!al || idx >= al->size) return NULL;
+    return listData(al) + idx * al->elSize;
+}
+
 /**
  * @brief Sets the element at the specified index.
  *
@@ -148,7 +310,7 @@ zzOpResult zzArrayListSet(zzArrayList *al, size_t idx, const void *elem) {
     if (!elem) return ZZ_ERR("Element pointer is NULL");
     if (idx >= al->size) return ZZ_ERR("Index out of bounds");
 
-    void *target = (char*)al->buffer + idx * al->elSize;
+    void *target = listData(al) + idx * al->elSize;
     if (al->elemFree) {
         al->elemFree(target);
     }
@@ -171,7 +333,7 @@ zzOpResult zzArrayListRemove(zzArrayList *al, size_t idx) {
     if (!al) return ZZ_ERR("ArrayList pointer is NULL");
     if (idx >= al->size) return ZZ_ERR("Index out of bounds");
 
-    void *target = (char*)al->buffer + idx * al->elSize;
+    void *target = listData(al) + idx * al->elSize;
     if (al->elemFree) {
         al->elemFree(target);
     }
@@ -198,13 +360,84 @@ void zzArrayListClear(zzArrayList *al) {
 
     if (al->elemFree) {
         for (size_t i = 0; i < al->size; i++) {
-            void *elem = (char*)al->buffer + i * al->elSize;
+            void *elem = listData(al) + i * al->elSize;
             al->elemFree(elem);
         }
     }
     al->size = 0;
 }
 
+// Frees the elements for which pred returns verdict and closes the gaps in one stable pass,
+// moving each run of surviving elements with a single memmove
+static size_t zzArrayListRemoveMatching(zzArrayList *al, zzPredicateFn pred, void *userdata, bool verdict) {
+    char *buf = listData(al);
+    const size_t es = al->elSize, count = al->size;
+    size_t write = 0, runStart = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        char *elem = buf + i * es;
+        if (pred(elem, userdata) != verdict) continue;
+
+        if (runStart < i) {
+            if (write != runStart) memmove(buf + write * es, buf + runStart * es, (i - runStart) * es);
+            write += i - runStart;
+        }
+        runStart = i + 1;
+        if (al->elemFree) al->elemFree(elem);
+    }
+    if (runStart < count) {
+        if (write != runStart) memmove(buf + write * es, buf + runStart * es, (count - runStart) * es);
+        write += count - runStart;
+    }
+
+    al->size = write;
+    return count - write;
+}
+
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, in order, and compacts the survivors
+ * in a single stable pass, so it runs in O(n) time however many elements are
+ * removed. If a custom free function was provided, it is called on every
+ * removed element. The predicate must not modify the list.
+ *
+ * @param[in,out] al Pointer to the ArrayList to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListRemoveIf(zzArrayList *al, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzArrayListRemoveMatching(al, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzArrayListRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] al Pointer to the ArrayList to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListRetainIf(zzArrayList *al, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzArrayListRemoveMatching(al, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Inserts an element at the specified index.
  *
@@ -230,22 +463,143 @@ zzOpResult zzArrayListInsert(zzArrayList *al, size_t idx, const void *elem) {
     }
 
     if (idx < al->size) {
-        void *src = (char*)al->buffer + idx * al->elSize;
+        void *src = listData(al) + idx * al->elSize;
         void *dst = (char*)src + al->elSize;
         memmove(dst, src, (al->size - idx) * al->elSize);
     }
 
-    memcpy((char*)al->buffer + idx * al->elSize, elem, al->elSize);
+    memcpy(listData(al) + idx * al->elSize, elem, al->elSize);
     al->size++;
     return ZZ_OK();
 }
 
+/**
+ * @brief Internal function to ensure the buffer can hold a given number of elements.
+ *
+ * This helper function reallocates the buffer once to the larger of the requested
+ * capacity and the capacity zzArrayListGrow would pick, so repeated bulk insertions
+ * keep the amortized growth of single insertions.
+ *
+ * @param[in,out] al Pointer to the ArrayList to grow
+ * @param[in] minCap Number of elements the buffer must be able to hold
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+static zzOpResult zzArrayListReserve(zzArrayList *al, size_t minCap) {
+    if (minCap <= al->capacity) return ZZ_OK();
+
+    size_t newCap = al->capacity + (al->capacity >> 1);
+    if (newCap < al->capacity + 8) newCap = al->capacity + 8;
+    if (newCap < minCap || newCap > SIZE_MAX / al->elSize) newCap = minCap;
+    return zzArrayListRealloc(al, newCap);
+}
+
+/**
+ * @brief Appends an array of elements to the end of the ArrayList.
+ *
+ * This function grows the buffer at most once to fit all new elements and
+ * copies them in with a single memcpy. The source array must not point into
+ * the list's own buffer.
+ *
+ * @param[in,out] al Pointer to the ArrayList to add to
+ * @param[in] elems Pointer to the first of count contiguous elements (contents will be copied)
+ * @param[in] count Number of elements to append
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListAddAll(zzArrayList *al, const void *elems, size_t count) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzArrayListReplaceRange(al, al->size, 0, elems, count);
+}
+
+/**
+ * @brief Inserts an array of elements at the specified index.
+ *
+ * This function grows the buffer at most once, shifts the elements from idx
+ * onwards right by count positions with a single memmove and copies the new
+ * elements into the gap. The source array must not point into the list's own
+ * buffer.
+ *
+ * @param[in,out] al Pointer to the ArrayList to insert into
+ * @param[in] idx Index at which to insert the first element (0-based)
+ * @param[in] elems Pointer to the first of count contiguous elements (contents will be copied)
+ * @param[in] count Number of elements to insert
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListInsertRange(zzArrayList *al, size_t idx, const void *elems, size_t count) {
+    return zzArrayListReplaceRange(al, idx, 0, elems, count);
+}
+
+/**
+ * @brief Removes the elements in the index range [fromIdx, toIdx).
+ *
+ * This function calls the custom free function on each removed element (if
+ * provided) and closes the gap with a single memmove of the tail.
+ *
+ * @param[in,out] al Pointer to the ArrayList to remove from
+ * @param[in] fromIdx Index of the first element to remove (0-based)
+ * @param[in] toIdx Index one past the last element to remove
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListRemoveRange(zzArrayList *al, size_t fromIdx, size_t toIdx) {
+    if (fromIdx > toIdx) return ZZ_ERR("Invalid range (fromIdx > toIdx)");
+    return zzArrayListReplaceRange(al, fromIdx, toIdx - fromIdx, NULL, 0);
+}
+
+/**
+ * @brief Replaces a range of elements with an array of elements.
+ *
+ * This function replaces the count elements starting at idx with newCount
+ * elements copied from elems, so the list grows or shrinks by the difference.
+ * The buffer is grown at most once and the tail is moved with a single memmove.
+ * The custom free function is called on each replaced element (if provided),
+ * and the list is left unchanged if growing fails. The source array must not
+ * point into the list's own buffer.
+ *
+ * @param[in,out] al Pointer to the ArrayList to modify
+ * @param[in] idx Index of the first element to replace (0-based)
+ * @param[in] count Number of elements to replace
+ * @param[in] elems Pointer to the first of newCount contiguous elements (contents will be copied)
+ * @param[in] newCount Number of elements to put in place of the replaced ones
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListReplaceRange(zzArrayList *al, size_t idx, size_t count, const void *elems, size_t newCount) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    if (!elems && newCount > 0) return ZZ_ERR("Element pointer is NULL");
+    if (idx > al->size || count > al->size - idx) return ZZ_ERR("Index out of bounds");
+
+    if (newCount > count) {
+        if (newCount - count > SIZE_MAX / al->elSize - al->size) return ZZ_ERR("Range too large");
+        zzOpResult growResult = zzArrayListReserve(al, al->size + (newCount - count));
+        if (ZZ_IS_ERR(growResult)) {
+            return growResult;
+        }
+    }
+
+    char *target = listData(al) + idx * al->elSize;
+    if (al->elemFree) {
+        for (size_t i = 0; i < count; i++) {
+            al->elemFree(target + i * al->elSize);
+        }
+    }
+
+    size_t tail = al->size - idx - count;
+    if (tail > 0 && newCount != count) {
+        memmove(target + newCount * al->elSize, target + count * al->elSize, tail * al->elSize);
+    }
+    if (newCount > 0) {
+        memcpy(target, elems, newCount * al->elSize);
+    }
+    al->size = al->size - count + newCount;
+    return ZZ_OK();
+}
+
 /**
  * @brief Finds the index of the first occurrence of an element.
  *
  * This function searches for the first element in the list that matches the
  * specified element using the provided comparison function. The search proceeds
- * from index 0 to the end of the list.
+ * from index 0 to the end of the list. When cmp is zzCharCompare, zzIntCompare or
+ * zzLongCompare on elements of the matching size, the list is scanned with the
+ * vectorized typed kernels instead of calling cmp for every element.
  *
  * @param[in] al Pointer to the ArrayList to search in
  * @param[in] elem Pointer to the element to search for
@@ -259,8 +613,16 @@ zzOpResult zzArrayListIndexOf(const zzArrayList *al, const void *elem, zzCompare
     if (!cmp) return ZZ_ERR("Comparison function is NULL");
     if (!indexOut) return ZZ_ERR("Index output pointer is NULL");
 
+    zzElemType type;
+    if (zzElemTypeForCompare(cmp, al->elSize, &type)) {
+        size_t idx;
+        zzOpResult res = zzFindTyped(listData(al), al->size, al->elSize, type, elem, &idx);
+        if (ZZ_IS_OK(res)) *indexOut = (int)idx;
+        return res;
+    }
+
     for (size_t i = 0; i < al->size; i++) {
-        void *item = (char*)al->buffer + i * al->elSize;
+        void *item = listData(al) + i * al->elSize;
         if (cmp(item, elem) == 0) {
             *indexOut = (int)i;
             return ZZ_OK();
@@ -269,6 +631,291 @@ zzOpResult zzArrayListIndexOf(const zzArrayList *al, const void *elem, zzCompare
     return ZZ_ERR("Element not found");
 }
 
+/**
+ * @brief Finds the index of the first element equal to the key in an ArrayList of a built-in type.
+ *
+ * This function scans the list with vectorized typed comparisons instead of
+ * calling a comparison function. The element size of the list must match the
+ * size of type.
+ *
+ * @param[in] al Pointer to the ArrayList to search in
+ * @param[in] type Type of the elements stored in the list and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index of the first matching element
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListFindTyped(const zzArrayList *al, zzElemType type, const void *key, size_t *indexOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzFindTyped(listData(al), al->size, al->elSize, type, key, indexOut);
+}
+
+/**
+ * @brief Counts the elements equal to the key in an ArrayList of a built-in type.
+ *
+ * @param[in] al Pointer to the ArrayList to search in
+ * @param[in] type Type of the elements stored in the list and of the key
+ * @param[in] key Pointer to the key to count
+ * @param[out] countOut Pointer receiving the number of matching elements
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListCountTyped(const zzArrayList *al, zzElemType type, const void *key, size_t *countOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzCountTyped(listData(al), al->size, al->elSize, type, key, countOut);
+}
+
+/**
+ * @brief Finds the smallest element of a non-empty ArrayList of a built-in type.
+ *
+ * Floating-point lists must not contain NaNs.
+ *
+ * @param[in] al Pointer to the ArrayList to search in
+ * @param[in] type Type of the elements stored in the list
+ * @param[out] minOut Pointer to a buffer where the smallest element will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListMinTyped(const zzArrayList *al, zzElemType type, void *minOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzMinTyped(listData(al), al->size, al->elSize, type, minOut);
+}
+
+/**
+ * @brief Finds the largest element of a non-empty ArrayList of a built-in type.
+ *
+ * Floating-point lists must not contain NaNs.
+ *
+ * @param[in] al Pointer to the ArrayList to search in
+ * @param[in] type Type of the elements stored in the list
+ * @param[out] maxOut Pointer to a buffer where the largest element will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListMaxTyped(const zzArrayList *al, zzElemType type, void *maxOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzMaxTyped(listData(al), al->size, al->elSize, type, maxOut);
+}
+
+/**
+ * @brief Finds an element equal to the key in a sorted ArrayList.
+ *
+ * This function runs a binary search in O(log n) time and reports the index of
+ * the first element equal to the key. The list must be sorted in the order
+ * defined by cmp.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Comparison function called as cmp(element, key)
+ * @param[out] indexOut Pointer receiving the index of the first matching element
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListBinarySearch(const zzArrayList *al, const void *key, zzCompareFn cmp, size_t *indexOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzBinarySearch(listData(al), al->size, al->elSize, key, cmp, indexOut);
+}
+
+/**
+ * @brief Finds the index of the first element not less than the key in a sorted ArrayList.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Comparison function called as cmp(element, key)
+ * @param[out] indexOut Pointer receiving the index found, or the list size if every element is less than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListLowerBound(const zzArrayList *al, const void *key, zzCompareFn cmp, size_t *indexOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzLowerBound(listData(al), al->size, al->elSize, key, cmp, indexOut);
+}
+
+/**
+ * @brief Finds the index of the first element greater than the key in a sorted ArrayList.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] key Pointer to the key to search for
+ * @param[in] cmp Comparison function called as cmp(element, key)
+ * @param[out] indexOut Pointer receiving the index found, or the list size if no element is greater than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListUpperBound(const zzArrayList *al, const void *key, zzCompareFn cmp, size_t *indexOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzUpperBound(listData(al), al->size, al->elSize, key, cmp, indexOut);
+}
+
+/**
+ * @brief Finds the index of the first element not less than the key in a sorted ArrayList of a built-in type.
+ *
+ * This function compares elements inline as the given type instead of calling a
+ * comparison function. The element size of the list must match the size of type.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] type Type of the elements stored in the list and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index found, or the list size if every element is less than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListLowerBoundTyped(const zzArrayList *al, zzElemType type, const void *key, size_t *indexOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzLowerBoundTyped(listData(al), al->size, al->elSize, type, key, indexOut);
+}
+
+/**
+ * @brief Finds the index of the first element greater than the key in a sorted ArrayList of a built-in type.
+ *
+ * This function compares elements inline as the given type instead of calling a
+ * comparison function. The element size of the list must match the size of type.
+ *
+ * @param[in] al Pointer to the sorted ArrayList to search in
+ * @param[in] type Type of the elements stored in the list and of the key
+ * @param[in] key Pointer to the key to search for
+ * @param[out] indexOut Pointer receiving the index found, or the list size if no element is greater than the key
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListUpperBoundTyped(const zzArrayList *al, zzElemType type, const void *key, size_t *indexOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzUpperBoundTyped(listData(al), al->size, al->elSize, type, key, indexOut);
+}
+
+/**
+ * @brief Inserts an element into a sorted ArrayList at the position that keeps it sorted.
+ *
+ * This function finds the position with a binary search and inserts the element
+ * with a single memmove of the tail, so it runs in O(log n) comparisons plus
+ * O(n) data movement. The element is placed after any elements equal to it,
+ * which keeps insertions of equal elements in arrival order.
+ *
+ * @param[in,out] al Pointer to the sorted ArrayList to insert into
+ * @param[in] elem Pointer to the element to insert (contents will be copied)
+ * @param[in] cmp Comparison function defining the order of elements
+ * @param[out] indexOut Pointer receiving the index the element was inserted at, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListSortedInsert(zzArrayList *al, const void *elem, zzCompareFn cmp, size_t *indexOut) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    if (!elem) return ZZ_ERR("Element pointer is NULL");
+
+    size_t idx;
+    zzOpResult result = zzUpperBound(listData(al), al->size, al->elSize, elem, cmp, &idx);
+    if (ZZ_IS_ERR(result)) return result;
+
+    result = zzArrayListInsert(al, idx, elem);
+    if (ZZ_IS_OK(result) && indexOut) *indexOut = idx;
+    return result;
+}
+
+/**
+ * @brief Sorts the elements of the ArrayList in ascending order.
+ *
+ * This function sorts the list in place with pattern-defeating quicksort in
+ * O(n log n) time. The sort is not stable; use zzArrayListStableSort when equal
+ * elements must keep their order.
+ *
+ * @param[in,out] al Pointer to the ArrayList to sort
+ * @param[in] cmp Comparison function defining the order of elements
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListSort(zzArrayList *al, zzCompareFn cmp) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzSort(listData(al), al->size, al->elSize, cmp);
+}
+
+/**
+ * @brief Sorts the elements of the ArrayList in ascending order, keeping equal elements in order.
+ *
+ * This function sorts the list in place with a merge sort in O(n log n) time,
+ * using a temporary buffer of half the list size.
+ *
+ * @param[in,out] al Pointer to the ArrayList to sort
+ * @param[in] cmp Comparison function defining the order of elements
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListStableSort(zzArrayList *al, zzCompareFn cmp) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzStableSort(listData(al), al->size, al->elSize, cmp);
+}
+
+/**
+ * @brief Sorts a list of built-in numeric elements in ascending order using radix sort.
+ *
+ * This function sorts the list in place by the binary representation of its
+ * elements without calling a comparison function, in O(n) time per byte of the
+ * element type. The element size of the list must match the size of type.
+ *
+ * @param[in,out] al Pointer to the ArrayList to sort
+ * @param[in] type Type of the elements stored in the list
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListRadixSort(zzArrayList *al, zzElemType type) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzRadixSort(listData(al), al->size, al->elSize, type);
+}
+
+/**
+ * @brief Sorts the elements of the ArrayList in ascending order using several threads.
+ *
+ * This function sorts the list in place with zzParallelSort, using up to threads
+ * threads (0 for one per online processor) and a temporary buffer the size of
+ * the list. Lists too small to benefit are sorted on the calling thread. The
+ * sort is not stable.
+ *
+ * @param[in,out] al Pointer to the ArrayList to sort
+ * @param[in] cmp Comparison function defining the order of elements (called concurrently)
+ * @param[in] threads Maximum number of threads to use, or 0 for one per online processor
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListParallelSort(zzArrayList *al, zzCompareFn cmp, size_t threads) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzParallelSort(listData(al), al->size, al->elSize, cmp, threads);
+}
+
+/**
+ * @brief Rearranges the ArrayList so that the element at index nth is the one a full sort would put there.
+ *
+ * This function partially orders the list in place with introselect in O(n)
+ * expected time: no element before nth compares greater than it and no element
+ * after nth compares less than it.
+ *
+ * @param[in,out] al Pointer to the ArrayList to rearrange
+ * @param[in] cmp Comparison function defining the order of elements
+ * @param[in] nth Index of the element to put in its sorted position (0-based)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListNthElement(zzArrayList *al, zzCompareFn cmp, size_t nth) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzNthElement(listData(al), al->size, al->elSize, cmp, nth);
+}
+
+/**
+ * @brief Sorts the k smallest elements of the ArrayList into its first k positions.
+ *
+ * This function runs in O(n + k log k) expected time and leaves the remaining
+ * elements in unspecified order. A k of the list size or more sorts the whole list.
+ *
+ * @param[in,out] al Pointer to the ArrayList to partially sort
+ * @param[in] cmp Comparison function defining the order of elements
+ * @param[in] k Number of leading elements to sort
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListPartialSort(zzArrayList *al, zzCompareFn cmp, size_t k) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzPartialSort(listData(al), al->size, al->elSize, cmp, k);
+}
+
+/**
+ * @brief Copies the k smallest or largest elements of the ArrayList, best first.
+ *
+ * This function leaves the list unchanged and runs in O(n + k log k) expected
+ * time. If the list holds fewer than k elements, all of them are copied.
+ *
+ * @param[in] al Pointer to the ArrayList to select from
+ * @param[in] cmp Comparison function defining the order of elements
+ * @param[in] k Number of elements to return
+ * @param[in] largest Whether to return the largest elements instead of the smallest
+ * @param[out] out Pointer to a buffer with room for k elements receiving the result
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArrayListTopK(const zzArrayList *al, zzCompareFn cmp, size_t k, bool largest, void *out) {
+    if (!al) return ZZ_ERR("ArrayList pointer is NULL");
+    return zzTopK(listData(al), al->size, al->elSize, cmp, k, largest, out);
+}
+
 /**
  * @brief Initializes an iterator for the ArrayList.
  *
@@ -306,7 +953,7 @@ bool zzArrayListIteratorNext(zzArrayListIterator *it, void *valueOut) {
         return false;
     }
     
-    void *elem = (char*)it->list->buffer + it->index * it->list->elSize;
+    void *elem = listData(it->list) + it->index * it->list->elSize;
     memcpy(valueOut, elem, it->list->elSize);
     
     it->index++;
@@ -4,9 +4,21 @@
  */
 
 #include "arraySet.h"
+#include "scan.h"
 #include <string.h>
 #include <stdlib.h>
 
+// Offset of the inline storage from the start of the set in a ZZ_ARRAY_SET_INLINE structure
+#define INLINE_OFFSET \
+    ((sizeof(zzArraySet) + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t))
+
+// Start of the element storage: the heap buffer, the inline storage while the set has
+// not spilled, or NULL for a freed set
+static inline char *setData(const zzArraySet *as) {
+    if (as->buffer) return as->buffer;
+    return as->inlineCap ? (char*)as + INLINE_OFFSET : NULL;
+}
+
 /**
  * @brief Initializes a new ArraySet.
  *
@@ -27,6 +39,7 @@ zzOpResult zzArraySetInit(zzArraySet *as, size_t elSize, size_t capacity, zzEqua
     as->elSize = elSize;
     as->size = 0;
     as->capacity = capacity;
+    as->inlineCap = 0;
     as->equalsFn = equalsFn ? equalsFn : zzDefaultEquals;
     as->elemFree = elemFree;
     as->buffer = malloc(elSize * capacity);
@@ -35,6 +48,35 @@ zzOpResult zzArraySetInit(zzArraySet *as, size_t elSize, size_t capacity, zzEqua
     return ZZ_OK();
 }
 
+/**
+ * @brief Initializes an ArraySet that keeps its first elements in inline storage.
+ *
+ * Initializes the set member of a ZZ_ARRAY_SET_INLINE structure without allocating.
+ * The elements move to a heap buffer once the inline storage is full. If the
+ * storage cannot hold a single element, the set is initialized as by zzArraySetInit.
+ *
+ * @param[out] as Pointer to the set member of a ZZ_ARRAY_SET_INLINE structure
+ * @param[in] inlineBytes Size in bytes of the storage member of that structure
+ * @param[in] elSize Size of each element in bytes
+ * @param[in] equalsFn Function to check element equality (optional, defaults to memcmp)
+ * @param[in] elemFree Function to free individual elements (optional)
+ * @return zzOpResult ZZ_SUCCESS on success, or error on failure
+ */
+zzOpResult zzArraySetInitInline(zzArraySet *as, size_t inlineBytes, size_t elSize, zzEqualsFn equalsFn, zzFreeFn elemFree) {
+    if (!as) return ZZ_ERR("ArraySet pointer is NULL");
+    if (elSize == 0) return ZZ_ERR("Element size cannot be zero");
+    if (inlineBytes < elSize) return zzArraySetInit(as, elSize, 0, equalsFn, elemFree);
+
+    as->buffer = NULL;
+    as->elSize = elSize;
+    as->size = 0;
+    as->capacity = inlineBytes / elSize;
+    as->inlineCap = as->capacity;
+    as->equalsFn = equalsFn ? equalsFn : zzDefaultEquals;
+    as->elemFree = elemFree;
+    return ZZ_OK();
+}
+
 /**
  * @brief Frees the ArraySet and its elements.
  *
@@ -43,17 +85,18 @@ zzOpResult zzArraySetInit(zzArraySet *as, size_t elSize, size_t capacity, zzEqua
  * @param[in,out] as Pointer to the ArraySet to free
  */
 void zzArraySetFree(zzArraySet *as) {
-    if (!as || !as->buffer) return;
+    if (!as || !setData(as)) return;
 
     if (as->elemFree) {
         for (size_t i = 0; i < as->size; i++) {
-            void *elem = (char*)as->buffer + i * as->elSize;
+            void *elem = setData(as) + i * as->elSize;
             as->elemFree(elem);
         }
     }
     free(as->buffer);
     as->buffer = NULL;
     as->size = 0;
+    as->capacity = as->inlineCap;
 }
 
 /**
@@ -63,18 +106,51 @@ void zzArraySetFree(zzArraySet *as) {
  * @return zzOpResult ZZ_SUCCESS on success
  */
 static zzOpResult zzArraySetGrow(zzArraySet *as) {
-    size_t newCap = as->capacity * 2;
-    void *newBuf = realloc(as->buffer, as->elSize * newCap);
+    size_t newCap = as->capacity ? as->capacity * 2 : 4;
+    void *newBuf;
+    if (as->buffer || as->inlineCap == 0) {
+        newBuf = realloc(as->buffer, as->elSize * newCap);
+    } else {
+        // First spill: move the elements out of the inline storage
+        newBuf = malloc(as->elSize * newCap);
+        if (newBuf) memcpy(newBuf, setData(as), as->size * as->elSize);
+    }
     if (!newBuf) return ZZ_ERR("Failed to grow buffer");
     as->buffer = newBuf;
     as->capacity = newCap;
     return ZZ_OK();
 }
 
+/**
+ * @brief Internal function to find the index of an element.
+ *
+ * Uses the vectorized typed scan when the set compares elements with one of the
+ * built-in equality functions, and calls equalsFn on every element otherwise.
+ *
+ * @param[in] as Pointer to the ArraySet
+ * @param[in] elem Element to find
+ * @return Index of the element, or the set size if it is not present
+ */
+static size_t zzArraySetIndexOf(const zzArraySet *as, const void *elem) {
+    zzElemType type;
+    size_t idx;
+    if (zzElemTypeForEquals(as->equalsFn, as->elSize, &type)) {
+        zzOpResult res = zzFindTyped(setData(as), as->size, as->elSize, type, elem, &idx);
+        return ZZ_IS_OK(res) ? idx : as->size;
+    }
+
+    for (idx = 0; idx < as->size; idx++) {
+        void *current = setData(as) + idx * as->elSize;
+        if (as->equalsFn(current, elem)) break;
+    }
+    return idx;
+}
+
 /**
  * @brief Checks if the set contains an element.
  *
- * Performs a linear scan to find the element.
+ * Performs a linear scan to find the element, vectorized for sets of built-in
+ * types that use the matching equality function from utils.h.
  *
  * @param[in] as Pointer to the ArraySet
  * @param[in] elem Element to check
@@ -82,11 +158,7 @@ static zzOpResult zzArraySetGrow(zzArraySet *as) {
  */
 bool zzArraySetContains(const zzArraySet *as, const void *elem) {
     if (!as || !elem) return false;
-    for (size_t i = 0; i < as->size; i++) {
-        void *current = (char*)as->buffer + i * as->elSize;
-        if (as->equalsFn(current, elem)) return true;
-    }
-    return false;
+    return zzArraySetIndexOf(as, elem) < as->size;
 }
 
 /**
@@ -111,7 +183,7 @@ zzOpResult zzArraySetAdd(zzArraySet *as, const void *elem) {
         if (ZZ_IS_ERR(grow)) return grow;
     }
 
-    memcpy((char*)as->buffer + as->size * as->elSize, elem, as->elSize);
+    memcpy(setData(as) + as->size * as->elSize, elem, as->elSize);
     as->size++;
     return ZZ_OK();
 }
@@ -127,20 +199,19 @@ zzOpResult zzArraySetAdd(zzArraySet *as, const void *elem) {
  */
 zzOpResult zzArraySetRemove(zzArraySet *as, const void *elem) {
     if (!as) return ZZ_ERR("ArraySet pointer is NULL");
-    
-    for (size_t i = 0; i < as->size; i++) {
-        void *current = (char*)as->buffer + i * as->elSize;
-        if (as->equalsFn(current, elem)) {
-            if (as->elemFree) as->elemFree(current);
-            
-            if (i < as->size - 1) {
-                memmove(current, (char*)current + as->elSize, (as->size - i - 1) * as->elSize);
-            }
-            as->size--;
-            return ZZ_OK();
-        }
+    if (!elem) return ZZ_ERR("Element pointer is NULL");
+
+    size_t i = zzArraySetIndexOf(as, elem);
+    if (i == as->size) return ZZ_ERR("Element not found");
+
+    void *current = setData(as) + i * as->elSize;
+    if (as->elemFree) as->elemFree(current);
+
+    if (i < as->size - 1) {
+        memmove(current, (char*)current + as->elSize, (as->size - i - 1) * as->elSize);
     }
-    return ZZ_ERR("Element not found");
+    as->size--;
+    return ZZ_OK();
 }
 
 /**
@@ -156,10 +227,39 @@ zzOpResult zzArraySetRemove(zzArraySet *as, const void *elem) {
 zzOpResult zzArraySetGet(const zzArraySet *as, size_t idx, void *out) {
     if (!as) return ZZ_ERR("ArraySet pointer is NULL");
     if (idx >= as->size) return ZZ_ERR("Index out of bounds");
-    memcpy(out, (char*)as->buffer + idx * as->elSize, as->elSize);
+    memcpy(out, setData(as) + idx * as->elSize, as->elSize);
     return ZZ_OK();
 }
 
+/**
+ * @brief Returns a read-only pointer to the contiguous storage of the ArraySet.
+ *
+ * Provides the size elements back to back without copying. The elements must not
+ * be modified in place, since that could break uniqueness. The pointer is
+ * invalidated by Add, Remove and Clear.
+ *
+ * @param[in] as Pointer to the ArraySet
+ * @return Pointer to the first element, or NULL if as is NULL
+ */
+const void *zzArraySetData(const zzArraySet *as) {
+    return as ? setData(as) : NULL;
+}
+
+/**
+ * @brief Returns a read-only pointer to the element at a specific index.
+ *
+ * Zero-copy counterpart of zzArraySetGet. The same invalidation rules as for
+ * zzArraySetData apply.
+ *
+ * @param[in] as Pointer to the ArraySet
+ * @param[in] idx Index of the element
+ * @return Pointer to the element, or NULL if as is NULL or idx is out of bounds
+ */
+const void *zzArraySetAt(const zzArraySet *as, size_t idx) {
+    if (!as || idx >= as->size) return NULL;
+    return setData(as) + idx * as->elSize;
+}
+
 /**
  * @brief Clears the set.
  *
@@ -171,12 +271,82 @@ void zzArraySetClear(zzArraySet *as) {
     if (!as) return;
     if (as->elemFree) {
         for (size_t i = 0; i < as->size; i++) {
-            as->elemFree((char*)as->buffer + i * as->elSize);
+            as->elemFree(setData(as) + i * as->elSize);
         }
     }
     as->size = 0;
 }
 
+// Frees the elements for which pred returns verdict and closes the gaps in one stable pass,
+// moving each run of surviving elements with a single memmove
+static size_t zzArraySetRemoveMatching(zzArraySet *as, zzPredicateFn pred, void *userdata, bool verdict) {
+    char *buf = setData(as);
+    const size_t es = as->elSize, count = as->size;
+    size_t write = 0, runStart = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        char *elem = buf + i * es;
+        if (pred(elem, userdata) != verdict) continue;
+
+        if (runStart < i) {
+            if (write != runStart) memmove(buf + write * es, buf + runStart * es, (i - runStart) * es);
+            write += i - runStart;
+        }
+        runStart = i + 1;
+        if (as->elemFree) as->elemFree(elem);
+    }
+    if (runStart < count) {
+        if (write != runStart) memmove(buf + write * es, buf + runStart * es, (count - runStart) * es);
+        write += count - runStart;
+    }
+
+    as->size = write;
+    return count - write;
+}
+
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * Tests each element once and compacts the survivors in a single stable pass,
+ * so it runs in O(n) time however many elements are removed. Calls elemFree on
+ * every removed element if provided. The predicate must not modify the set.
+ *
+ * @param[in,out] as Pointer to the ArraySet to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArraySetRemoveIf(zzArraySet *as, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!as) return ZZ_ERR("ArraySet pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzArraySetRemoveMatching(as, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzArraySetRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] as Pointer to the ArraySet to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzArraySetRetainIf(zzArraySet *as, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!as) return ZZ_ERR("ArraySet pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzArraySetRemoveMatching(as, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Initializes an iterator for the ArraySet.
  *
@@ -208,7 +378,7 @@ bool zzArraySetIteratorNext(zzArraySetIterator *it, void *valueOut) {
         return false;
     }
 
-    void *elem = (char*)it->set->buffer + it->index * it->set->elSize;
+    void *elem = setData(it->set) + it->index * it->set->elSize;
     memcpy(valueOut, elem, it->set->elSize);
     
     it->index++;
@@ -242,7 +412,7 @@ zzOpResult zzArraySetIteratorRemove(zzArraySetIterator *it) {
     size_t removeIdx = it->index - 1;
     zzArraySet *as = it->set;
     
-    void *target = (char*)as->buffer + removeIdx * as->elSize;
+    void *target = setData(as) + removeIdx * as->elSize;
     if (as->elemFree) as->elemFree(target);
 
     if (removeIdx < as->size - 1) {
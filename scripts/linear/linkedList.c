@@ -315,6 +315,72 @@ void zzLinkedListClear(zzLinkedList *ll) {
     ll->size = 0;
 }
 
+// Unlinks and frees the nodes for which pred returns verdict in one walk from head to tail
+static size_t zzLinkedListRemoveMatching(zzLinkedList *ll, zzPredicateFn pred, void *userdata, bool verdict) {
+    size_t removed = 0;
+    DLNode *cur = ll->head;
+    while (cur) {
+        DLNode *next = cur->next;
+        if (pred(cur->data, userdata) == verdict) {
+            if (cur->prev) cur->prev->next = next;
+            else ll->head = next;
+            if (next) next->prev = cur->prev;
+            else ll->tail = cur->prev;
+
+            if (ll->elemFree) ll->elemFree(cur->data);
+            free(cur);
+            removed++;
+        }
+        cur = next;
+    }
+    ll->size -= removed;
+    return removed;
+}
+
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, from head to tail, and unlinks the
+ * matching nodes during the same traversal, so it runs in O(n) time however many
+ * elements are removed. If a custom free function was provided, it is called on
+ * every removed element. The predicate must not modify the list.
+ *
+ * @param[in,out] ll Pointer to the LinkedList to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedListRemoveIf(zzLinkedList *ll, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!ll) return ZZ_ERR("LinkedList pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzLinkedListRemoveMatching(ll, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzLinkedListRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) traversal.
+ *
+ * @param[in,out] ll Pointer to the LinkedList to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedListRetainIf(zzLinkedList *ll, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!ll) return ZZ_ERR("LinkedList pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzLinkedListRemoveMatching(ll, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Initializes an iterator for the LinkedList.
  *
@@ -273,6 +273,79 @@ void zzLinkedHashMapClear(zzLinkedHashMap *lhm) {
     lhm->size = 0;
 }
 
+// Unlinks and frees the entries for which pred returns verdict in one walk in insertion order.
+// A removed node is found in its bucket chain through its cached hash.
+static size_t zzLinkedHashMapRemoveMatching(zzLinkedHashMap *lhm, zzEntryPredicateFn pred, void *userdata, bool verdict) {
+    size_t removed = 0;
+    LHMapNode *node = lhm->head;
+    while (node) {
+        LHMapNode *next = node->next;
+        if (pred(node->data, node->data + lhm->keySize, userdata) == verdict) {
+            LHMapNode **hashCur = &lhm->buckets[node->hash % lhm->capacity];
+            while (*hashCur != node) hashCur = &(*hashCur)->hashNext;
+            *hashCur = node->hashNext;
+
+            if (node->prev) node->prev->next = next;
+            else lhm->head = next;
+            if (next) next->prev = node->prev;
+            else lhm->tail = node->prev;
+
+            if (lhm->keyFree) lhm->keyFree(node->data);
+            if (lhm->valueFree) lhm->valueFree(node->data + lhm->keySize);
+            free(node);
+            removed++;
+        }
+        node = next;
+    }
+    lhm->size -= removed;
+    return removed;
+}
+
+/**
+ * @brief Removes every entry for which the predicate returns true.
+ *
+ * This function tests each key-value pair once, in insertion order, and unlinks
+ * the matching nodes from both the hash table and the insertion order list during
+ * the same traversal, so it runs in O(n) expected time however many entries are
+ * removed. If custom free functions were provided, they are called on the key and
+ * value of every removed entry. The predicate must not modify the map.
+ *
+ * @param[in,out] lhm Pointer to the LinkedHashMap to filter
+ * @param[in] pred Function selecting the entries to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedHashMapRemoveIf(zzLinkedHashMap *lhm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!lhm) return ZZ_ERR("LinkedHashMap pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzLinkedHashMapRemoveMatching(lhm, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the entries for which the predicate returns true.
+ *
+ * This function is the complement of zzLinkedHashMapRemoveIf and removes every entry
+ * that does not satisfy the predicate in the same single traversal.
+ *
+ * @param[in,out] lhm Pointer to the LinkedHashMap to filter
+ * @param[in] pred Function selecting the entries to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedHashMapRetainIf(zzLinkedHashMap *lhm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!lhm) return ZZ_ERR("LinkedHashMap pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzLinkedHashMapRemoveMatching(lhm, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Gets the first key-value pair in insertion order from the LinkedHashMap.
  *
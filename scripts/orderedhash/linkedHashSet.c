@@ -226,6 +226,78 @@ void zzLinkedHashSetClear(zzLinkedHashSet *lhs) {
     lhs->size = 0;
 }
 
+// Unlinks and frees the keys for which pred returns verdict in one walk in insertion order.
+// A removed node is found in its bucket chain through its cached hash.
+static size_t zzLinkedHashSetRemoveMatching(zzLinkedHashSet *lhs, zzPredicateFn pred, void *userdata, bool verdict) {
+    size_t removed = 0;
+    LHSetNode *node = lhs->head;
+    while (node) {
+        LHSetNode *next = node->next;
+        if (pred(node->key, userdata) == verdict) {
+            LHSetNode **hashCur = &lhs->buckets[node->hash % lhs->capacity];
+            while (*hashCur != node) hashCur = &(*hashCur)->hashNext;
+            *hashCur = node->hashNext;
+
+            if (node->prev) node->prev->next = next;
+            else lhs->head = next;
+            if (next) next->prev = node->prev;
+            else lhs->tail = node->prev;
+
+            if (lhs->keyFree) lhs->keyFree(node->key);
+            free(node);
+            removed++;
+        }
+        node = next;
+    }
+    lhs->size -= removed;
+    return removed;
+}
+
+/**
+ * @brief Removes every key for which the predicate returns true.
+ *
+ * This function tests each key once, in insertion order, and unlinks the
+ * matching nodes from both the hash table and the insertion order list during
+ * the same traversal, so it runs in O(n) expected time however many keys are
+ * removed. If a custom free function was provided, it is called on every removed
+ * key. The predicate must not modify the set.
+ *
+ * @param[in,out] lhs Pointer to the LinkedHashSet to filter
+ * @param[in] pred Function selecting the keys to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedHashSetRemoveIf(zzLinkedHashSet *lhs, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!lhs) return ZZ_ERR("LinkedHashSet pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzLinkedHashSetRemoveMatching(lhs, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the keys for which the predicate returns true.
+ *
+ * This function is the complement of zzLinkedHashSetRemoveIf and removes every key
+ * that does not satisfy the predicate in the same single traversal.
+ *
+ * @param[in,out] lhs Pointer to the LinkedHashSet to filter
+ * @param[in] pred Function selecting the keys to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzLinkedHashSetRetainIf(zzLinkedHashSet *lhs, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!lhs) return ZZ_ERR("LinkedHashSet pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzLinkedHashSetRemoveMatching(lhs, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Gets the first key in insertion order from the LinkedHashSet.
  *
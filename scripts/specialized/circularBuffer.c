@@ -130,6 +130,51 @@ zzOpResult zzCircularBufferGet(const zzCircularBuffer *cb, size_t idx, void *out
     return ZZ_OK();
 }
 
+/**
+ * @brief Returns a pointer to the element at the specified index.
+ *
+ * This function gives direct access to the element inside the circular buffer
+ * instead of copying it out. The index is relative to the logical order of
+ * elements (from oldest to newest). The element may be modified through the pointer,
+ * which stays valid until the buffer is next modified.
+ *
+ * @param[in] cb Pointer to the CircularBuffer
+ * @param[in] idx Index of the element (0-based, 0 is the oldest)
+ * @return Pointer to the element, or NULL if cb is NULL or idx is out of bounds
+ */
+void *zzCircularBufferAt(const zzCircularBuffer *cb, size_t idx) {
+    if (!cb || idx >= cb->size) return NULL;
+    return (char*)cb->buffer + ((cb->head + idx) % cb->capacity) * cb->elSize;
+}
+
+/**
+ * @brief Describes the contents of the CircularBuffer as at most two contiguous spans.
+ *
+ * The elements occupy one run of the circular buffer, or two runs when they
+ * wrap around its end. Reading spans[0] and then spans[1] visits every element
+ * in logical order (from oldest to newest) without copying, so the spans can be
+ * passed directly to vectored I/O such as writev(). Unused spans are set to
+ * { NULL, 0 }. The spans stay valid until the buffer is next modified.
+ *
+ * @param[in] cb Pointer to the CircularBuffer
+ * @param[out] spans Array of two spans receiving the contents
+ * @return Number of non-empty spans written (0, 1 or 2)
+ */
+size_t zzCircularBufferSpans(const zzCircularBuffer *cb, zzSpan spans[2]) {
+    if (!spans) return 0;
+    spans[0] = (zzSpan){ NULL, 0 };
+    spans[1] = (zzSpan){ NULL, 0 };
+    if (!cb || cb->size == 0) return 0;
+
+    size_t firstCount = cb->capacity - cb->head;
+    if (firstCount > cb->size) firstCount = cb->size;
+    spans[0] = (zzSpan){ (char*)cb->buffer + cb->head * cb->elSize, firstCount };
+    if (firstCount == cb->size) return 1;
+
+    spans[1] = (zzSpan){ cb->buffer, cb->size - firstCount };
+    return 2;
+}
+
 /**
  * @brief Peeks at the element at the front of the CircularBuffer without removing it.
  *
@@ -193,6 +238,73 @@ void zzCircularBufferClear(zzCircularBuffer *cb) {
     cb->size = 0;
 }
 
+// Frees the elements for which pred returns verdict and shifts the survivors towards the
+// head in one stable pass over the logical order
+static size_t zzCircularBufferRemoveMatching(zzCircularBuffer *cb, zzPredicateFn pred, void *userdata, bool verdict) {
+    char *buf = cb->buffer;
+    const size_t es = cb->elSize, cap = cb->capacity, count = cb->size;
+    size_t write = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        char *elem = buf + ((cb->head + i) % cap) * es;
+        if (pred(elem, userdata) == verdict) {
+            if (cb->elemFree) cb->elemFree(elem);
+            continue;
+        }
+        if (write != i) memcpy(buf + ((cb->head + write) % cap) * es, elem, es);
+        write++;
+    }
+
+    cb->size = write;
+    cb->tail = (cb->head + write) % cap;
+    return count - write;
+}
+
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, from oldest to newest, and compacts
+ * the survivors towards the oldest position in a single stable pass, so it runs
+ * in O(n) time however many elements are removed. If a custom free function was
+ * provided, it is called on every removed element. The predicate must not modify
+ * the buffer.
+ *
+ * @param[in,out] cb Pointer to the CircularBuffer to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzCircularBufferRemoveIf(zzCircularBuffer *cb, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!cb) return ZZ_ERR("CircularBuffer pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzCircularBufferRemoveMatching(cb, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzCircularBufferRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] cb Pointer to the CircularBuffer to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzCircularBufferRetainIf(zzCircularBuffer *cb, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!cb) return ZZ_ERR("CircularBuffer pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzCircularBufferRemoveMatching(cb, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Initializes an iterator for the CircularBuffer.
  *
@@ -57,7 +57,7 @@ void zzPriorityQueueFree(zzPriorityQueue *pq) {
 }
 
 static zzOpResult zzPriorityQueueResize(zzPriorityQueue *pq) {
-    size_t newCap = pq->capacity * 2;
+    size_t newCap = pq->capacity ? pq->capacity * 2 : 16;
     void *newBuf = realloc(pq->buffer, pq->elSize * newCap);
     if (!newBuf) return ZZ_ERR("Failed to grow buffer (realloc failed)");
     pq->buffer = newBuf;
@@ -145,6 +145,64 @@ zzOpResult zzPriorityQueuePush(zzPriorityQueue *pq, const void *elem) {
     return ZZ_OK();
 }
 
+/**
+ * @brief Transfers ownership of the PriorityQueue's buffer to the caller.
+ *
+ * This function hands out the underlying buffer without copying it. The size
+ * elements are stored contiguously in heap order, not in sorted order: the first
+ * element is the minimum. The caller becomes responsible for the elements and
+ * must release the buffer with free(); the free function of the queue is not
+ * called. The queue is left empty with no storage and can be reused: it
+ * allocates a new buffer on the next push.
+ *
+ * @param[in,out] pq Pointer to the PriorityQueue to detach the buffer from
+ * @param[out] bufferOut Pointer receiving the buffer, or NULL if the queue had no storage
+ * @param[out] sizeOut Pointer receiving the number of elements in the buffer
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPriorityQueueDetach(zzPriorityQueue *pq, void **bufferOut, size_t *sizeOut) {
+    if (!pq) return ZZ_ERR("PriorityQueue pointer is NULL");
+    if (!bufferOut) return ZZ_ERR("Buffer output pointer is NULL");
+    if (!sizeOut) return ZZ_ERR("Size output pointer is NULL");
+
+    *bufferOut = pq->buffer;
+    *sizeOut = pq->size;
+    pq->buffer = NULL;
+    pq->size = 0;
+    pq->capacity = 0;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Makes the PriorityQueue take ownership of an existing buffer and heapifies it in place.
+ *
+ * This function replaces the contents of an initialized queue with the first size
+ * elements of a buffer allocated with malloc, calloc or realloc and room for
+ * capacity elements of the queue's element size. The elements may be in any
+ * order; they are arranged into a heap bottom-up in O(n) time, which is cheaper
+ * than pushing them one by one. The current elements are released first as by
+ * zzPriorityQueueFree. From then on the queue owns the buffer: it may reallocate
+ * it and frees it together with the queue.
+ *
+ * @param[in,out] pq Pointer to an initialized PriorityQueue
+ * @param[in] buffer Heap buffer to adopt, or NULL to leave the queue empty with no storage
+ * @param[in] size Number of elements stored at the start of the buffer
+ * @param[in] capacity Number of elements the buffer has room for (must be at least size)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPriorityQueueAdopt(zzPriorityQueue *pq, void *buffer, size_t size, size_t capacity) {
+    if (!pq) return ZZ_ERR("PriorityQueue pointer is NULL");
+    if (!buffer && capacity > 0) return ZZ_ERR("Buffer pointer is NULL");
+    if (size > capacity) return ZZ_ERR("Size exceeds capacity");
+
+    zzPriorityQueueFree(pq);
+    pq->buffer = buffer;
+    pq->size = size;
+    pq->capacity = capacity;
+    for (size_t i = size / 2; i-- > 0;) heapifyDown(pq, i);
+    return ZZ_OK();
+}
+
 /**
  * @brief Pops the highest priority element from the PriorityQueue.
  *
@@ -215,6 +273,80 @@ void zzPriorityQueueClear(zzPriorityQueue *pq) {
     pq->size = 0;
 }
 
+// Frees the elements for which pred returns verdict and closes the gaps in one stable pass,
+// moving each run of surviving elements with a single memmove
+static size_t zzPriorityQueueRemoveMatching(zzPriorityQueue *pq, zzPredicateFn pred, void *userdata, bool verdict) {
+    char *buf = pq->buffer;
+    const size_t es = pq->elSize, count = pq->size;
+    size_t write = 0, runStart = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        char *elem = buf + i * es;
+        if (pred(elem, userdata) != verdict) continue;
+
+        if (runStart < i) {
+            if (write != runStart) memmove(buf + write * es, buf + runStart * es, (i - runStart) * es);
+            write += i - runStart;
+        }
+        runStart = i + 1;
+        if (pq->elemFree) pq->elemFree(elem);
+    }
+    if (runStart < count) {
+        if (write != runStart) memmove(buf + write * es, buf + runStart * es, (count - runStart) * es);
+        write += count - runStart;
+    }
+
+    pq->size = write;
+    if (write < count) {
+        for (size_t i = write / 2; i-- > 0;) heapifyDown(pq, i);
+    }
+    return count - write;
+}
+
+/**
+ * @brief Removes every element for which the predicate returns true.
+ *
+ * This function tests each element once, in heap order, compacts the survivors
+ * and then restores the heap property bottom-up, so it runs in O(n) time however
+ * many elements are removed. If a custom free function was provided, it is
+ * called on every removed element. The predicate must not modify the queue.
+ *
+ * @param[in,out] pq Pointer to the PriorityQueue to filter
+ * @param[in] pred Function selecting the elements to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPriorityQueueRemoveIf(zzPriorityQueue *pq, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!pq) return ZZ_ERR("PriorityQueue pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzPriorityQueueRemoveMatching(pq, pred, userdata, true);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Keeps only the elements for which the predicate returns true.
+ *
+ * This function is the complement of zzPriorityQueueRemoveIf and removes every element
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] pq Pointer to the PriorityQueue to filter
+ * @param[in] pred Function selecting the elements to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed elements, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPriorityQueueRetainIf(zzPriorityQueue *pq, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!pq) return ZZ_ERR("PriorityQueue pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+
+    size_t removed = zzPriorityQueueRemoveMatching(pq, pred, userdata, false);
+    if (removedOut) *removedOut = removed;
+    return ZZ_OK();
+}
+
 /**
  * @brief Initializes an iterator for the PriorityQueue.
  *
@@ -0,0 +1,233 @@
+#include "frozenTreeSet.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define SLOT_PTR(fs, k) ((fs)->keys + (k) * (fs)->keySize)
+
+// A search prefetches the block holding the 16 descendants four levels below the current slot
+#define PREFETCH_LEVELS 4
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr) ((void)(addr))
+#endif
+
+static unsigned trailingZeros(size_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll((unsigned long long)x);
+#else
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// Copies the keys in sorted order into the subtree of slot k, visiting the slots in order
+static void fillSlots(zzFrozenTreeSet *fs, zzTreeSetIterator *it, size_t k) {
+    if (k > fs->size) return;
+    fillSlots(fs, it, 2 * k);
+    zzTreeSetIteratorNext(it, SLOT_PTR(fs, k));
+    fillSlots(fs, it, 2 * k + 1);
+}
+
+/**
+ * @brief Creates a frozen copy of a TreeSet in Eytzinger layout.
+ *
+ * This function copies every key of the set into a single array in breadth-first
+ * order in O(n) time. The source set is not modified and can be changed or freed
+ * afterwards, as long as keys that point to other memory stay valid.
+ *
+ * @param[in] ts Pointer to the TreeSet to freeze
+ * @param[out] fs Pointer to the frozen set structure to initialize
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetFreeze(const zzTreeSet *ts, zzFrozenTreeSet *fs) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!fs) return ZZ_ERR("FrozenTreeSet pointer is NULL");
+
+    fs->keys = NULL;
+    fs->size = ts->size;
+    fs->keySize = ts->keySize;
+    fs->compareFn = ts->compareFn;
+    if (ts->size == 0) return ZZ_OK();
+
+    fs->keys = malloc((ts->size + 1) * ts->keySize);
+    if (!fs->keys) {
+        fs->size = 0;
+        return ZZ_ERR("Memory allocation failed");
+    }
+
+    // The iterator only reads the set, so it may borrow it without const
+    zzTreeSetIterator it;
+    zzTreeSetIteratorInit(&it, (zzTreeSet*)ts);
+    fillSlots(fs, &it, 1);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Frees the memory held by a frozen tree set.
+ *
+ * @param[in,out] fs Pointer to the frozen set to free
+ */
+void zzFrozenTreeSetFree(zzFrozenTreeSet *fs) {
+    if (!fs) return;
+    free(fs->keys);
+    fs->keys = NULL;
+    fs->size = 0;
+}
+
+// Walks down to a leaf position, turning right whenever the slot's key compares below bias.
+// With bias 0 the path turns right on keys smaller than key, with bias 1 also on equal keys.
+static size_t descend(const zzFrozenTreeSet *fs, const void *key, int bias) {
+    size_t k = 1;
+    while (k <= fs->size) {
+        size_t ahead = k << PREFETCH_LEVELS;
+        PREFETCH(SLOT_PTR(fs, ahead <= fs->size ? ahead : 0));
+        k = 2 * k + (fs->compareFn(SLOT_PTR(fs, k), key) < bias);
+    }
+    return k;
+}
+
+// Slot of the smallest key >= key, or 0: the last node where the path turned left
+static size_t ceilingSlot(const zzFrozenTreeSet *fs, const void *key) {
+    size_t k = descend(fs, key, 0);
+    return k >> (trailingZeros(~k) + 1);
+}
+
+// Slot of the largest key <= key, or 0: the last node where the path turned right
+static size_t floorSlot(const zzFrozenTreeSet *fs, const void *key) {
+    size_t k = descend(fs, key, 1);
+    return k >> (trailingZeros(k) + 1);
+}
+
+/**
+ * @brief Checks if the frozen tree set contains the specified key.
+ *
+ * @param[in] fs Pointer to the frozen set to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the set, false otherwise
+ */
+bool zzFrozenTreeSetContains(const zzFrozenTreeSet *fs, const void *key) {
+    if (!fs || !key || fs->size == 0) return false;
+
+    size_t k = ceilingSlot(fs, key);
+    return k != 0 && fs->compareFn(SLOT_PTR(fs, k), key) == 0;
+}
+
+/**
+ * @brief Finds the smallest key greater than or equal to the given key.
+ *
+ * @param[in] fs Pointer to the frozen set to search
+ * @param[in] key Pointer to the key to search for
+ * @param[out] keyOut Pointer to a buffer where the key found will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzFrozenTreeSetCeiling(const zzFrozenTreeSet *fs, const void *key, void *keyOut) {
+    if (!fs) return ZZ_ERR("FrozenTreeSet pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!keyOut) return ZZ_ERR("Key output pointer is NULL");
+    if (fs->size == 0) return ZZ_ERR("Set is empty");
+
+    size_t k = ceilingSlot(fs, key);
+    if (k == 0) return ZZ_ERR("No key is greater than or equal to the given key");
+    memcpy(keyOut, SLOT_PTR(fs, k), fs->keySize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Finds the largest key less than or equal to the given key.
+ *
+ * @param[in] fs Pointer to the frozen set to search
+ * @param[in] key Pointer to the key to search for
+ * @param[out] keyOut Pointer to a buffer where the key found will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzFrozenTreeSetFloor(const zzFrozenTreeSet *fs, const void *key, void *keyOut) {
+    if (!fs) return ZZ_ERR("FrozenTreeSet pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!keyOut) return ZZ_ERR("Key output pointer is NULL");
+    if (fs->size == 0) return ZZ_ERR("Set is empty");
+
+    size_t k = floorSlot(fs, key);
+    if (k == 0) return ZZ_ERR("No key is less than or equal to the given key");
+    memcpy(keyOut, SLOT_PTR(fs, k), fs->keySize);
+    return ZZ_OK();
+}
+
+// Slot of the smallest key in the subtree of slot k
+static size_t leftmostSlot(const zzFrozenTreeSet *fs, size_t k) {
+    while (2 * k <= fs->size) k *= 2;
+    return k;
+}
+
+/**
+ * @brief Initializes an iterator positioned at the smallest key of the frozen set.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] fs Pointer to the frozen set to iterate over
+ */
+void zzFrozenTreeSetIteratorInit(zzFrozenTreeSetIterator *it, const zzFrozenTreeSet *fs) {
+    if (!it || !fs) return;
+
+    it->set = fs;
+    it->slot = fs->size > 0 ? leftmostSlot(fs, 1) : 0;
+    it->state = it->slot ? ZZ_ITER_VALID : ZZ_ITER_END;
+}
+
+/**
+ * @brief Repositions the iterator at the first key greater than or equal to the given key.
+ *
+ * @param[in,out] it Pointer to the iterator to reposition
+ * @param[in] key Pointer to the lower bound of the keys to iterate
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzFrozenTreeSetIteratorSeek(zzFrozenTreeSetIterator *it, const void *key) {
+    if (!it || !it->set) return ZZ_ERR("Invalid iterator state");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+
+    it->slot = it->set->size > 0 ? ceilingSlot(it->set, key) : 0;
+    it->state = it->slot ? ZZ_ITER_VALID : ZZ_ITER_END;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Advances the iterator to the next key.
+ *
+ * This function copies the current key to the output buffer and moves the
+ * iterator to the next key in sorted order. Returns false when the iterator
+ * reaches the end of the set.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] keyOut Pointer to a buffer where the current key will be copied
+ * @return true if a key was retrieved, false if the iterator reached the end
+ */
+bool zzFrozenTreeSetIteratorNext(zzFrozenTreeSetIterator *it, void *keyOut) {
+    if (!it || !keyOut || it->state != ZZ_ITER_VALID) return false;
+
+    const zzFrozenTreeSet *fs = it->set;
+    size_t k = it->slot;
+    memcpy(keyOut, SLOT_PTR(fs, k), fs->keySize);
+
+    // The successor is the leftmost slot of the right subtree, or else the parent
+    // of the topmost ancestor reached by climbing out of right children
+    if (2 * k + 1 <= fs->size) k = leftmostSlot(fs, 2 * k + 1);
+    else k >>= trailingZeros(~k) + 1;
+
+    it->slot = k;
+    if (!k) it->state = ZZ_ITER_END;
+    return true;
+}
+
+/**
+ * @brief Checks if the iterator has more elements.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more elements, false otherwise
+ */
+bool zzFrozenTreeSetIteratorHasNext(const zzFrozenTreeSetIterator *it) {
+    return it && it->state == ZZ_ITER_VALID && it->slot != 0;
+}
\ No newline at end of file
@@ -0,0 +1,387 @@
+#include "intervalTree.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define START_PTR(node) ((node)->data)
+#define END_PTR(t, node) ((node)->data + (t)->endpointSize)
+#define MAX_END_PTR(t, node) ((node)->data + 2 * (t)->endpointSize)
+#define VAL_PTR(t, node) ((node)->data + valueOffset(t))
+
+// The value is placed at a max_align_t boundary after the three end points
+static size_t valueOffset(const zzIntervalTree *t) {
+    const size_t align = _Alignof(max_align_t);
+    return (3 * t->endpointSize + align - 1) / align * align;
+}
+
+/**
+ * @brief Initializes a new interval tree with the specified end point and value sizes.
+ *
+ * This function initializes an empty interval tree. End points are copied by
+ * value and ordered by compareFn.
+ *
+ * @param[out] t Pointer to the interval tree structure to initialize
+ * @param[in] endpointSize Size in bytes of each start and end point
+ * @param[in] valueSize Size in bytes of each value that will be stored in the tree
+ * @param[in] compareFn Function to compare end points (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] valueFree Function to free value memory when intervals are removed or the tree is freed, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeInit(zzIntervalTree *t, size_t endpointSize, size_t valueSize, zzCompareFn compareFn, zzFreeFn valueFree) {
+    if (!t) return ZZ_ERR("IntervalTree pointer is NULL");
+    if (endpointSize == 0) return ZZ_ERR("Endpoint size cannot be zero");
+    if (valueSize == 0) return ZZ_ERR("Value size cannot be zero");
+    if (!compareFn) return ZZ_ERR("Comparison function is NULL");
+
+    t->root = NULL;
+    t->size = 0;
+    t->endpointSize = endpointSize;
+    t->valueSize = valueSize;
+    t->compareFn = compareFn;
+    t->valueFree = valueFree;
+    return ZZ_OK();
+}
+
+static void freeSubtree(zzIntervalTree *t, IntervalTreeNode *node) {
+    if (!node) return;
+    freeSubtree(t, node->left);
+    freeSubtree(t, node->right);
+    if (t->valueFree) t->valueFree(VAL_PTR(t, node));
+    free(node);
+}
+
+/**
+ * @brief Frees all resources associated with the interval tree.
+ *
+ * @param[in,out] t Pointer to the interval tree to free
+ */
+void zzIntervalTreeFree(zzIntervalTree *t) {
+    zzIntervalTreeClear(t);
+}
+
+/**
+ * @brief Removes all intervals from the interval tree.
+ *
+ * @param[in,out] t Pointer to the interval tree to clear
+ */
+void zzIntervalTreeClear(zzIntervalTree *t) {
+    if (!t) return;
+    freeSubtree(t, t->root);
+    t->root = NULL;
+    t->size = 0;
+}
+
+// Orders intervals by start point and then by end point
+static int compareInterval(const zzIntervalTree *t, const void *start, const void *end, const IntervalTreeNode *node) {
+    int cmp = t->compareFn(start, START_PTR(node));
+    return cmp != 0 ? cmp : t->compareFn(end, END_PTR(t, node));
+}
+
+static IntervalTreeNode *findNode(const zzIntervalTree *t, const void *start, const void *end) {
+    IntervalTreeNode *cur = t->root;
+    while (cur) {
+        int cmp = compareInterval(t, start, end, cur);
+        if (cmp == 0) return cur;
+        cur = (cmp < 0) ? cur->left : cur->right;
+    }
+    return NULL;
+}
+
+// Recomputes the largest end point of a node's subtree from its children
+static void pullUp(const zzIntervalTree *t, IntervalTreeNode *node) {
+    const unsigned char *maxEnd = END_PTR(t, node);
+    if (node->left && t->compareFn(MAX_END_PTR(t, node->left), maxEnd) > 0) maxEnd = MAX_END_PTR(t, node->left);
+    if (node->right && t->compareFn(MAX_END_PTR(t, node->right), maxEnd) > 0) maxEnd = MAX_END_PTR(t, node->right);
+    memcpy(MAX_END_PTR(t, node), maxEnd, t->endpointSize);
+}
+
+static void pullUpToRoot(const zzIntervalTree *t, IntervalTreeNode *node) {
+    for (; node; node = node->parent) pullUp(t, node);
+}
+
+// Rotations, insert and delete fixups shared with the other red-black trees, keeping subtree maxima current
+#define RB_TREE zzIntervalTree
+#define RB_NODE IntervalTreeNode
+#define RB_PARENT(node) ((node)->parent)
+#define RB_SET_PARENT(node, p) ((node)->parent = (p))
+#define RB_COLOR(node) ((node)->color)
+#define RB_SET_COLOR(node, c) ((node)->color = (c))
+#define RB_PULL_UP(t, node) pullUp(t, node)
+#define RB_PULL_UP_TO_ROOT(t, node) pullUpToRoot(t, node)
+#include "rbTreeOps.h"
+
+/**
+ * @brief Inserts an interval or updates its value.
+ *
+ * This function stores the half-open interval [start, end) with the given value,
+ * or replaces the value if the interval is already present. The interval must not
+ * be empty, so start has to compare less than end.
+ *
+ * @param[in,out] t Pointer to the interval tree to insert/update in
+ * @param[in] start Pointer to the first point of the interval (contents will be copied)
+ * @param[in] end Pointer to the first point past the interval (contents will be copied)
+ * @param[in] value Pointer to the value to insert/update (contents will be copied)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreePut(zzIntervalTree *t, const void *start, const void *end, const void *value) {
+    if (!t) return ZZ_ERR("IntervalTree pointer is NULL");
+    if (!start || !end) return ZZ_ERR("Endpoint pointer is NULL");
+    if (!value) return ZZ_ERR("Value pointer is NULL");
+    if (t->compareFn(start, end) >= 0) return ZZ_ERR("Interval is empty");
+
+    IntervalTreeNode *parent = NULL;
+    IntervalTreeNode *cur = t->root;
+    int cmp = 0;
+
+    while (cur) {
+        parent = cur;
+        cmp = compareInterval(t, start, end, cur);
+        if (cmp == 0) {
+            if (t->valueFree) t->valueFree(VAL_PTR(t, cur));
+            memcpy(VAL_PTR(t, cur), value, t->valueSize);
+            return ZZ_OK();
+        }
+        cur = (cmp < 0) ? cur->left : cur->right;
+    }
+
+    IntervalTreeNode *node = malloc(sizeof(IntervalTreeNode) + valueOffset(t) + t->valueSize);
+    if (!node) return ZZ_ERR("Failed to allocate node");
+
+    memcpy(START_PTR(node), start, t->endpointSize);
+    memcpy(END_PTR(t, node), end, t->endpointSize);
+    memcpy(MAX_END_PTR(t, node), end, t->endpointSize);
+    memcpy(VAL_PTR(t, node), value, t->valueSize);
+    node->left = node->right = NULL;
+    node->parent = parent;
+    node->color = ZZ_RED;
+
+    if (!parent) t->root = node;
+    else if (cmp < 0) parent->left = node;
+    else parent->right = node;
+
+    t->size++;
+    pullUpToRoot(t, parent);
+    rbInsertFixup(t, node);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Retrieves the value stored for exactly the interval [start, end).
+ *
+ * @param[in] t Pointer to the interval tree to retrieve from
+ * @param[in] start Pointer to the first point of the interval
+ * @param[in] end Pointer to the first point past the interval
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the interval is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeGet(const zzIntervalTree *t, const void *start, const void *end, void *valueOut) {
+    if (!t) return ZZ_ERR("IntervalTree pointer is NULL");
+    if (!start || !end) return ZZ_ERR("Endpoint pointer is NULL");
+    if (!valueOut) return ZZ_ERR("Value output pointer is NULL");
+
+    IntervalTreeNode *node = findNode(t, start, end);
+    if (!node) return ZZ_ERR("Interval not found");
+    memcpy(valueOut, VAL_PTR(t, node), t->valueSize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Checks if the interval tree contains exactly the interval [start, end).
+ *
+ * @param[in] t Pointer to the interval tree to check
+ * @param[in] start Pointer to the first point of the interval
+ * @param[in] end Pointer to the first point past the interval
+ * @return true if the interval is stored in the tree, false otherwise
+ */
+bool zzIntervalTreeContains(const zzIntervalTree *t, const void *start, const void *end) {
+    if (!t || !start || !end) return false;
+    return findNode(t, start, end) != NULL;
+}
+
+/**
+ * @brief Removes the interval [start, end) from the interval tree.
+ *
+ * @param[in,out] t Pointer to the interval tree to remove from
+ * @param[in] start Pointer to the first point of the interval
+ * @param[in] end Pointer to the first point past the interval
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeRemove(zzIntervalTree *t, const void *start, const void *end) {
+    if (!t) return ZZ_ERR("IntervalTree pointer is NULL");
+    if (!start || !end) return ZZ_ERR("Endpoint pointer is NULL");
+
+    IntervalTreeNode *z = findNode(t, start, end);
+    if (!z) return ZZ_ERR("Interval not found");
+
+    rbDetachNode(t, z);
+    if (t->valueFree) t->valueFree(VAL_PTR(t, z));
+    free(z);
+    t->size--;
+    return ZZ_OK();
+}
+
+// Whether the node's interval starts early enough to match the query
+static bool startsInQuery(const zzIntervalTreeIterator *it, const IntervalTreeNode *node) {
+    int cmp = it->tree->compareFn(START_PTR(node), it->hi);
+    return it->closed ? cmp <= 0 : cmp < 0;
+}
+
+// Whether an end point lies past the start of the query
+static bool endsInQuery(const zzIntervalTreeIterator *it, const unsigned char *end) {
+    return it->tree->compareFn(it->lo, end) < 0;
+}
+
+// Returns the leftmost matching node in the subtree of node, whose subtree maximum must end in the query
+static IntervalTreeNode *firstMatchIn(const zzIntervalTreeIterator *it, IntervalTreeNode *node) {
+    const zzIntervalTree *t = it->tree;
+    for (;;) {
+        // A left subtree reaching into the query holds the match if any node of this subtree does
+        if (node->left && endsInQuery(it, MAX_END_PTR(t, node->left))) {
+            node = node->left;
+            continue;
+        }
+        if (!startsInQuery(it, node)) return NULL;
+        if (endsInQuery(it, END_PTR(t, node))) return node;
+        if (!node->right || !endsInQuery(it, MAX_END_PTR(t, node->right))) return NULL;
+        node = node->right;
+    }
+}
+
+// Returns the next matching node after node in start order, or NULL
+static IntervalTreeNode *nextMatch(const zzIntervalTreeIterator *it, IntervalTreeNode *node) {
+    const zzIntervalTree *t = it->tree;
+    for (;;) {
+        if (node->right && endsInQuery(it, MAX_END_PTR(t, node->right))) {
+            return firstMatchIn(it, node->right);
+        }
+
+        // Climb until arriving from a left child; that ancestor is the in-order successor
+        IntervalTreeNode *prev;
+        do {
+            prev = node;
+            node = node->parent;
+            if (!node) return NULL;
+        } while (prev == node->right);
+
+        if (!startsInQuery(it, node)) return NULL;
+        if (endsInQuery(it, END_PTR(t, node))) return node;
+    }
+}
+
+static void startQuery(zzIntervalTreeIterator *it, zzIntervalTree *t, const void *lo, const void *hi, bool closed) {
+    it->tree = t;
+    it->lo = lo;
+    it->hi = hi;
+    it->closed = closed;
+    it->state = ZZ_ITER_VALID;
+    it->current = NULL;
+
+    // An empty query range overlaps nothing
+    if (!closed && t->compareFn(lo, hi) >= 0) return;
+    if (t->root && endsInQuery(it, MAX_END_PTR(t, t->root))) it->current = firstMatchIn(it, t->root);
+}
+
+/**
+ * @brief Finds the interval with the smallest start point that overlaps [lo, hi).
+ *
+ * An interval [start, end) overlaps the query when start < hi and lo < end. This
+ * is the O(log n) existence check behind the overlap iterator.
+ *
+ * @param[in] t Pointer to the interval tree to search
+ * @param[in] lo Pointer to the first point of the query range
+ * @param[in] hi Pointer to the first point past the query range
+ * @param[out] startOut Pointer to a buffer receiving the start point of the interval found
+ * @param[out] endOut Pointer to a buffer receiving the end point of the interval found
+ * @param[out] valueOut Pointer to a buffer receiving the value of the interval found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeFindOverlap(const zzIntervalTree *t, const void *lo, const void *hi, void *startOut, void *endOut, void *valueOut) {
+    if (!t) return ZZ_ERR("IntervalTree pointer is NULL");
+    if (!lo || !hi) return ZZ_ERR("Query pointer is NULL");
+    if (!startOut || !endOut || !valueOut) return ZZ_ERR("Output pointer is NULL");
+
+    // The search only reads the tree, so the iterator may borrow it without const
+    zzIntervalTreeIterator it;
+    startQuery(&it, (zzIntervalTree*)t, lo, hi, false);
+    if (!zzIntervalTreeIteratorNext(&it, startOut, endOut, valueOut)) return ZZ_ERR("No overlapping interval");
+    return ZZ_OK();
+}
+
+/**
+ * @brief Initializes an iterator over all intervals overlapping [lo, hi).
+ *
+ * The iterator yields every interval [start, end) with start < hi and lo < end in
+ * order of start points, in O(log n + k) time for k results. An empty query range
+ * (lo not less than hi) yields nothing.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] t Pointer to the interval tree to query
+ * @param[in] lo Pointer to the first point of the query range (must stay valid while iterating)
+ * @param[in] hi Pointer to the first point past the query range (must stay valid while iterating)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeIteratorInitOverlap(zzIntervalTreeIterator *it, zzIntervalTree *t, const void *lo, const void *hi) {
+    if (!it) return ZZ_ERR("Iterator pointer is NULL");
+    if (!t) return ZZ_ERR("IntervalTree pointer is NULL");
+    if (!lo || !hi) return ZZ_ERR("Query pointer is NULL");
+
+    startQuery(it, t, lo, hi, false);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Initializes an iterator over all intervals containing a point.
+ *
+ * The iterator yields every interval [start, end) with start <= point < end in
+ * order of start points, in O(log n + k) time for k results.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] t Pointer to the interval tree to query
+ * @param[in] point Pointer to the point to stab with (must stay valid while iterating)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzIntervalTreeIteratorInitStab(zzIntervalTreeIterator *it, zzIntervalTree *t, const void *point) {
+    if (!it) return ZZ_ERR("Iterator pointer is NULL");
+    if (!t) return ZZ_ERR("IntervalTree pointer is NULL");
+    if (!point) return ZZ_ERR("Query pointer is NULL");
+
+    startQuery(it, t, point, point, true);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Advances the iterator to the next matching interval.
+ *
+ * This function copies the interval and its value to the output buffers and moves
+ * on to the next matching interval. Returns false when no intervals are left.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] startOut Pointer to a buffer where the start point will be copied
+ * @param[out] endOut Pointer to a buffer where the end point will be copied
+ * @param[out] valueOut Pointer to a buffer where the value will be copied
+ * @return true if an interval was retrieved, false if the iterator reached the end
+ */
+bool zzIntervalTreeIteratorNext(zzIntervalTreeIterator *it, void *startOut, void *endOut, void *valueOut) {
+    if (!it || !startOut || !endOut || !valueOut || it->state != ZZ_ITER_VALID) return false;
+    if (!it->current) {
+        it->state = ZZ_ITER_END;
+        return false;
+    }
+
+    const zzIntervalTree *t = it->tree;
+    IntervalTreeNode *node = it->current;
+    memcpy(startOut, START_PTR(node), t->endpointSize);
+    memcpy(endOut, END_PTR(t, node), t->endpointSize);
+    memcpy(valueOut, VAL_PTR(t, node), t->valueSize);
+    it->current = nextMatch(it, node);
+    return true;
+}
+
+/**
+ * @brief Checks if the iterator has more matching intervals.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more intervals, false otherwise
+ */
+bool zzIntervalTreeIteratorHasNext(const zzIntervalTreeIterator *it) {
+    return it && it->state == ZZ_ITER_VALID && it->current != NULL;
+}
\ No newline at end of file
@@ -0,0 +1,510 @@
+#include "persistentTreeMap.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define KEY_PTR(node) ((node)->data)
+#define VAL_PTR(node, keySize) ((node)->data + (keySize))
+
+// Nodes a single update may copy or create per tree level: the path node itself, two
+// per color flip and one per rotation, with some headroom
+#define COPIES_PER_LEVEL 10
+
+static size_t nodeBytes(const zzPersistentTreeMap *pm) {
+    return sizeof(PersistentTreeMapNode) + pm->keySize + pm->valueSize;
+}
+
+static bool isRed(const PersistentTreeMapNode *node) {
+    return node && node->color == ZZ_RED;
+}
+
+static zzRBColor flipColor(zzRBColor color) {
+    return (color == ZZ_RED) ? ZZ_BLACK : ZZ_RED;
+}
+
+static void lockMap(zzPersistentTreeMap *pm) {
+    while (atomic_flag_test_and_set_explicit(&pm->lock, memory_order_acquire)) {
+    }
+}
+
+static void unlockMap(zzPersistentTreeMap *pm) {
+    atomic_flag_clear_explicit(&pm->lock, memory_order_release);
+}
+
+static void retainNode(PersistentTreeMapNode *node) {
+    if (node) atomic_fetch_add_explicit(&node->refCount, 1, memory_order_relaxed);
+}
+
+// Drops one reference on a node, freeing it and releasing its children once nothing references it
+static void releaseNode(PersistentTreeMapNode *node) {
+    while (node && atomic_fetch_sub_explicit(&node->refCount, 1, memory_order_acq_rel) == 1) {
+        releaseNode(node->left);
+        PersistentTreeMapNode *right = node->right;
+        free(node);
+        node = right;
+    }
+}
+
+// Makes sure an update of a tree with the given size finds all the nodes it needs in the spares list,
+// so the tree is never left half-updated by a failed allocation
+static bool reserveSpares(zzPersistentTreeMap *pm, size_t size) {
+    size_t levels = 2;
+    for (size_t n = size + 1; n > 0; n >>= 1) levels += 2;
+
+    size_t needed = COPIES_PER_LEVEL * levels;
+    while (pm->spareCount < needed) {
+        PersistentTreeMapNode *node = malloc(nodeBytes(pm));
+        if (!node) return false;
+        node->left = pm->spares;
+        pm->spares = node;
+        pm->spareCount++;
+    }
+    return true;
+}
+
+static PersistentTreeMapNode *takeSpare(zzPersistentTreeMap *pm) {
+    PersistentTreeMapNode *node = pm->spares;
+    pm->spares = node->left;
+    pm->spareCount--;
+    atomic_init(&node->refCount, 1);
+    return node;
+}
+
+// Returns a node the writer may change in place, given a child of a node it already owns (or the root).
+// A node referenced only by that parent is returned as is; a node shared with a snapshot is copied,
+// and the copy takes over the parent's reference.
+static PersistentTreeMapNode *ownNode(zzPersistentTreeMap *pm, PersistentTreeMapNode *node) {
+    if (atomic_load_explicit(&node->refCount, memory_order_acquire) == 1) return node;
+
+    PersistentTreeMapNode *copy = takeSpare(pm);
+    copy->left = node->left;
+    copy->right = node->right;
+    copy->color = node->color;
+    memcpy(copy->data, node->data, pm->keySize + pm->valueSize);
+    retainNode(copy->left);
+    retainNode(copy->right);
+    releaseNode(node);
+    return copy;
+}
+
+static PersistentTreeMapNode *rotateLeft(zzPersistentTreeMap *pm, PersistentTreeMapNode *h) {
+    PersistentTreeMapNode *x = ownNode(pm, h->right);
+    h->right = x->left;
+    x->left = h;
+    x->color = h->color;
+    h->color = ZZ_RED;
+    return x;
+}
+
+static PersistentTreeMapNode *rotateRight(zzPersistentTreeMap *pm, PersistentTreeMapNode *h) {
+    PersistentTreeMapNode *x = ownNode(pm, h->left);
+    h->left = x->right;
+    x->right = h;
+    x->color = h->color;
+    h->color = ZZ_RED;
+    return x;
+}
+
+static void flipColors(zzPersistentTreeMap *pm, PersistentTreeMapNode *h) {
+    h->left = ownNode(pm, h->left);
+    h->right = ownNode(pm, h->right);
+    h->color = flipColor(h->color);
+    h->left->color = flipColor(h->left->color);
+    h->right->color = flipColor(h->right->color);
+}
+
+// Restores the left-leaning invariants on the way back up from an update
+static PersistentTreeMapNode *balance(zzPersistentTreeMap *pm, PersistentTreeMapNode *h) {
+    if (isRed(h->right) && !isRed(h->left)) h = rotateLeft(pm, h);
+    if (isRed(h->left) && isRed(h->left->left)) h = rotateRight(pm, h);
+    if (isRed(h->left) && isRed(h->right)) flipColors(pm, h);
+    return h;
+}
+
+static PersistentTreeMapNode *moveRedLeft(zzPersistentTreeMap *pm, PersistentTreeMapNode *h) {
+    flipColors(pm, h);
+    if (isRed(h->right->left)) {
+        h->right = rotateRight(pm, h->right);
+        h = rotateLeft(pm, h);
+        flipColors(pm, h);
+    }
+    return h;
+}
+
+static PersistentTreeMapNode *moveRedRight(zzPersistentTreeMap *pm, PersistentTreeMapNode *h) {
+    flipColors(pm, h);
+    if (isRed(h->left->left)) {
+        h = rotateRight(pm, h);
+        flipColors(pm, h);
+    }
+    return h;
+}
+
+static PersistentTreeMapNode *insertAt(zzPersistentTreeMap *pm, PersistentTreeMapNode *h, const void *key, const void *value, bool *added) {
+    if (!h) {
+        PersistentTreeMapNode *node = takeSpare(pm);
+        node->left = NULL;
+        node->right = NULL;
+        node->color = ZZ_RED;
+        memcpy(KEY_PTR(node), key, pm->keySize);
+        memcpy(VAL_PTR(node, pm->keySize), value, pm->valueSize);
+        *added = true;
+        return node;
+    }
+
+    h = ownNode(pm, h);
+    int cmp = pm->compareFn(key, KEY_PTR(h));
+    if (cmp < 0) {
+        h->left = insertAt(pm, h->left, key, value, added);
+    } else if (cmp > 0) {
+        h->right = insertAt(pm, h->right, key, value, added);
+    } else {
+        memcpy(VAL_PTR(h, pm->keySize), value, pm->valueSize);
+    }
+    return balance(pm, h);
+}
+
+static PersistentTreeMapNode *removeMinAt(zzPersistentTreeMap *pm, PersistentTreeMapNode *h) {
+    h = ownNode(pm, h);
+    if (!h->left) {
+        releaseNode(h);
+        return NULL;
+    }
+    if (!isRed(h->left) && !isRed(h->left->left)) h = moveRedLeft(pm, h);
+    h->left = removeMinAt(pm, h->left);
+    return balance(pm, h);
+}
+
+// Removes a key known to be present from the subtree, pushing a red link down the search path
+static PersistentTreeMapNode *removeAt(zzPersistentTreeMap *pm, PersistentTreeMapNode *h, const void *key) {
+    h = ownNode(pm, h);
+    if (pm->compareFn(key, KEY_PTR(h)) < 0) {
+        if (!isRed(h->left) && !isRed(h->left->left)) h = moveRedLeft(pm, h);
+        h->left = removeAt(pm, h->left, key);
+    } else {
+        if (isRed(h->left)) h = rotateRight(pm, h);
+        if (pm->compareFn(key, KEY_PTR(h)) == 0 && !h->right) {
+            releaseNode(h);
+            return NULL;
+        }
+        if (!isRed(h->right) && !isRed(h->right->left)) h = moveRedRight(pm, h);
+        if (pm->compareFn(key, KEY_PTR(h)) == 0) {
+            // Take over the successor's entry, then remove the successor from the right subtree
+            const PersistentTreeMapNode *min = h->right;
+            while (min->left) min = min->left;
+            memcpy(h->data, min->data, pm->keySize + pm->valueSize);
+            h->right = removeMinAt(pm, h->right);
+        } else {
+            h->right = removeAt(pm, h->right, key);
+        }
+    }
+    return balance(pm, h);
+}
+
+static const PersistentTreeMapNode *findNode(const PersistentTreeMapNode *cur, zzCompareFn compareFn, const void *key) {
+    while (cur) {
+        int cmp = compareFn(key, KEY_PTR(cur));
+        if (cmp == 0) return cur;
+        cur = (cmp < 0) ? cur->left : cur->right;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Initializes a new persistent TreeMap with the specified key and value sizes.
+ *
+ * This function initializes a persistent TreeMap structure with the given key and
+ * value sizes and comparison function. The map will be empty after initialization.
+ *
+ * @param[out] pm Pointer to the persistent TreeMap structure to initialize
+ * @param[in] keySize Size in bytes of each key that will be stored in the map
+ * @param[in] valueSize Size in bytes of each value that will be stored in the map
+ * @param[in] compareFn Function to compare keys for ordering (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapInit(zzPersistentTreeMap *pm, size_t keySize, size_t valueSize, zzCompareFn compareFn) {
+    if (!pm) return ZZ_ERR("Persistent TreeMap pointer is NULL");
+    if (keySize == 0) return ZZ_ERR("Key size cannot be zero");
+    if (valueSize == 0) return ZZ_ERR("Value size cannot be zero");
+    if (!compareFn) return ZZ_ERR("Comparison function is NULL");
+
+    pm->root = NULL;
+    pm->size = 0;
+    pm->keySize = keySize;
+    pm->valueSize = valueSize;
+    pm->compareFn = compareFn;
+    pm->spares = NULL;
+    pm->spareCount = 0;
+    atomic_flag_clear(&pm->lock);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Frees the persistent TreeMap.
+ *
+ * This function releases the map's reference on its current version and frees the
+ * nodes no snapshot still uses. Snapshots taken earlier remain valid until they are
+ * released.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to free
+ */
+void zzPersistentTreeMapFree(zzPersistentTreeMap *pm) {
+    if (!pm) return;
+    zzPersistentTreeMapClear(pm);
+    while (pm->spares) {
+        PersistentTreeMapNode *next = pm->spares->left;
+        free(pm->spares);
+        pm->spares = next;
+    }
+    pm->spareCount = 0;
+}
+
+/**
+ * @brief Inserts or updates a key-value pair in the persistent TreeMap.
+ *
+ * This function inserts a new key-value pair or replaces the value of an existing
+ * key. Nodes on the modified path that are shared with a snapshot are copied, so
+ * snapshots keep seeing the old contents.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to insert/update in
+ * @param[in] key Pointer to the key to insert/update (contents will be copied)
+ * @param[in] value Pointer to the value to insert/update (contents will be copied)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapPut(zzPersistentTreeMap *pm, const void *key, const void *value) {
+    if (!pm) return ZZ_ERR("Persistent TreeMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!value) return ZZ_ERR("Value pointer is NULL");
+
+    lockMap(pm);
+    if (!reserveSpares(pm, pm->size + 1)) {
+        unlockMap(pm);
+        return ZZ_ERR("Memory allocation failed");
+    }
+
+    bool added = false;
+    pm->root = insertAt(pm, pm->root, key, value, &added);
+    pm->root->color = ZZ_BLACK;
+    if (added) pm->size++;
+    unlockMap(pm);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Retrieves the value associated with the given key from the current version.
+ *
+ * @param[in] pm Pointer to the persistent TreeMap to retrieve from
+ * @param[in] key Pointer to the key to look up
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the key is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapGet(const zzPersistentTreeMap *pm, const void *key, void *valueOut) {
+    if (!pm) return ZZ_ERR("Persistent TreeMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!valueOut) return ZZ_ERR("Value output pointer is NULL");
+
+    const PersistentTreeMapNode *node = findNode(pm->root, pm->compareFn, key);
+    if (!node) return ZZ_ERR("Key not found");
+    memcpy(valueOut, VAL_PTR(node, pm->keySize), pm->valueSize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Checks if the current version of the persistent TreeMap contains the specified key.
+ *
+ * @param[in] pm Pointer to the persistent TreeMap to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the map, false otherwise
+ */
+bool zzPersistentTreeMapContains(const zzPersistentTreeMap *pm, const void *key) {
+    if (!pm || !key) return false;
+    return findNode(pm->root, pm->compareFn, key) != NULL;
+}
+
+/**
+ * @brief Removes a key-value pair from the persistent TreeMap.
+ *
+ * This function removes the entry with the specified key. Nodes on the modified
+ * path that are shared with a snapshot are copied, so snapshots keep seeing the
+ * removed entry.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to remove from
+ * @param[in] key Pointer to the key to remove
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapRemove(zzPersistentTreeMap *pm, const void *key) {
+    if (!pm) return ZZ_ERR("Persistent TreeMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!findNode(pm->root, pm->compareFn, key)) return ZZ_ERR("Key not found");
+
+    lockMap(pm);
+    if (!reserveSpares(pm, pm->size)) {
+        unlockMap(pm);
+        return ZZ_ERR("Memory allocation failed");
+    }
+
+    PersistentTreeMapNode *root = ownNode(pm, pm->root);
+    if (!isRed(root->left) && !isRed(root->right)) root->color = ZZ_RED;
+    pm->root = removeAt(pm, root, key);
+    if (pm->root) pm->root->color = ZZ_BLACK;
+    pm->size--;
+    unlockMap(pm);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Removes all key-value pairs from the persistent TreeMap.
+ *
+ * This function empties the current version. Snapshots keep their contents.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to clear
+ */
+void zzPersistentTreeMapClear(zzPersistentTreeMap *pm) {
+    if (!pm) return;
+
+    lockMap(pm);
+    PersistentTreeMapNode *root = pm->root;
+    pm->root = NULL;
+    pm->size = 0;
+    unlockMap(pm);
+    releaseNode(root);
+}
+
+/**
+ * @brief Takes an immutable snapshot of the current version of the persistent TreeMap.
+ *
+ * This function shares the current root with the snapshot in O(1). It may be called
+ * from any thread; it waits at most for the update in progress to finish. The
+ * snapshot must be released with zzPersistentTreeMapReleaseSnapshot.
+ *
+ * @param[in,out] pm Pointer to the persistent TreeMap to take a snapshot of
+ * @param[out] snap Pointer to the snapshot structure to fill
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapAcquireSnapshot(zzPersistentTreeMap *pm, zzPersistentTreeMapSnapshot *snap) {
+    if (!pm) return ZZ_ERR("Persistent TreeMap pointer is NULL");
+    if (!snap) return ZZ_ERR("Snapshot pointer is NULL");
+
+    lockMap(pm);
+    retainNode(pm->root);
+    snap->root = pm->root;
+    snap->size = pm->size;
+    unlockMap(pm);
+
+    snap->keySize = pm->keySize;
+    snap->valueSize = pm->valueSize;
+    snap->compareFn = pm->compareFn;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Releases a snapshot of a persistent TreeMap.
+ *
+ * This function drops the snapshot's reference on its version and frees the nodes
+ * that are no longer used by the map or by other snapshots. The snapshot is empty
+ * afterwards. It may be called from any thread, even after the map was freed.
+ *
+ * @param[in,out] snap Pointer to the snapshot to release
+ */
+void zzPersistentTreeMapReleaseSnapshot(zzPersistentTreeMapSnapshot *snap) {
+    if (!snap) return;
+    releaseNode(snap->root);
+    snap->root = NULL;
+    snap->size = 0;
+}
+
+/**
+ * @brief Retrieves the value associated with the given key from a snapshot.
+ *
+ * @param[in] snap Pointer to the snapshot to retrieve from
+ * @param[in] key Pointer to the key to look up
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the key is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzPersistentTreeMapSnapshotGet(const zzPersistentTreeMapSnapshot *snap, const void *key, void *valueOut) {
+    if (!snap) return ZZ_ERR("Snapshot pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!valueOut) return ZZ_ERR("Value output pointer is NULL");
+
+    const PersistentTreeMapNode *node = findNode(snap->root, snap->compareFn, key);
+    if (!node) return ZZ_ERR("Key not found");
+    memcpy(valueOut, VAL_PTR(node, snap->keySize), snap->valueSize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Checks if a snapshot contains the specified key.
+ *
+ * @param[in] snap Pointer to the snapshot to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the snapshot, false otherwise
+ */
+bool zzPersistentTreeMapSnapshotContains(const zzPersistentTreeMapSnapshot *snap, const void *key) {
+    if (!snap || !key) return false;
+    return findNode(snap->root, snap->compareFn, key) != NULL;
+}
+
+static void pushLeftSpine(zzPersistentTreeMapIterator *it, const PersistentTreeMapNode *node) {
+    while (node) {
+        it->stack[it->depth++] = node;
+        node = node->left;
+    }
+}
+
+/**
+ * @brief Initializes an iterator over a persistent TreeMap snapshot.
+ *
+ * This function positions the iterator at the smallest key of the snapshot.
+ * The snapshot must stay acquired while the iterator is used.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] snap Pointer to the snapshot to iterate over
+ */
+void zzPersistentTreeMapIteratorInit(zzPersistentTreeMapIterator *it, const zzPersistentTreeMapSnapshot *snap) {
+    if (!it) return;
+    it->snapshot = snap;
+    it->depth = 0;
+    if (!snap) {
+        it->state = ZZ_ITER_ERROR;
+        return;
+    }
+    pushLeftSpine(it, snap->root);
+    it->state = it->depth ? ZZ_ITER_VALID : ZZ_ITER_END;
+}
+
+/**
+ * @brief Advances the iterator to the next key-value pair.
+ *
+ * This function copies the current key and value to the output buffers and moves
+ * the iterator to the next key-value pair in sorted order. Returns false when the
+ * iterator reaches the end of the snapshot.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] keyOut Pointer to a buffer where the current key will be copied
+ * @param[out] valueOut Pointer to a buffer where the current value will be copied
+ * @return true if a key-value pair was retrieved, false if the iterator reached the end
+ */
+bool zzPersistentTreeMapIteratorNext(zzPersistentTreeMapIterator *it, void *keyOut, void *valueOut) {
+    if (!it || !keyOut || !valueOut || it->state != ZZ_ITER_VALID) return false;
+    if (it->depth == 0) {
+        it->state = ZZ_ITER_END;
+        return false;
+    }
+
+    const PersistentTreeMapNode *current = it->stack[--it->depth];
+    memcpy(keyOut, KEY_PTR(current), it->snapshot->keySize);
+    memcpy(valueOut, VAL_PTR(current, it->snapshot->keySize), it->snapshot->valueSize);
+
+    // The in-order successor is the leftmost node of the right subtree, or the nearest pending ancestor
+    pushLeftSpine(it, current->right);
+    return true;
+}
+
+/**
+ * @brief Checks if the iterator has more elements.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more elements, false otherwise
+ */
+bool zzPersistentTreeMapIteratorHasNext(const zzPersistentTreeMapIterator *it) {
+    return it && it->state == ZZ_ITER_VALID && it->depth > 0;
+}
\ No newline at end of file
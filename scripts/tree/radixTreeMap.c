@@ -0,0 +1,948 @@
+#include "radixTreeMap.h"
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define RADIX_SSE2 1
+#endif
+
+#define KEY_PTR(leaf) ((leaf)->data)
+#define VAL_PTR(leaf, keySize) ((leaf)->data + (keySize))
+
+// Child pointers with the lowest bit set refer to leaves
+#define IS_LEAF(ptr) (((uintptr_t)(ptr) & 1) != 0)
+#define AS_LEAF(ptr) ((RadixTreeLeaf*)((uintptr_t)(ptr) & ~(uintptr_t)1))
+#define LEAF_REF(leaf) ((RadixTreeNode*)((uintptr_t)(leaf) | 1))
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+typedef struct RadixNode4 {
+    RadixTreeNode header;
+    unsigned char keys[4];          // Sorted key bytes of the children
+    RadixTreeNode *children[4];
+} RadixNode4;
+
+typedef struct RadixNode16 {
+    RadixTreeNode header;
+    unsigned char keys[16];         // Sorted key bytes of the children
+    RadixTreeNode *children[16];
+} RadixNode16;
+
+typedef struct RadixNode48 {
+    RadixTreeNode header;
+    unsigned char childIndex[256];  // One plus the slot of each key byte's child, or 0 if absent
+    RadixTreeNode *children[48];
+} RadixNode48;
+
+typedef struct RadixNode256 {
+    RadixTreeNode header;
+    RadixTreeNode *children[256];   // Child of each key byte, or NULL if absent
+} RadixNode256;
+
+// Binary-comparable form of a key: integers are re-encoded into buf, strings are used in place
+typedef struct KeyBytes {
+    const unsigned char *bytes;
+    size_t len;
+    unsigned char buf[8];
+} KeyBytes;
+
+static void encodeKey(const zzRadixTreeMap *rm, const void *key, KeyBytes *kb) {
+    if (rm->keyType == ZZ_RADIX_KEY_STRING) {
+        const char *str = *(const char* const*)key;
+        kb->bytes = (const unsigned char*)str;
+        kb->len = strlen(str) + 1;
+        return;
+    }
+
+    uint64_t v = 0;
+    switch (rm->keySize) {
+        case 1: { uint8_t x; memcpy(&x, key, 1); v = x; break; }
+        case 2: { uint16_t x; memcpy(&x, key, 2); v = x; break; }
+        case 4: { uint32_t x; memcpy(&x, key, 4); v = x; break; }
+        default: memcpy(&v, key, 8); break;
+    }
+    if (rm->keyType == ZZ_RADIX_KEY_SIGNED) v ^= (uint64_t)1 << (rm->keySize * 8 - 1);
+    for (size_t i = 0; i < rm->keySize; i++) {
+        kb->buf[i] = (unsigned char)(v >> (8 * (rm->keySize - 1 - i)));
+    }
+    kb->bytes = kb->buf;
+    kb->len = rm->keySize;
+}
+
+static int compareBytes(const KeyBytes *a, const KeyBytes *b) {
+    int cmp = memcmp(a->bytes, b->bytes, MIN(a->len, b->len));
+    if (cmp != 0) return cmp;
+    return (a->len > b->len) - (a->len < b->len);
+}
+
+static bool leafMatches(const zzRadixTreeMap *rm, const RadixTreeLeaf *leaf, const KeyBytes *kb) {
+    KeyBytes leafKey;
+    encodeKey(rm, KEY_PTR(leaf), &leafKey);
+    return leafKey.len == kb->len && memcmp(leafKey.bytes, kb->bytes, kb->len) == 0;
+}
+
+static RadixTreeNode *newNode(uint8_t type) {
+    size_t bytes;
+    switch (type) {
+        case ZZ_RADIX_NODE4: bytes = sizeof(RadixNode4); break;
+        case ZZ_RADIX_NODE16: bytes = sizeof(RadixNode16); break;
+        case ZZ_RADIX_NODE48: bytes = sizeof(RadixNode48); break;
+        default: bytes = sizeof(RadixNode256); break;
+    }
+    RadixTreeNode *node = calloc(1, bytes);
+    if (node) node->type = type;
+    return node;
+}
+
+static void copyHeader(RadixTreeNode *dst, const RadixTreeNode *src) {
+    dst->numChildren = src->numChildren;
+    dst->prefixLen = src->prefixLen;
+    memcpy(dst->prefix, src->prefix, MIN(src->prefixLen, ZZ_RADIX_MAX_PREFIX));
+}
+
+static RadixTreeNode **findChild(RadixTreeNode *n, unsigned char c) {
+    switch (n->type) {
+        case ZZ_RADIX_NODE4: {
+            RadixNode4 *p = (RadixNode4*)n;
+            for (int i = 0; i < n->numChildren; i++) {
+                if (p->keys[i] == c) return &p->children[i];
+            }
+            return NULL;
+        }
+        case ZZ_RADIX_NODE16: {
+            RadixNode16 *p = (RadixNode16*)n;
+#ifdef RADIX_SSE2
+            // Compare the byte against all sixteen keys at once
+            __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)c), _mm_loadu_si128((const __m128i*)p->keys));
+            unsigned mask = (unsigned)_mm_movemask_epi8(cmp) & ((1u << n->numChildren) - 1);
+            return mask ? &p->children[__builtin_ctz(mask)] : NULL;
+#else
+            for (int i = 0; i < n->numChildren; i++) {
+                if (p->keys[i] == c) return &p->children[i];
+            }
+            return NULL;
+#endif
+        }
+        case ZZ_RADIX_NODE48: {
+            RadixNode48 *p = (RadixNode48*)n;
+            return p->childIndex[c] ? &p->children[p->childIndex[c] - 1] : NULL;
+        }
+        default: {
+            RadixNode256 *p = (RadixNode256*)n;
+            return p->children[c] ? &p->children[c] : NULL;
+        }
+    }
+}
+
+// Returns the child with the smallest key byte greater than c, or NULL
+static RadixTreeNode *childAfter(RadixTreeNode *n, unsigned char c) {
+    switch (n->type) {
+        case ZZ_RADIX_NODE4:
+        case ZZ_RADIX_NODE16: {
+            const unsigned char *keys = (n->type == ZZ_RADIX_NODE4) ? ((RadixNode4*)n)->keys : ((RadixNode16*)n)->keys;
+            RadixTreeNode **children = (n->type == ZZ_RADIX_NODE4) ? ((RadixNode4*)n)->children : ((RadixNode16*)n)->children;
+            for (int i = 0; i < n->numChildren; i++) {
+                if (keys[i] > c) return children[i];
+            }
+            return NULL;
+        }
+        case ZZ_RADIX_NODE48: {
+            RadixNode48 *p = (RadixNode48*)n;
+            for (int b = c + 1; b < 256; b++) {
+                if (p->childIndex[b]) return p->children[p->childIndex[b] - 1];
+            }
+            return NULL;
+        }
+        default: {
+            RadixNode256 *p = (RadixNode256*)n;
+            for (int b = c + 1; b < 256; b++) {
+                if (p->children[b]) return p->children[b];
+            }
+            return NULL;
+        }
+    }
+}
+
+static RadixTreeLeaf *minLeaf(const RadixTreeNode *n) {
+    while (!IS_LEAF(n)) {
+        switch (n->type) {
+            case ZZ_RADIX_NODE4: n = ((const RadixNode4*)n)->children[0]; break;
+            case ZZ_RADIX_NODE16: n = ((const RadixNode16*)n)->children[0]; break;
+            case ZZ_RADIX_NODE48: {
+                const RadixNode48 *p = (const RadixNode48*)n;
+                int b = 0;
+                while (!p->childIndex[b]) b++;
+                n = p->children[p->childIndex[b] - 1];
+                break;
+            }
+            default: {
+                const RadixNode256 *p = (const RadixNode256*)n;
+                int b = 0;
+                while (!p->children[b]) b++;
+                n = p->children[b];
+                break;
+            }
+        }
+    }
+    return AS_LEAF(n);
+}
+
+static RadixTreeLeaf *maxLeaf(const RadixTreeNode *n) {
+    while (!IS_LEAF(n)) {
+        switch (n->type) {
+            case ZZ_RADIX_NODE4: n = ((const RadixNode4*)n)->children[n->numChildren - 1]; break;
+            case ZZ_RADIX_NODE16: n = ((const RadixNode16*)n)->children[n->numChildren - 1]; break;
+            case ZZ_RADIX_NODE48: {
+                const RadixNode48 *p = (const RadixNode48*)n;
+                int b = 255;
+                while (!p->childIndex[b]) b--;
+                n = p->children[p->childIndex[b] - 1];
+                break;
+            }
+            default: {
+                const RadixNode256 *p = (const RadixNode256*)n;
+                int b = 255;
+                while (!p->children[b]) b--;
+                n = p->children[b];
+                break;
+            }
+        }
+    }
+    return AS_LEAF(n);
+}
+
+// Adds a child under a new key byte, replacing the node with the next larger layout when it is full.
+// Returns false without changing anything if that allocation fails.
+static bool addChild(RadixTreeNode **ref, RadixTreeNode *n, unsigned char c, RadixTreeNode *child) {
+    switch (n->type) {
+        case ZZ_RADIX_NODE4:
+        case ZZ_RADIX_NODE16: {
+            int capacity = (n->type == ZZ_RADIX_NODE4) ? 4 : 16;
+            unsigned char *keys = (n->type == ZZ_RADIX_NODE4) ? ((RadixNode4*)n)->keys : ((RadixNode16*)n)->keys;
+            RadixTreeNode **children = (n->type == ZZ_RADIX_NODE4) ? ((RadixNode4*)n)->children : ((RadixNode16*)n)->children;
+            if (n->numChildren < capacity) {
+                int pos = 0;
+                while (pos < n->numChildren && keys[pos] < c) pos++;
+                memmove(keys + pos + 1, keys + pos, n->numChildren - pos);
+                memmove(children + pos + 1, children + pos, (n->numChildren - pos) * sizeof(RadixTreeNode*));
+                keys[pos] = c;
+                children[pos] = child;
+                n->numChildren++;
+                return true;
+            }
+
+            RadixTreeNode *grown;
+            if (n->type == ZZ_RADIX_NODE4) {
+                grown = newNode(ZZ_RADIX_NODE16);
+                if (!grown) return false;
+                memcpy(((RadixNode16*)grown)->keys, keys, 4);
+                memcpy(((RadixNode16*)grown)->children, children, 4 * sizeof(RadixTreeNode*));
+            } else {
+                grown = newNode(ZZ_RADIX_NODE48);
+                if (!grown) return false;
+                for (int i = 0; i < 16; i++) {
+                    ((RadixNode48*)grown)->childIndex[keys[i]] = (unsigned char)(i + 1);
+                    ((RadixNode48*)grown)->children[i] = children[i];
+                }
+            }
+            copyHeader(grown, n);
+            *ref = grown;
+            free(n);
+            return addChild(ref, grown, c, child);
+        }
+        case ZZ_RADIX_NODE48: {
+            RadixNode48 *p = (RadixNode48*)n;
+            if (n->numChildren < 48) {
+                int pos = 0;
+                while (p->children[pos]) pos++;
+                p->children[pos] = child;
+                p->childIndex[c] = (unsigned char)(pos + 1);
+                n->numChildren++;
+                return true;
+            }
+
+            RadixNode256 *grown = (RadixNode256*)newNode(ZZ_RADIX_NODE256);
+            if (!grown) return false;
+            for (int b = 0; b < 256; b++) {
+                if (p->childIndex[b]) grown->children[b] = p->children[p->childIndex[b] - 1];
+            }
+            copyHeader(&grown->header, n);
+            *ref = &grown->header;
+            free(n);
+            return addChild(ref, &grown->header, c, child);
+        }
+        default: {
+            ((RadixNode256*)n)->children[c] = child;
+            n->numChildren++;
+            return true;
+        }
+    }
+}
+
+// Removes the child in the given slot, moving the node to the next smaller layout once it is sparse
+// enough and merging a Node4 left with a single child into that child. Shrinking is skipped if the
+// smaller node cannot be allocated, which leaves a valid tree.
+static void removeChild(RadixTreeNode **ref, RadixTreeNode *n, RadixTreeNode **slot, unsigned char c) {
+    switch (n->type) {
+        case ZZ_RADIX_NODE4:
+        case ZZ_RADIX_NODE16: {
+            unsigned char *keys = (n->type == ZZ_RADIX_NODE4) ? ((RadixNode4*)n)->keys : ((RadixNode16*)n)->keys;
+            RadixTreeNode **children = (n->type == ZZ_RADIX_NODE4) ? ((RadixNode4*)n)->children : ((RadixNode16*)n)->children;
+            int pos = (int)(slot - children);
+            memmove(keys + pos, keys + pos + 1, n->numChildren - 1 - pos);
+            memmove(children + pos, children + pos + 1, (n->numChildren - 1 - pos) * sizeof(RadixTreeNode*));
+            n->numChildren--;
+
+            if (n->type == ZZ_RADIX_NODE16 && n->numChildren == 3) {
+                RadixNode4 *shrunk = (RadixNode4*)newNode(ZZ_RADIX_NODE4);
+                if (!shrunk) return;
+                copyHeader(&shrunk->header, n);
+                memcpy(shrunk->keys, keys, 3);
+                memcpy(shrunk->children, children, 3 * sizeof(RadixTreeNode*));
+                *ref = &shrunk->header;
+                free(n);
+            } else if (n->type == ZZ_RADIX_NODE4 && n->numChildren == 1) {
+                // Path compression: the remaining child absorbs this node's prefix and key byte
+                RadixTreeNode *only = children[0];
+                if (!IS_LEAF(only)) {
+                    uint32_t len = n->prefixLen;
+                    if (len < ZZ_RADIX_MAX_PREFIX) n->prefix[len++] = keys[0];
+                    if (len < ZZ_RADIX_MAX_PREFIX) {
+                        uint32_t sub = MIN(only->prefixLen, ZZ_RADIX_MAX_PREFIX - len);
+                        memcpy(n->prefix + len, only->prefix, sub);
+                        len += sub;
+                    }
+                    memcpy(only->prefix, n->prefix, MIN(len, ZZ_RADIX_MAX_PREFIX));
+                    only->prefixLen += n->prefixLen + 1;
+                }
+                *ref = only;
+                free(n);
+            }
+            return;
+        }
+        case ZZ_RADIX_NODE48: {
+            RadixNode48 *p = (RadixNode48*)n;
+            p->children[p->childIndex[c] - 1] = NULL;
+            p->childIndex[c] = 0;
+            n->numChildren--;
+
+            if (n->numChildren == 12) {
+                RadixNode16 *shrunk = (RadixNode16*)newNode(ZZ_RADIX_NODE16);
+                if (!shrunk) return;
+                copyHeader(&shrunk->header, n);
+                int k = 0;
+                for (int b = 0; b < 256; b++) {
+                    if (!p->childIndex[b]) continue;
+                    shrunk->keys[k] = (unsigned char)b;
+                    shrunk->children[k++] = p->children[p->childIndex[b] - 1];
+                }
+                *ref = &shrunk->header;
+                free(n);
+            }
+            return;
+        }
+        default: {
+            RadixNode256 *p = (RadixNode256*)n;
+            p->children[c] = NULL;
+            n->numChildren--;
+
+            if (n->numChildren == 37) {
+                RadixNode48 *shrunk = (RadixNode48*)newNode(ZZ_RADIX_NODE48);
+                if (!shrunk) return;
+                copyHeader(&shrunk->header, n);
+                int pos = 0;
+                for (int b = 0; b < 256; b++) {
+                    if (!p->children[b]) continue;
+                    shrunk->childIndex[b] = (unsigned char)(pos + 1);
+                    shrunk->children[pos++] = p->children[b];
+                }
+                *ref = &shrunk->header;
+                free(n);
+            }
+            return;
+        }
+    }
+}
+
+// Returns the byte at position idx of a node's compressed path, fetching it from a leaf when not stored
+static unsigned char prefixByte(const zzRadixTreeMap *rm, const RadixTreeNode *n, size_t depth, size_t idx) {
+    if (idx < ZZ_RADIX_MAX_PREFIX) return n->prefix[idx];
+    KeyBytes leafKey;
+    encodeKey(rm, KEY_PTR(minLeaf(n)), &leafKey);
+    return leafKey.bytes[depth + idx];
+}
+
+// Returns how many bytes of a node's full compressed path match the key starting at depth
+static size_t prefixMismatch(const zzRadixTreeMap *rm, const RadixTreeNode *n, const KeyBytes *kb, size_t depth) {
+    size_t limit = MIN((size_t)n->prefixLen, kb->len - depth);
+    size_t stored = MIN(limit, (size_t)ZZ_RADIX_MAX_PREFIX);
+    size_t idx = 0;
+    for (; idx < stored; idx++) {
+        if (n->prefix[idx] != kb->bytes[depth + idx]) return idx;
+    }
+    if (idx < limit) {
+        KeyBytes leafKey;
+        encodeKey(rm, KEY_PTR(minLeaf(n)), &leafKey);
+        for (; idx < limit; idx++) {
+            if (leafKey.bytes[depth + idx] != kb->bytes[depth + idx]) return idx;
+        }
+    }
+    return idx;
+}
+
+static RadixTreeLeaf *findLeaf(const zzRadixTreeMap *rm, const KeyBytes *kb) {
+    RadixTreeNode *n = rm->root;
+    size_t depth = 0;
+    while (n) {
+        if (IS_LEAF(n)) return leafMatches(rm, AS_LEAF(n), kb) ? AS_LEAF(n) : NULL;
+        if (n->prefixLen) {
+            // Only the stored bytes are compared here; the final leaf check covers the rest
+            size_t stored = MIN(n->prefixLen, ZZ_RADIX_MAX_PREFIX);
+            if (depth + stored > kb->len || memcmp(n->prefix, kb->bytes + depth, stored) != 0) return NULL;
+            depth += n->prefixLen;
+        }
+        if (depth >= kb->len) return NULL;
+        RadixTreeNode **child = findChild(n, kb->bytes[depth]);
+        n = child ? *child : NULL;
+        depth++;
+    }
+    return NULL;
+}
+
+// Returns the leaf with the smallest key not less than the given key, or NULL
+static RadixTreeLeaf *lowerBound(const zzRadixTreeMap *rm, const KeyBytes *kb) {
+    RadixTreeNode *n = rm->root;
+    size_t depth = 0;
+    while (n) {
+        if (IS_LEAF(n)) {
+            // Every other leaf leaves the key's path earlier, so the list successor is the answer
+            KeyBytes leafKey;
+            encodeKey(rm, KEY_PTR(AS_LEAF(n)), &leafKey);
+            return compareBytes(&leafKey, kb) >= 0 ? AS_LEAF(n) : AS_LEAF(n)->next;
+        }
+        if (n->prefixLen) {
+            size_t mismatch = prefixMismatch(rm, n, kb, depth);
+            if (mismatch < n->prefixLen) {
+                if (depth + mismatch >= kb->len) return minLeaf(n);
+                bool subtreeGreater = prefixByte(rm, n, depth, mismatch) > kb->bytes[depth + mismatch];
+                return subtreeGreater ? minLeaf(n) : maxLeaf(n)->next;
+            }
+            depth += n->prefixLen;
+        }
+        if (depth >= kb->len) return minLeaf(n);
+        RadixTreeNode **child = findChild(n, kb->bytes[depth]);
+        if (!child) {
+            RadixTreeNode *after = childAfter(n, kb->bytes[depth]);
+            return after ? minLeaf(after) : maxLeaf(n)->next;
+        }
+        n = *child;
+        depth++;
+    }
+    return NULL;
+}
+
+// Inserts a leaf whose key is not in the tree yet. Returns false without changing anything if a node allocation fails.
+static bool insertLeaf(zzRadixTreeMap *rm, const KeyBytes *kb, RadixTreeLeaf *leaf) {
+    RadixTreeNode **ref = &rm->root;
+    size_t depth = 0;
+    for (;;) {
+        RadixTreeNode *n = *ref;
+        if (!n) {
+            *ref = LEAF_REF(leaf);
+            return true;
+        }
+
+        if (IS_LEAF(n)) {
+            // Replace the leaf with a Node4 holding both leaves below their common bytes
+            KeyBytes other;
+            encodeKey(rm, KEY_PTR(AS_LEAF(n)), &other);
+            size_t lcp = 0;
+            while (other.bytes[depth + lcp] == kb->bytes[depth + lcp]) lcp++;
+
+            RadixTreeNode *node = newNode(ZZ_RADIX_NODE4);
+            if (!node) return false;
+            node->prefixLen = (uint32_t)lcp;
+            memcpy(node->prefix, kb->bytes + depth, MIN(lcp, (size_t)ZZ_RADIX_MAX_PREFIX));
+            *ref = node;
+            addChild(ref, node, other.bytes[depth + lcp], n);
+            addChild(ref, node, kb->bytes[depth + lcp], LEAF_REF(leaf));
+            return true;
+        }
+
+        if (n->prefixLen) {
+            size_t mismatch = prefixMismatch(rm, n, kb, depth);
+            if (mismatch < n->prefixLen) {
+                // Split the compressed path: a new Node4 takes the matching part
+                RadixTreeNode *node = newNode(ZZ_RADIX_NODE4);
+                if (!node) return false;
+                node->prefixLen = (uint32_t)mismatch;
+                memcpy(node->prefix, kb->bytes + depth, MIN(mismatch, (size_t)ZZ_RADIX_MAX_PREFIX));
+
+                unsigned char nodeByte = prefixByte(rm, n, depth, mismatch);
+                if (n->prefixLen <= ZZ_RADIX_MAX_PREFIX) {
+                    n->prefixLen -= (uint32_t)(mismatch + 1);
+                    memmove(n->prefix, n->prefix + mismatch + 1, n->prefixLen);
+                } else {
+                    KeyBytes leafKey;
+                    encodeKey(rm, KEY_PTR(minLeaf(n)), &leafKey);
+                    n->prefixLen -= (uint32_t)(mismatch + 1);
+                    memcpy(n->prefix, leafKey.bytes + depth + mismatch + 1, MIN(n->prefixLen, ZZ_RADIX_MAX_PREFIX));
+                }
+                *ref = node;
+                addChild(ref, node, nodeByte, n);
+                addChild(ref, node, kb->bytes[depth + mismatch], LEAF_REF(leaf));
+                return true;
+            }
+            depth += n->prefixLen;
+        }
+
+        RadixTreeNode **child = findChild(n, kb->bytes[depth]);
+        if (!child) return addChild(ref, n, kb->bytes[depth], LEAF_REF(leaf));
+        ref = child;
+        depth++;
+    }
+}
+
+// Unlinks the leaf holding the key from the tree (not from the leaf list) and returns it, or NULL
+static RadixTreeLeaf *detachLeaf(zzRadixTreeMap *rm, const KeyBytes *kb) {
+    RadixTreeNode **ref = &rm->root;
+    RadixTreeNode *n = *ref;
+    if (!n) return NULL;
+    if (IS_LEAF(n)) {
+        if (!leafMatches(rm, AS_LEAF(n), kb)) return NULL;
+        rm->root = NULL;
+        return AS_LEAF(n);
+    }
+
+    size_t depth = 0;
+    for (;;) {
+        if (n->prefixLen) {
+            size_t stored = MIN(n->prefixLen, ZZ_RADIX_MAX_PREFIX);
+            if (depth + stored > kb->len || memcmp(n->prefix, kb->bytes + depth, stored) != 0) return NULL;
+            depth += n->prefixLen;
+        }
+        if (depth >= kb->len) return NULL;
+
+        unsigned char c = kb->bytes[depth];
+        RadixTreeNode **child = findChild(n, c);
+        if (!child) return NULL;
+        if (IS_LEAF(*child)) {
+            RadixTreeLeaf *leaf = AS_LEAF(*child);
+            if (!leafMatches(rm, leaf, kb)) return NULL;
+            removeChild(ref, n, child, c);
+            return leaf;
+        }
+        ref = child;
+        n = *child;
+        depth++;
+    }
+}
+
+static void unlinkLeaf(zzRadixTreeMap *rm, RadixTreeLeaf *leaf) {
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    else rm->first = leaf->next;
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    else rm->last = leaf->prev;
+}
+
+static void freeLeaf(zzRadixTreeMap *rm, RadixTreeLeaf *leaf) {
+    if (rm->keyFree) rm->keyFree(KEY_PTR(leaf));
+    if (rm->valueFree) rm->valueFree(VAL_PTR(leaf, rm->keySize));
+    free(leaf);
+}
+
+static void freeInnerNodes(RadixTreeNode *n) {
+    if (!n || IS_LEAF(n)) return;
+    switch (n->type) {
+        case ZZ_RADIX_NODE4:
+            for (int i = 0; i < n->numChildren; i++) freeInnerNodes(((RadixNode4*)n)->children[i]);
+            break;
+        case ZZ_RADIX_NODE16:
+            for (int i = 0; i < n->numChildren; i++) freeInnerNodes(((RadixNode16*)n)->children[i]);
+            break;
+        case ZZ_RADIX_NODE48:
+            for (int i = 0; i < 48; i++) freeInnerNodes(((RadixNode48*)n)->children[i]);
+            break;
+        default:
+            for (int i = 0; i < 256; i++) freeInnerNodes(((RadixNode256*)n)->children[i]);
+            break;
+    }
+    free(n);
+}
+
+/**
+ * @brief Initializes a new radix tree map for the given key kind.
+ *
+ * This function initializes an empty radix tree map. Integer keys must be 1, 2,
+ * 4 or 8 bytes wide; string keys are char* values, so keySize must be sizeof(char*).
+ *
+ * @param[out] rm Pointer to the radix tree map structure to initialize
+ * @param[in] keyType Kind of the keys that will be stored in the map
+ * @param[in] keySize Size in bytes of each key that will be stored in the map
+ * @param[in] valueSize Size in bytes of each value that will be stored in the map
+ * @param[in] keyFree Function to free key memory when entries are removed or the map is freed, or NULL if not needed
+ * @param[in] valueFree Function to free value memory when entries are removed or the map is freed, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapInit(zzRadixTreeMap *rm, zzRadixKeyType keyType, size_t keySize, size_t valueSize, zzFreeFn keyFree, zzFreeFn valueFree) {
+    if (!rm) return ZZ_ERR("RadixTreeMap pointer is NULL");
+    if (valueSize == 0) return ZZ_ERR("Value size cannot be zero");
+    if (keyType == ZZ_RADIX_KEY_STRING) {
+        if (keySize != sizeof(char*)) return ZZ_ERR("String keys must be char* values");
+    } else if (keyType == ZZ_RADIX_KEY_UNSIGNED || keyType == ZZ_RADIX_KEY_SIGNED) {
+        if (keySize != 1 && keySize != 2 && keySize != 4 && keySize != 8) return ZZ_ERR("Integer keys must be 1, 2, 4 or 8 bytes");
+    } else {
+        return ZZ_ERR("Unknown key type");
+    }
+
+    rm->root = NULL;
+    rm->first = NULL;
+    rm->last = NULL;
+    rm->size = 0;
+    rm->keySize = keySize;
+    rm->valueSize = valueSize;
+    rm->keyType = keyType;
+    rm->keyFree = keyFree;
+    rm->valueFree = valueFree;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Frees all memory associated with the radix tree map.
+ *
+ * This function frees all nodes and leaves, calling the free functions on every
+ * key and value.
+ *
+ * @param[in,out] rm Pointer to the radix tree map to free
+ */
+void zzRadixTreeMapFree(zzRadixTreeMap *rm) {
+    zzRadixTreeMapClear(rm);
+}
+
+/**
+ * @brief Removes all key-value pairs from the radix tree map.
+ *
+ * @param[in,out] rm Pointer to the radix tree map to clear
+ */
+void zzRadixTreeMapClear(zzRadixTreeMap *rm) {
+    if (!rm) return;
+    freeInnerNodes(rm->root);
+    RadixTreeLeaf *leaf = rm->first;
+    while (leaf) {
+        RadixTreeLeaf *next = leaf->next;
+        freeLeaf(rm, leaf);
+        leaf = next;
+    }
+    rm->root = NULL;
+    rm->first = NULL;
+    rm->last = NULL;
+    rm->size = 0;
+}
+
+/**
+ * @brief Inserts or updates a key-value pair in the radix tree map.
+ *
+ * This function inserts a new key-value pair or replaces the value of an existing
+ * key, growing or splitting at most one inner node.
+ *
+ * @param[in,out] rm Pointer to the radix tree map to insert/update in
+ * @param[in] key Pointer to the key to insert/update (contents will be copied)
+ * @param[in] value Pointer to the value to insert/update (contents will be copied)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapPut(zzRadixTreeMap *rm, const void *key, const void *value) {
+    if (!rm) return ZZ_ERR("RadixTreeMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!value) return ZZ_ERR("Value pointer is NULL");
+
+    KeyBytes kb;
+    encodeKey(rm, key, &kb);
+
+    // The lower bound is either the existing entry or the leaf the new one goes in front of
+    RadixTreeLeaf *succ = lowerBound(rm, &kb);
+    if (succ && leafMatches(rm, succ, &kb)) {
+        if (rm->valueFree) rm->valueFree(VAL_PTR(succ, rm->keySize));
+        memcpy(VAL_PTR(succ, rm->keySize), value, rm->valueSize);
+        return ZZ_OK();
+    }
+
+    RadixTreeLeaf *leaf = malloc(sizeof(RadixTreeLeaf) + rm->keySize + rm->valueSize);
+    if (!leaf) return ZZ_ERR("Memory allocation failed");
+    memcpy(KEY_PTR(leaf), key, rm->keySize);
+    memcpy(VAL_PTR(leaf, rm->keySize), value, rm->valueSize);
+    if (!insertLeaf(rm, &kb, leaf)) {
+        free(leaf);
+        return ZZ_ERR("Memory allocation failed");
+    }
+
+    leaf->next = succ;
+    leaf->prev = succ ? succ->prev : rm->last;
+    if (leaf->prev) leaf->prev->next = leaf;
+    else rm->first = leaf;
+    if (succ) succ->prev = leaf;
+    else rm->last = leaf;
+    rm->size++;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Retrieves the value associated with the given key from the radix tree map.
+ *
+ * @param[in] rm Pointer to the radix tree map to retrieve from
+ * @param[in] key Pointer to the key to look up
+ * @param[out] valueOut Pointer to a buffer where the value will be copied if the key is found
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapGet(const zzRadixTreeMap *rm, const void *key, void *valueOut) {
+    if (!rm) return ZZ_ERR("RadixTreeMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!valueOut) return ZZ_ERR("Value output pointer is NULL");
+
+    KeyBytes kb;
+    encodeKey(rm, key, &kb);
+    RadixTreeLeaf *leaf = findLeaf(rm, &kb);
+    if (!leaf) return ZZ_ERR("Key not found");
+    memcpy(valueOut, VAL_PTR(leaf, rm->keySize), rm->valueSize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Checks if the radix tree map contains the specified key.
+ *
+ * @param[in] rm Pointer to the radix tree map to check
+ * @param[in] key Pointer to the key to look for
+ * @return true if the key exists in the map, false otherwise
+ */
+bool zzRadixTreeMapContains(const zzRadixTreeMap *rm, const void *key) {
+    if (!rm || !key) return false;
+
+    KeyBytes kb;
+    encodeKey(rm, key, &kb);
+    return findLeaf(rm, &kb) != NULL;
+}
+
+/**
+ * @brief Removes a key-value pair from the radix tree map.
+ *
+ * This function removes the entry with the specified key, shrinking the inner
+ * node it hung from and merging single-child nodes into their child's prefix.
+ *
+ * @param[in,out] rm Pointer to the radix tree map to remove from
+ * @param[in] key Pointer to the key to remove
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapRemove(zzRadixTreeMap *rm, const void *key) {
+    if (!rm) return ZZ_ERR("RadixTreeMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+
+    KeyBytes kb;
+    encodeKey(rm, key, &kb);
+    RadixTreeLeaf *leaf = detachLeaf(rm, &kb);
+    if (!leaf) return ZZ_ERR("Key not found");
+
+    unlinkLeaf(rm, leaf);
+    freeLeaf(rm, leaf);
+    rm->size--;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Retrieves the entry with the smallest key in the radix tree map.
+ *
+ * @param[in] rm Pointer to the radix tree map
+ * @param[out] keyOut Pointer to a buffer where the smallest key will be copied
+ * @param[out] valueOut Pointer to a buffer where its value will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapGetMin(const zzRadixTreeMap *rm, void *keyOut, void *valueOut) {
+    if (!rm) return ZZ_ERR("RadixTreeMap pointer is NULL");
+    if (!keyOut || !valueOut) return ZZ_ERR("Output pointer is NULL");
+    if (!rm->first) return ZZ_ERR("RadixTreeMap is empty");
+
+    memcpy(keyOut, KEY_PTR(rm->first), rm->keySize);
+    memcpy(valueOut, VAL_PTR(rm->first, rm->keySize), rm->valueSize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Retrieves the entry with the largest key in the radix tree map.
+ *
+ * @param[in] rm Pointer to the radix tree map
+ * @param[out] keyOut Pointer to a buffer where the largest key will be copied
+ * @param[out] valueOut Pointer to a buffer where its value will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapGetMax(const zzRadixTreeMap *rm, void *keyOut, void *valueOut) {
+    if (!rm) return ZZ_ERR("RadixTreeMap pointer is NULL");
+    if (!keyOut || !valueOut) return ZZ_ERR("Output pointer is NULL");
+    if (!rm->last) return ZZ_ERR("RadixTreeMap is empty");
+
+    memcpy(keyOut, KEY_PTR(rm->last), rm->keySize);
+    memcpy(valueOut, VAL_PTR(rm->last, rm->keySize), rm->valueSize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Initializes an iterator over all entries of the radix tree map in key order.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] rm Pointer to the radix tree map to iterate over
+ */
+void zzRadixTreeMapIteratorInit(zzRadixTreeMapIterator *it, zzRadixTreeMap *rm) {
+    if (!it) return;
+    it->map = rm;
+    it->current = rm ? rm->first : NULL;
+    it->end = NULL;
+    it->lastReturned = NULL;
+    it->state = rm ? ZZ_ITER_VALID : ZZ_ITER_ERROR;
+}
+
+/**
+ * @brief Initializes an iterator over the entries whose keys lie in [lo, hi].
+ *
+ * This function locates both bounds with one descent each and then walks the
+ * leaf list between them.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] rm Pointer to the radix tree map to iterate over
+ * @param[in] lo Pointer to the smallest key of the range
+ * @param[in] hi Pointer to the largest key of the range
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapIteratorInitRange(zzRadixTreeMapIterator *it, zzRadixTreeMap *rm, const void *lo, const void *hi) {
+    if (!it) return ZZ_ERR("Iterator pointer is NULL");
+    if (!rm) return ZZ_ERR("RadixTreeMap pointer is NULL");
+    if (!lo || !hi) return ZZ_ERR("Range bound pointer is NULL");
+
+    KeyBytes loBytes, hiBytes;
+    encodeKey(rm, lo, &loBytes);
+    encodeKey(rm, hi, &hiBytes);
+
+    zzRadixTreeMapIteratorInit(it, rm);
+    if (compareBytes(&loBytes, &hiBytes) > 0) {
+        it->current = NULL;
+        return ZZ_OK();
+    }
+    it->current = lowerBound(rm, &loBytes);
+    it->end = lowerBound(rm, &hiBytes);
+    if (it->end && leafMatches(rm, it->end, &hiBytes)) it->end = it->end->next;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Initializes an iterator over the entries whose key bytes start with a prefix.
+ *
+ * For string keys the prefix is the leading characters of the strings (without a
+ * terminator); for integer keys it is the leading bytes of the big-endian key, so
+ * the first two bytes of a 4-byte IPv4 address select a /16 network. The matching
+ * entries form one subtree, which is found with a single descent.
+ *
+ * @param[out] it Pointer to the iterator to initialize
+ * @param[in] rm Pointer to the radix tree map to iterate over
+ * @param[in] prefix Pointer to the prefix bytes
+ * @param[in] prefixLen Number of prefix bytes
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapIteratorInitPrefix(zzRadixTreeMapIterator *it, zzRadixTreeMap *rm, const void *prefix, size_t prefixLen) {
+    if (!it) return ZZ_ERR("Iterator pointer is NULL");
+    if (!rm) return ZZ_ERR("RadixTreeMap pointer is NULL");
+    if (!prefix && prefixLen > 0) return ZZ_ERR("Prefix pointer is NULL");
+
+    KeyBytes kb;
+    kb.bytes = prefix;
+    kb.len = prefixLen;
+
+    // Descend along the prefix; the subtree below the last matched byte holds exactly the matching keys
+    RadixTreeNode *n = rm->root;
+    size_t depth = 0;
+    while (n && depth < prefixLen) {
+        if (IS_LEAF(n)) {
+            KeyBytes leafKey;
+            encodeKey(rm, KEY_PTR(AS_LEAF(n)), &leafKey);
+            if (leafKey.len < prefixLen || memcmp(leafKey.bytes, kb.bytes, prefixLen) != 0) n = NULL;
+            break;
+        }
+        if (n->prefixLen) {
+            if (prefixMismatch(rm, n, &kb, depth) < MIN((size_t)n->prefixLen, prefixLen - depth)) {
+                n = NULL;
+                break;
+            }
+            depth += n->prefixLen;
+            if (depth >= prefixLen) break;
+        }
+        RadixTreeNode **child = findChild(n, kb.bytes[depth]);
+        n = child ? *child : NULL;
+        depth++;
+    }
+
+    zzRadixTreeMapIteratorInit(it, rm);
+    if (!n) {
+        it->current = NULL;
+        return ZZ_OK();
+    }
+    it->current = minLeaf(n);
+    it->end = maxLeaf(n)->next;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Advances the iterator to the next key-value pair.
+ *
+ * This function copies the current key and value to the output buffers and moves
+ * the iterator to the next key-value pair in sorted order. Returns false when the
+ * iterator reaches the end of its range.
+ *
+ * @param[in,out] it Pointer to the iterator to advance
+ * @param[out] keyOut Pointer to a buffer where the current key will be copied
+ * @param[out] valueOut Pointer to a buffer where the current value will be copied
+ * @return true if a key-value pair was retrieved, false if the iterator reached the end
+ */
+bool zzRadixTreeMapIteratorNext(zzRadixTreeMapIterator *it, void *keyOut, void *valueOut) {
+    if (!it || !keyOut || !valueOut || it->state != ZZ_ITER_VALID) return false;
+    if (!it->current || it->current == it->end) {
+        it->state = ZZ_ITER_END;
+        return false;
+    }
+
+    RadixTreeLeaf *current = it->current;
+    memcpy(keyOut, KEY_PTR(current), it->map->keySize);
+    memcpy(valueOut, VAL_PTR(current, it->map->keySize), it->map->valueSize);
+    it->lastReturned = current;
+    it->current = current->next;
+    return true;
+}
+
+/**
+ * @brief Checks if the iterator has more elements.
+ *
+ * @param[in] it Pointer to the iterator to check
+ * @return true if there are more elements, false otherwise
+ */
+bool zzRadixTreeMapIteratorHasNext(const zzRadixTreeMapIterator *it) {
+    return it && it->state == ZZ_ITER_VALID && it->current && it->current != it->end;
+}
+
+/**
+ * @brief Removes the last key-value pair returned by the iterator.
+ *
+ * The iterator stays positioned on the following entry.
+ *
+ * @param[in,out] it Pointer to the iterator
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzRadixTreeMapIteratorRemove(zzRadixTreeMapIterator *it) {
+    if (!it || it->state != ZZ_ITER_VALID) return ZZ_ERR("Invalid iterator state");
+    if (!it->lastReturned) return ZZ_ERR("No element to remove");
+
+    KeyBytes kb;
+    encodeKey(it->map, KEY_PTR(it->lastReturned), &kb);
+    RadixTreeLeaf *leaf = detachLeaf(it->map, &kb);
+    if (!leaf) return ZZ_ERR("Key not found");
+
+    unlinkLeaf(it->map, leaf);
+    freeLeaf(it->map, leaf);
+    it->map->size--;
+    it->lastReturned = NULL;
+    return ZZ_OK();
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+/**
+ * @file rbTreeOps.h
+ * @brief Private red-black tree rebalancing shared by zzTreeMap, zzTreeSet and zzIntervalTree.
+ *
+ * This header is a template rather than a regular header: a source file defines
+ * the hooks below and then includes it once, which generates static
+ * rbRotateLeft, rbRotateRight, rbInsertFixup, rbTransplant, rbDeleteFixup and
+ * rbDetachNode functions specialized for its node layout. The tree type must have
+ * a root member and the node type left and right members; everything else goes
+ * through the hooks, which are undefined again at the end of this header.
+ *
+ * - RB_TREE, RB_NODE: the tree and node types
+ * - RB_PARENT(n), RB_SET_PARENT(n, p): reads and writes the parent link
+ * - RB_COLOR(n), RB_SET_COLOR(n, c): reads and writes the zzRBColor of a node
+ * - RB_PULL_UP(t, n): recomputes the augmentation of n from its children
+ * - RB_PULL_UP_TO_ROOT(t, n): does the same for n and all its ancestors
+ *
+ * Rotations call RB_PULL_UP on both rotated nodes, lower one first, so subtree
+ * summaries stay correct through every rebalancing step.
+ */
+
+#if !defined(RB_TREE) || !defined(RB_NODE) || !defined(RB_PARENT) || !defined(RB_SET_PARENT) || \
+    !defined(RB_COLOR) || !defined(RB_SET_COLOR) || !defined(RB_PULL_UP) || !defined(RB_PULL_UP_TO_ROOT)
+#error "rbTreeOps.h requires every RB_* hook to be defined before it is included"
+#endif
+
+static void rbRotateLeft(RB_TREE *t, RB_NODE *x) {
+    RB_NODE *y = x->right;
+    x->right = y->left;
+    if (y->left) RB_SET_PARENT(y->left, x);
+    RB_SET_PARENT(y, RB_PARENT(x));
+
+    if (!RB_PARENT(x)) t->root = y;
+    else if (x == RB_PARENT(x)->left) RB_PARENT(x)->left = y;
+    else RB_PARENT(x)->right = y;
+
+    y->left = x;
+    RB_SET_PARENT(x, y);
+
+    RB_PULL_UP(t, x);
+    RB_PULL_UP(t, y);
+}
+
+static void rbRotateRight(RB_TREE *t, RB_NODE *y) {
+    RB_NODE *x = y->left;
+    y->left = x->right;
+    if (x->right) RB_SET_PARENT(x->right, y);
+    RB_SET_PARENT(x, RB_PARENT(y));
+
+    if (!RB_PARENT(y)) t->root = x;
+    else if (y == RB_PARENT(y)->right) RB_PARENT(y)->right = x;
+    else RB_PARENT(y)->left = x;
+
+    x->right = y;
+    RB_SET_PARENT(y, x);
+
+    RB_PULL_UP(t, y);
+    RB_PULL_UP(t, x);
+}
+
+// Restores the red-black properties after z was linked in red; returns true if the black height grew
+static bool rbInsertFixup(RB_TREE *t, RB_NODE *z) {
+    while (RB_PARENT(z) && RB_COLOR(RB_PARENT(z)) == ZZ_RED) {
+        if (RB_PARENT(z) == RB_PARENT(RB_PARENT(z))->left) {
+            RB_NODE *y = RB_PARENT(RB_PARENT(z))->right;
+            if (y && RB_COLOR(y) == ZZ_RED) {
+                RB_SET_COLOR(RB_PARENT(z), ZZ_BLACK);
+                RB_SET_COLOR(y, ZZ_BLACK);
+                RB_SET_COLOR(RB_PARENT(RB_PARENT(z)), ZZ_RED);
+                z = RB_PARENT(RB_PARENT(z));
+            } else {
+                if (z == RB_PARENT(z)->right) {
+                    z = RB_PARENT(z);
+                    rbRotateLeft(t, z);
+                }
+                RB_SET_COLOR(RB_PARENT(z), ZZ_BLACK);
+                RB_SET_COLOR(RB_PARENT(RB_PARENT(z)), ZZ_RED);
+                rbRotateRight(t, RB_PARENT(RB_PARENT(z)));
+            }
+        } else {
+            RB_NODE *y = RB_PARENT(RB_PARENT(z))->left;
+            if (y && RB_COLOR(y) == ZZ_RED) {
+                RB_SET_COLOR(RB_PARENT(z), ZZ_BLACK);
+                RB_SET_COLOR(y, ZZ_BLACK);
+                RB_SET_COLOR(RB_PARENT(RB_PARENT(z)), ZZ_RED);
+                z = RB_PARENT(RB_PARENT(z));
+            } else {
+                if (z == RB_PARENT(z)->left) {
+                    z = RB_PARENT(z);
+                    rbRotateRight(t, z);
+                }
+                RB_SET_COLOR(RB_PARENT(z), ZZ_BLACK);
+                RB_SET_COLOR(RB_PARENT(RB_PARENT(z)), ZZ_RED);
+                rbRotateLeft(t, RB_PARENT(RB_PARENT(z)));
+            }
+        }
+    }
+    bool rootWasRed = RB_COLOR(t->root) == ZZ_RED;
+    RB_SET_COLOR(t->root, ZZ_BLACK);
+    return rootWasRed;
+}
+
+// Replaces the subtree rooted at u with the one rooted at v
+static void rbTransplant(RB_TREE *t, RB_NODE *u, RB_NODE *v) {
+    if (!RB_PARENT(u)) t->root = v;
+    else if (u == RB_PARENT(u)->left) RB_PARENT(u)->left = v;
+    else RB_PARENT(u)->right = v;
+    if (v) RB_SET_PARENT(v, RB_PARENT(u));
+}
+
+// Restores the red-black properties after a black node was removed above x, which may be NULL
+static void rbDeleteFixup(RB_TREE *t, RB_NODE *x, RB_NODE *xParent) {
+    while (x != t->root && (!x || RB_COLOR(x) == ZZ_BLACK)) {
+        if (x == (xParent ? xParent->left : NULL)) {
+            RB_NODE *w = xParent->right;
+            if (w && RB_COLOR(w) == ZZ_RED) {
+                RB_SET_COLOR(w, ZZ_BLACK);
+                RB_SET_COLOR(xParent, ZZ_RED);
+                rbRotateLeft(t, xParent);
+                w = xParent->right;
+            }
+            if (w && (!w->left || RB_COLOR(w->left) == ZZ_BLACK) &&
+                (!w->right || RB_COLOR(w->right) == ZZ_BLACK)) {
+                RB_SET_COLOR(w, ZZ_RED);
+                x = xParent;
+                xParent = x ? RB_PARENT(x) : NULL;
+            } else {
+                if (w && (!w->right || RB_COLOR(w->right) == ZZ_BLACK)) {
+                    if (w->left) RB_SET_COLOR(w->left, ZZ_BLACK);
+                    RB_SET_COLOR(w, ZZ_RED);
+                    rbRotateRight(t, w);
+                    w = xParent->right;
+                }
+                if (w) {
+                    RB_SET_COLOR(w, RB_COLOR(xParent));
+                    if (w->right) RB_SET_COLOR(w->right, ZZ_BLACK);
+                }
+                RB_SET_COLOR(xParent, ZZ_BLACK);
+                rbRotateLeft(t, xParent);
+                x = t->root;
+            }
+        } else {
+            RB_NODE *w = xParent->left;
+            if (w && RB_COLOR(w) == ZZ_RED) {
+                RB_SET_COLOR(w, ZZ_BLACK);
+                RB_SET_COLOR(xParent, ZZ_RED);
+                rbRotateRight(t, xParent);
+                w = xParent->left;
+            }
+            if (w && (!w->right || RB_COLOR(w->right) == ZZ_BLACK) &&
+                (!w->left || RB_COLOR(w->left) == ZZ_BLACK)) {
+                RB_SET_COLOR(w, ZZ_RED);
+                x = xParent;
+                xParent = x ? RB_PARENT(x) : NULL;
+            } else {
+                if (w && (!w->left || RB_COLOR(w->left) == ZZ_BLACK)) {
+                    if (w->right) RB_SET_COLOR(w->right, ZZ_BLACK);
+                    RB_SET_COLOR(w, ZZ_RED);
+                    rbRotateLeft(t, w);
+                    w = xParent->left;
+                }
+                if (w) {
+                    RB_SET_COLOR(w, RB_COLOR(xParent));
+                    if (w->left) RB_SET_COLOR(w->left, ZZ_BLACK);
+                }
+                RB_SET_COLOR(xParent, ZZ_BLACK);
+                rbRotateRight(t, xParent);
+                x = t->root;
+            }
+        }
+    }
+    if (x) RB_SET_COLOR(x, ZZ_BLACK);
+}
+
+// Unlinks node z from the tree and restores the augmentation and red-black properties; z itself is left untouched
+static void rbDetachNode(RB_TREE *t, RB_NODE *z) {
+    RB_NODE *y = z;
+    RB_NODE *x, *xParent;
+    zzRBColor yOrigColor = RB_COLOR(y);
+
+    if (!z->left) {
+        x = z->right;
+        xParent = RB_PARENT(z);
+        rbTransplant(t, z, z->right);
+    } else if (!z->right) {
+        x = z->left;
+        xParent = RB_PARENT(z);
+        rbTransplant(t, z, z->left);
+    } else {
+        y = z->right;
+        while (y->left) y = y->left;
+        yOrigColor = RB_COLOR(y);
+        x = y->right;
+
+        if (RB_PARENT(y) == z) {
+            if (x) RB_SET_PARENT(x, y);
+            xParent = y;
+        } else {
+            xParent = RB_PARENT(y);
+            rbTransplant(t, y, y->right);
+            y->right = z->right;
+            RB_SET_PARENT(y->right, y);
+        }
+
+        rbTransplant(t, z, y);
+        y->left = z->left;
+        RB_SET_PARENT(y->left, y);
+        RB_SET_COLOR(y, RB_COLOR(z));
+    }
+
+    // y, if it replaced z, lies on the path from xParent to the root
+    RB_PULL_UP_TO_ROOT(t, xParent);
+
+    if (yOrigColor == ZZ_BLACK) {
+        rbDeleteFixup(t, x, xParent);
+    }
+}
+
+#undef RB_TREE
+#undef RB_NODE
+#undef RB_PARENT
+#undef RB_SET_PARENT
+#undef RB_COLOR
+#undef RB_SET_COLOR
+#undef RB_PULL_UP
+#undef RB_PULL_UP_TO_ROOT
\ No newline at end of file
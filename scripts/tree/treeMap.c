@@ -4,6 +4,47 @@
 
 #define KEY_PTR(node) ((node)->data)
 #define VAL_PTR(node, keySize) ((node)->data + (keySize))
+#define AGG_PTR(tm, node) ((node)->data + aggOffset(tm))
+#define CNT_PTR(tm, node) ((size_t*)((node)->data + cntOffset(tm)))
+#define PREFIX_PTR(tm, node) ((uint64_t*)((node)->data + prefixOffset(tm)))
+
+// Node link accessors; besides the color, one more low bit marks nodes that live in a slab chunk
+#ifdef ZZ_TREE_COMPACT_NODES
+#define LINK_BITS ((uintptr_t)3)
+#define PARENT(node) ((TreeMapNode*)((node)->parentColor & ~LINK_BITS))
+#define COLOR(node) ((zzRBColor)((node)->parentColor & 1))
+#define IN_SLAB(node) (((node)->parentColor & 2) != 0)
+#define SET_PARENT(node, p) ((node)->parentColor = (uintptr_t)(p) | ((node)->parentColor & LINK_BITS))
+#define SET_COLOR(node, c) ((node)->parentColor = ((node)->parentColor & ~(uintptr_t)1) | (uintptr_t)(c))
+#define MARK_SLAB(node) ((node)->parentColor |= 2)
+#define INIT_LINKS(node) ((node)->parentColor = 0)
+#else
+#define PARENT(node) ((node)->parent)
+#define COLOR(node) ((zzRBColor)((node)->color & 1))
+#define IN_SLAB(node) (((node)->color & 2) != 0)
+#define SET_PARENT(node, p) ((node)->parent = (p))
+#define SET_COLOR(node, c) ((node)->color = (zzRBColor)(((node)->color & 2) | (c)))
+#define MARK_SLAB(node) ((node)->color = (zzRBColor)((node)->color | 2))
+#define INIT_LINKS(node) ((node)->parent = NULL, (node)->color = ZZ_RED)
+#endif
+
+#define SLAB_MIN_CHUNK_BYTES ((size_t)64 * 1024)
+
+// Number of lookups zzTreeMapGetBatch keeps in flight at once
+#define BATCH_LANES 8
+// Upper bound on red-black tree height (at most 2*log2(n+1)) for any size_t-sized tree
+#define MAX_TREE_HEIGHT 128
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr) ((void)(addr))
+#endif
+
+// Header at the start of every slab chunk; chunks are aligned to their size so a node finds its chunk by masking
+typedef struct SlabChunk {
+    size_t live;    // Number of nodes in the chunk that have not been released yet
+} SlabChunk;
 
 /**
  * @brief Initializes a new TreeMap with the specified key and value sizes.
@@ -27,22 +68,209 @@ zzOpResult zzTreeMapInit(zzTreeMap *tm, size_t keySize, size_t valueSize, zzComp
     if (!compareFn) return ZZ_ERR("Comparison function is NULL");
 
     tm->root = NULL;
+    tm->first = NULL;
+    tm->last = NULL;
     tm->size = 0;
     tm->keySize = keySize;
     tm->valueSize = valueSize;
     tm->compareFn = compareFn;
     tm->keyFree = keyFree;
     tm->valueFree = valueFree;
+    tm->augmented = false;
+    tm->aggSize = 0;
+    tm->aggInit = NULL;
+    tm->aggCombine = NULL;
+    tm->prefixFn = NULL;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Initializes a new augmented TreeMap for order-statistic and aggregate queries.
+ *
+ * This function initializes a TreeMap like zzTreeMapInit, but every node additionally
+ * tracks the size of its subtree and, when aggregate functions are given, an aggregate
+ * of all values in its subtree. The augmentation is maintained through insertions,
+ * removals and rotations, enabling O(log n) rank, select and range-aggregate queries.
+ *
+ * @param[out] tm Pointer to the TreeMap structure to initialize
+ * @param[in] keySize Size in bytes of each key that will be stored in the map
+ * @param[in] valueSize Size in bytes of each value that will be stored in the map
+ * @param[in] compareFn Function to compare keys for ordering (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] keyFree Function to free key memory when entries are removed or the map is freed, or NULL if not needed
+ * @param[in] valueFree Function to free value memory when entries are removed or the map is freed, or NULL if not needed
+ * @param[in] aggSize Size in bytes of the value aggregate, or 0 to only track subtree sizes
+ * @param[in] aggInit Function to seed an aggregate from a single value (required if aggSize is non-zero)
+ * @param[in] aggCombine Associative function combining two adjacent aggregates (required if aggSize is non-zero)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapInitAugmented(zzTreeMap *tm, size_t keySize, size_t valueSize, zzCompareFn compareFn, zzFreeFn keyFree, zzFreeFn valueFree,
+                                  size_t aggSize, zzAggregateInitFn aggInit, zzAggregateCombineFn aggCombine) {
+    if (aggSize > 0 && (!aggInit || !aggCombine)) return ZZ_ERR("Aggregate functions are NULL");
+
+    zzOpResult res = zzTreeMapInit(tm, keySize, valueSize, compareFn, keyFree, valueFree);
+    if (ZZ_IS_ERR(res)) return res;
+
+    tm->augmented = true;
+    tm->aggSize = aggSize;
+    tm->aggInit = aggSize > 0 ? aggInit : NULL;
+    tm->aggCombine = aggSize > 0 ? aggCombine : NULL;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Enables cached key prefixes on an empty TreeMap.
+ *
+ * This function makes every node also store a normalized 64-bit prefix of its
+ * key, computed by prefixFn. Lookups compare these prefixes with a single integer
+ * comparison first and only call the comparison function when two prefixes tie,
+ * so keys held out of line (such as strings) are rarely dereferenced during a
+ * descent. zzIntPrefix, zzLongPrefix and zzStringPrefix cover the built-in key
+ * types. The prefix must agree with the comparison function as described for
+ * zzKeyPrefixFn. Because it changes the node layout, the map must be empty;
+ * passing NULL turns the cache off again. Works with both plain and augmented maps.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to configure
+ * @param[in] prefixFn Function extracting the key prefix, or NULL to disable prefix caching
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapSetKeyPrefix(zzTreeMap *tm, zzKeyPrefixFn prefixFn) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (tm->size > 0) return ZZ_ERR("TreeMap is not empty");
+
+    tm->prefixFn = prefixFn;
     return ZZ_OK();
 }
 
-static void zzTreeMapFreeNode(zzTreeMap *tm, TreeMapNode *node) {
+// The cached key prefix sits at the first 8-byte boundary after the key and value
+static size_t prefixOffset(const zzTreeMap *tm) {
+    const size_t align = sizeof(uint64_t);
+    size_t end = offsetof(TreeMapNode, data) + tm->keySize + tm->valueSize;
+    return (end + align - 1) / align * align - offsetof(TreeMapNode, data);
+}
+
+// Bytes of node data taken by the key, the value and the cached prefix, if any
+static size_t payloadBytes(const zzTreeMap *tm) {
+    return tm->prefixFn ? prefixOffset(tm) + sizeof(uint64_t) : tm->keySize + tm->valueSize;
+}
+
+// The aggregate is placed at a max_align_t boundary so callbacks may access it directly
+static size_t aggOffset(const zzTreeMap *tm) {
+    const size_t align = _Alignof(max_align_t);
+    size_t end = offsetof(TreeMapNode, data) + payloadBytes(tm);
+    return (end + align - 1) / align * align - offsetof(TreeMapNode, data);
+}
+
+static size_t cntOffset(const zzTreeMap *tm) {
+    return aggOffset(tm) + (tm->aggSize + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+}
+
+static size_t nodeBytes(const zzTreeMap *tm) {
+    if (!tm->augmented && !tm->prefixFn) return sizeof(TreeMapNode) + tm->keySize + tm->valueSize;
+    if (!tm->augmented) return offsetof(TreeMapNode, data) + payloadBytes(tm);
+    return offsetof(TreeMapNode, data) + cntOffset(tm) + sizeof(size_t);
+}
+
+static size_t subtreeSize(const zzTreeMap *tm, const TreeMapNode *node) {
+    return node ? *CNT_PTR(tm, node) : 0;
+}
+
+// Recomputes the subtree size and aggregate of a node from its children
+static void pullUp(const zzTreeMap *tm, TreeMapNode *node) {
+    if (!tm->augmented) return;
+
+    *CNT_PTR(tm, node) = 1 + subtreeSize(tm, node->left) + subtreeSize(tm, node->right);
+
+    if (tm->aggSize == 0) return;
+    unsigned char *agg = AGG_PTR(tm, node);
+    tm->aggInit(agg, VAL_PTR(node, tm->keySize));
+    if (node->left) tm->aggCombine(agg, AGG_PTR(tm, node->left), agg);
+    if (node->right) tm->aggCombine(agg, agg, AGG_PTR(tm, node->right));
+}
+
+static void pullUpToRoot(const zzTreeMap *tm, TreeMapNode *node) {
+    if (!tm->augmented) return;
+    for (; node; node = PARENT(node)) pullUp(tm, node);
+}
+
+// Rotations, insert and delete fixups shared with the other red-black trees, keeping sizes and aggregates current
+#define RB_TREE zzTreeMap
+#define RB_NODE TreeMapNode
+#define RB_PARENT(node) PARENT(node)
+#define RB_SET_PARENT(node, p) SET_PARENT(node, p)
+#define RB_COLOR(node) COLOR(node)
+#define RB_SET_COLOR(node, c) SET_COLOR(node, c)
+#define RB_PULL_UP(tm, node) pullUp(tm, node)
+#define RB_PULL_UP_TO_ROOT(tm, node) pullUpToRoot(tm, node)
+#include "rbTreeOps.h"
+
+// Prefix of a probe key, or 0 when the TreeMap does not cache prefixes
+static uint64_t probePrefix(const zzTreeMap *tm, const void *key) {
+    return tm->prefixFn ? tm->prefixFn(key) : 0;
+}
+
+// Compares a probe key with a node's key, deciding on the cached prefixes whenever they differ
+static int compareKey(const zzTreeMap *tm, const void *key, uint64_t keyPrefix, const TreeMapNode *node) {
+    if (tm->prefixFn) {
+        uint64_t nodePrefix = *PREFIX_PTR(tm, node);
+        if (keyPrefix != nodePrefix) return (keyPrefix < nodePrefix) ? -1 : 1;
+    }
+    return tm->compareFn(key, KEY_PTR(node));
+}
+
+// Stores the cached prefix of a node whose key has just been written
+static void storePrefix(const zzTreeMap *tm, TreeMapNode *node) {
+    if (tm->prefixFn) *PREFIX_PTR(tm, node) = tm->prefixFn(KEY_PTR(node));
+}
+
+// Allocates a heap node with cleared link bits
+static TreeMapNode *allocNode(const zzTreeMap *tm) {
+    TreeMapNode *node = malloc(nodeBytes(tm));
+    if (node) INIT_LINKS(node);
+    return node;
+}
+
+static size_t slabStride(const zzTreeMap *tm) {
+    const size_t align = _Alignof(max_align_t);
+    return (nodeBytes(tm) + align - 1) / align * align;
+}
+
+static size_t slabHeaderBytes(void) {
+    const size_t align = _Alignof(max_align_t);
+    return (sizeof(SlabChunk) + align - 1) / align * align;
+}
+
+static size_t slabChunkBytes(const zzTreeMap *tm) {
+    size_t bytes = SLAB_MIN_CHUNK_BYTES;
+    while (bytes < slabHeaderBytes() + slabStride(tm)) bytes *= 2;
+    return bytes;
+}
+
+// Frees a heap node, or releases a slab node and frees its chunk once the last node in it is gone
+static void releaseNode(const zzTreeMap *tm, TreeMapNode *node) {
+    if (!IN_SLAB(node)) {
+        free(node);
+        return;
+    }
+    SlabChunk *chunk = (SlabChunk*)((uintptr_t)node & ~(uintptr_t)(slabChunkBytes(tm) - 1));
+    if (--chunk->live == 0) free(chunk);
+}
+
+// Releases the nodes of a subtree without touching the keys and values they hold
+static void releaseSubtree(const zzTreeMap *tm, TreeMapNode *node) {
     if (!node) return;
-    zzTreeMapFreeNode(tm, node->left);
-    zzTreeMapFreeNode(tm, node->right);
+    releaseSubtree(tm, node->left);
+    releaseSubtree(tm, node->right);
+    releaseNode(tm, node);
+}
+
+// Frees the subtree rooted at node and returns the number of nodes freed
+static size_t zzTreeMapFreeNode(zzTreeMap *tm, TreeMapNode *node) {
+    if (!node) return 0;
+    size_t freed = 1 + zzTreeMapFreeNode(tm, node->left) + zzTreeMapFreeNode(tm, node->right);
     if (tm->keyFree) tm->keyFree(KEY_PTR(node));
     if (tm->valueFree) tm->valueFree(VAL_PTR(node, tm->keySize));
-    free(node);
+    releaseNode(tm, node);
+    return freed;
 }
 
 /**
@@ -58,76 +286,11 @@ void zzTreeMapFree(zzTreeMap *tm) {
     if (!tm) return;
     zzTreeMapFreeNode(tm, tm->root);
     tm->root = NULL;
+    tm->first = NULL;
+    tm->last = NULL;
     tm->size = 0;
 }
 
-static void rotateLeft(zzTreeMap *tm, TreeMapNode *x) {
-    TreeMapNode *y = x->right;
-    x->right = y->left;
-    if (y->left) y->left->parent = x;
-    y->parent = x->parent;
-    
-    if (!x->parent) tm->root = y;
-    else if (x == x->parent->left) x->parent->left = y;
-    else x->parent->right = y;
-    
-    y->left = x;
-    x->parent = y;
-}
-
-static void rotateRight(zzTreeMap *tm, TreeMapNode *y) {
-    TreeMapNode *x = y->left;
-    y->left = x->right;
-    if (x->right) x->right->parent = y;
-    x->parent = y->parent;
-    
-    if (!y->parent) tm->root = x;
-    else if (y == y->parent->right) y->parent->right = x;
-    else y->parent->left = x;
-    
-    x->right = y;
-    y->parent = x;
-}
-
-static void insertFixup(zzTreeMap *tm, TreeMapNode *z) {
-    while (z->parent && z->parent->color == ZZ_RED) {
-        if (z->parent == z->parent->parent->left) {
-            TreeMapNode *y = z->parent->parent->right;
-            if (y && y->color == ZZ_RED) {
-                z->parent->color = ZZ_BLACK;
-                y->color = ZZ_BLACK;
-                z->parent->parent->color = ZZ_RED;
-                z = z->parent->parent;
-            } else {
-                if (z == z->parent->right) {
-                    z = z->parent;
-                    rotateLeft(tm, z);
-                }
-                z->parent->color = ZZ_BLACK;
-                z->parent->parent->color = ZZ_RED;
-                rotateRight(tm, z->parent->parent);
-            }
-        } else {
-            TreeMapNode *y = z->parent->parent->left;
-            if (y && y->color == ZZ_RED) {
-                z->parent->color = ZZ_BLACK;
-                y->color = ZZ_BLACK;
-                z->parent->parent->color = ZZ_RED;
-                z = z->parent->parent;
-            } else {
-                if (z == z->parent->left) {
-                    z = z->parent;
-                    rotateRight(tm, z);
-                }
-                z->parent->color = ZZ_BLACK;
-                z->parent->parent->color = ZZ_RED;
-                rotateLeft(tm, z->parent->parent);
-            }
-        }
-    }
-    tm->root->color = ZZ_BLACK;
-}
-
 /**
  * @brief Inserts or updates a key-value pair in the TreeMap.
  *
@@ -146,35 +309,42 @@ zzOpResult zzTreeMapPut(zzTreeMap *tm, const void *key, const void *value) {
     if (!key) return ZZ_ERR("Key pointer is NULL");
     if (!value) return ZZ_ERR("Value pointer is NULL");
 
+    uint64_t keyPrefix = probePrefix(tm, key);
     TreeMapNode *parent = NULL;
     TreeMapNode *cur = tm->root;
+    int cmp = 0;
 
     while (cur) {
         parent = cur;
-        int cmp = tm->compareFn(key, KEY_PTR(cur));
+        cmp = compareKey(tm, key, keyPrefix, cur);
         if (cmp == 0) {
             if (tm->valueFree) tm->valueFree(VAL_PTR(cur, tm->keySize));
             memcpy(VAL_PTR(cur, tm->keySize), value, tm->valueSize);
+            if (tm->aggSize > 0) pullUpToRoot(tm, cur);
             return ZZ_OK();
         }
         cur = (cmp < 0) ? cur->left : cur->right;
     }
 
-    TreeMapNode *node = malloc(sizeof(TreeMapNode) + tm->keySize + tm->valueSize);
+    TreeMapNode *node = allocNode(tm);
     if (!node) return ZZ_ERR("Failed to allocate node");
 
     memcpy(KEY_PTR(node), key, tm->keySize);
+    storePrefix(tm, node);
     memcpy(VAL_PTR(node, tm->keySize), value, tm->valueSize);
     node->left = node->right = NULL;
-    node->parent = parent;
-    node->color = ZZ_RED;
+    SET_PARENT(node, parent);
+    SET_COLOR(node, ZZ_RED);
 
     if (!parent) tm->root = node;
-    else if (tm->compareFn(key, KEY_PTR(parent)) < 0) parent->left = node;
+    else if (cmp < 0) parent->left = node;
     else parent->right = node;
+    if (!tm->first || (parent == tm->first && cmp < 0)) tm->first = node;
+    if (!tm->last || (parent == tm->last && cmp > 0)) tm->last = node;
 
     tm->size++;
-    insertFixup(tm, node);
+    pullUpToRoot(tm, node);
+    rbInsertFixup(tm, node);
     return ZZ_OK();
 }
 
@@ -195,9 +365,10 @@ zzOpResult zzTreeMapGet(const zzTreeMap *tm, const void *key, void *valueOut) {
     if (!key) return ZZ_ERR("Key pointer is NULL");
     if (!valueOut) return ZZ_ERR("Value output pointer is NULL");
 
+    uint64_t keyPrefix = probePrefix(tm, key);
     TreeMapNode *cur = tm->root;
     while (cur) {
-        int cmp = tm->compareFn(key, KEY_PTR(cur));
+        int cmp = compareKey(tm, key, keyPrefix, cur);
         if (cmp == 0) {
             memcpy(valueOut, VAL_PTR(cur, tm->keySize), tm->valueSize);
             return ZZ_OK();
@@ -219,15 +390,163 @@ zzOpResult zzTreeMapGet(const zzTreeMap *tm, const void *key, void *valueOut) {
 bool zzTreeMapContains(const zzTreeMap *tm, const void *key) {
     if (!tm || !key) return false;
     
+    uint64_t keyPrefix = probePrefix(tm, key);
     TreeMapNode *cur = tm->root;
     while (cur) {
-        int cmp = tm->compareFn(key, KEY_PTR(cur));
+        int cmp = compareKey(tm, key, keyPrefix, cur);
         if (cmp == 0) return true;
         cur = (cmp < 0) ? cur->left : cur->right;
     }
     return false;
 }
 
+// State of one in-flight lookup of zzTreeMapGetBatch
+typedef struct BatchLane {
+    const TreeMapNode *node;    // Next node to compare against, already prefetched
+    size_t index;               // Position of the lookup's key in the batch
+    uint64_t keyPrefix;         // Cached prefix of the lookup's key
+} BatchLane;
+
+/**
+ * @brief Looks up a batch of independent keys with interleaved descents.
+ *
+ * This function keeps up to eight lookups in flight as a small state machine: after
+ * each comparison it prefetches the chosen child and switches to the next lookup,
+ * so the cache misses of the different descents overlap instead of being paid one
+ * after another. Each found value is copied to its slot in valuesOut; the slots of
+ * missing keys are left untouched.
+ *
+ * @param[in] tm Pointer to the TreeMap to retrieve from
+ * @param[in] keys Pointer to an array of count keys in any order
+ * @param[in] count Number of keys in the array
+ * @param[out] valuesOut Pointer to an array of count value slots receiving the found values
+ * @param[out] foundOut Pointer to an array of count flags telling which keys were found, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapGetBatch(const zzTreeMap *tm, const void *keys, size_t count, void *valuesOut, bool *foundOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (count == 0) return ZZ_OK();
+    if (!keys) return ZZ_ERR("Keys pointer is NULL");
+    if (!valuesOut) return ZZ_ERR("Values output pointer is NULL");
+
+    const unsigned char *keyBytes = keys;
+    unsigned char *valueBytes = valuesOut;
+    BatchLane lanes[BATCH_LANES];
+    size_t active = 0, next = 0;
+
+    if (foundOut) memset(foundOut, 0, count * sizeof(bool));
+    if (!tm->root) return ZZ_OK();
+
+    PREFETCH(tm->root);
+    while (active < BATCH_LANES && next < count) {
+        lanes[active].node = tm->root;
+        lanes[active].index = next;
+        lanes[active].keyPrefix = probePrefix(tm, keyBytes + next * tm->keySize);
+        active++, next++;
+    }
+
+    while (active > 0) {
+        for (size_t i = 0; i < active; ) {
+            BatchLane *lane = &lanes[i];
+            const void *key = keyBytes + lane->index * tm->keySize;
+            int cmp = compareKey(tm, key, lane->keyPrefix, lane->node);
+            if (cmp == 0) {
+                memcpy(valueBytes + lane->index * tm->valueSize, VAL_PTR(lane->node, tm->keySize), tm->valueSize);
+                if (foundOut) foundOut[lane->index] = true;
+                lane->node = NULL;
+            } else {
+                lane->node = (cmp < 0) ? lane->node->left : lane->node->right;
+            }
+
+            if (lane->node) {
+                PREFETCH(lane->node);
+                i++;
+            } else if (next < count) {
+                // Finished lookup: the lane starts on the next key of the batch
+                lane->node = tm->root;
+                lane->index = next;
+                lane->keyPrefix = probePrefix(tm, keyBytes + next * tm->keySize);
+                next++, i++;
+            } else {
+                lanes[i] = lanes[--active];
+            }
+        }
+    }
+    return ZZ_OK();
+}
+
+/**
+ * @brief Looks up a batch of keys sorted in ascending order, reusing the previous path.
+ *
+ * This function remembers the path of the previous lookup as a finger and resumes
+ * the next descent from the lowest remembered node whose subtree can still contain
+ * the key, so runs of nearby keys cost far fewer comparisons and cache misses than
+ * independent descents from the root. A key that is smaller than its predecessor
+ * simply restarts from the root, so unsorted input still yields correct results.
+ * Each found value is copied to its slot in valuesOut; the slots of missing keys
+ * are left untouched.
+ *
+ * @param[in] tm Pointer to the TreeMap to retrieve from
+ * @param[in] keys Pointer to an array of count keys, ideally in ascending order
+ * @param[in] count Number of keys in the array
+ * @param[out] valuesOut Pointer to an array of count value slots receiving the found values
+ * @param[out] foundOut Pointer to an array of count flags telling which keys were found, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapGetBatchSorted(const zzTreeMap *tm, const void *keys, size_t count, void *valuesOut, bool *foundOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (count == 0) return ZZ_OK();
+    if (!keys) return ZZ_ERR("Keys pointer is NULL");
+    if (!valuesOut) return ZZ_ERR("Values output pointer is NULL");
+
+    const unsigned char *keyBytes = keys;
+    unsigned char *valueBytes = valuesOut;
+    // path holds the previous descent; leftTurns indexes the path nodes it went left at,
+    // whose keys bound the subtrees below them from above
+    const TreeMapNode *path[MAX_TREE_HEIGHT];
+    size_t leftTurns[MAX_TREE_HEIGHT];
+    size_t depth = 0, turns = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const void *key = keyBytes + i * tm->keySize;
+        uint64_t keyPrefix = probePrefix(tm, key);
+
+        if (depth > 0 && tm->compareFn(key, keyBytes + (i - 1) * tm->keySize) < 0) depth = turns = 0;
+
+        const TreeMapNode *cur = tm->root;
+        if (depth > 0) {
+            // Climb past every left turn whose key no longer bounds the new key
+            size_t resume = depth - 1;
+            while (turns > 0 && compareKey(tm, key, keyPrefix, path[leftTurns[turns - 1]]) >= 0) {
+                resume = leftTurns[--turns];
+            }
+            // The descent is replayed from the resume node, so forget any turn taken there
+            if (turns > 0 && leftTurns[turns - 1] == resume) turns--;
+            cur = path[resume];
+            depth = resume;
+        }
+
+        bool found = false;
+        while (cur) {
+            path[depth++] = cur;
+            int cmp = compareKey(tm, key, keyPrefix, cur);
+            if (cmp == 0) {
+                memcpy(valueBytes + i * tm->valueSize, VAL_PTR(cur, tm->keySize), tm->valueSize);
+                found = true;
+                break;
+            }
+            if (cmp < 0) {
+                leftTurns[turns++] = depth - 1;
+                cur = cur->left;
+            } else {
+                cur = cur->right;
+            }
+        }
+        if (foundOut) foundOut[i] = found;
+    }
+    return ZZ_OK();
+}
+
 static TreeMapNode *zzTreeMapMin(TreeMapNode *node) {
     while (node && node->left) node = node->left;
     return node;
@@ -238,74 +557,16 @@ static TreeMapNode *zzTreeMapMax(TreeMapNode *node) {
     return node;
 }
 
-static void transplant(zzTreeMap *tm, TreeMapNode *u, TreeMapNode *v) {
-    if (!u->parent) tm->root = v;
-    else if (u == u->parent->left) u->parent->left = v;
-    else u->parent->right = v;
-    if (v) v->parent = u->parent;
+// Moves the cached first and last pointers off z before it is detached
+static void dropBounds(zzTreeMap *tm, TreeMapNode *z) {
+    if (z == tm->first) tm->first = z->right ? zzTreeMapMin(z->right) : PARENT(z);
+    if (z == tm->last) tm->last = z->left ? zzTreeMapMax(z->left) : PARENT(z);
 }
 
-static void deleteFixup(zzTreeMap *tm, TreeMapNode *x, TreeMapNode *xParent) {
-    while (x != tm->root && (!x || x->color == ZZ_BLACK)) {
-        if (x == (xParent ? xParent->left : NULL)) {
-            TreeMapNode *w = xParent->right;
-            if (w && w->color == ZZ_RED) {
-                w->color = ZZ_BLACK;
-                xParent->color = ZZ_RED;
-                rotateLeft(tm, xParent);
-                w = xParent->right;
-            }
-            if (w && (!w->left || w->left->color == ZZ_BLACK) &&
-                (!w->right || w->right->color == ZZ_BLACK)) {
-                w->color = ZZ_RED;
-                x = xParent;
-                xParent = x ? x->parent : NULL;
-            } else {
-                if (w && (!w->right || w->right->color == ZZ_BLACK)) {
-                    if (w->left) w->left->color = ZZ_BLACK;
-                    w->color = ZZ_RED;
-                    rotateRight(tm, w);
-                    w = xParent->right;
-                }
-                if (w) {
-                    w->color = xParent->color;
-                    if (w->right) w->right->color = ZZ_BLACK;
-                }
-                xParent->color = ZZ_BLACK;
-                rotateLeft(tm, xParent);
-                x = tm->root;
-            }
-        } else {
-            TreeMapNode *w = xParent->left;
-            if (w && w->color == ZZ_RED) {
-                w->color = ZZ_BLACK;
-                xParent->color = ZZ_RED;
-                rotateRight(tm, xParent);
-                w = xParent->left;
-            }
-            if (w && (!w->right || w->right->color == ZZ_BLACK) &&
-                (!w->left || w->left->color == ZZ_BLACK)) {
-                w->color = ZZ_RED;
-                x = xParent;
-                xParent = x ? x->parent : NULL;
-            } else {
-                if (w && (!w->left || w->left->color == ZZ_BLACK)) {
-                    if (w->right) w->right->color = ZZ_BLACK;
-                    w->color = ZZ_RED;
-                    rotateLeft(tm, w);
-                    w = xParent->left;
-                }
-                if (w) {
-                    w->color = xParent->color;
-                    if (w->left) w->left->color = ZZ_BLACK;
-                }
-                xParent->color = ZZ_BLACK;
-                rotateRight(tm, xParent);
-                x = tm->root;
-            }
-        }
-    }
-    if (x) x->color = ZZ_BLACK;
+// Recomputes the cached first and last pointers after the tree was relinked wholesale
+static void refreshBounds(zzTreeMap *tm) {
+    tm->first = zzTreeMapMin(tm->root);
+    tm->last = zzTreeMapMax(tm->root);
 }
 
 /**
@@ -325,57 +586,23 @@ zzOpResult zzTreeMapRemove(zzTreeMap *tm, const void *key) {
     if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
     if (!key) return ZZ_ERR("Key pointer is NULL");
 
+    uint64_t keyPrefix = probePrefix(tm, key);
     TreeMapNode *z = tm->root;
     while (z) {
-        int cmp = tm->compareFn(key, KEY_PTR(z));
+        int cmp = compareKey(tm, key, keyPrefix, z);
         if (cmp == 0) break;
         z = (cmp < 0) ? z->left : z->right;
     }
     if (!z) return ZZ_ERR("Key not found");
 
-    TreeMapNode *y = z;
-    TreeMapNode *x, *xParent;
-    zzRBColor yOrigColor = y->color;
-
-    if (!z->left) {
-        x = z->right;
-        xParent = z->parent;
-        transplant(tm, z, z->right);
-    } else if (!z->right) {
-        x = z->left;
-        xParent = z->parent;
-        transplant(tm, z, z->left);
-    } else {
-        y = zzTreeMapMin(z->right);
-        yOrigColor = y->color;
-        x = y->right;
-        xParent = y;
-
-        if (y->parent == z) {
-            if (x) x->parent = y;
-            xParent = y;
-        } else {
-            xParent = y->parent;
-            transplant(tm, y, y->right);
-            y->right = z->right;
-            y->right->parent = y;
-        }
-
-        transplant(tm, z, y);
-        y->left = z->left;
-        y->left->parent = y;
-        y->color = z->color;
-    }
+    dropBounds(tm, z);
+    rbDetachNode(tm, z);
 
     if (tm->keyFree) tm->keyFree(KEY_PTR(z));
     if (tm->valueFree) tm->valueFree(VAL_PTR(z, tm->keySize));
-    free(z);
+    releaseNode(tm, z);
     tm->size--;
 
-    if (yOrigColor == ZZ_BLACK) {
-        deleteFixup(tm, x, xParent);
-    }
-
     return ZZ_OK();
 }
 
@@ -392,15 +619,324 @@ void zzTreeMapClear(zzTreeMap *tm) {
     if (!tm) return;
     zzTreeMapFreeNode(tm, tm->root);
     tm->root = NULL;
+    tm->first = NULL;
+    tm->last = NULL;
     tm->size = 0;
 }
 
+static TreeMapNode *nextNode(TreeMapNode *node) {
+    if (node->right) return zzTreeMapMin(node->right);
+    TreeMapNode *parent = PARENT(node);
+    while (parent && node == parent->right) {
+        node = parent;
+        parent = PARENT(parent);
+    }
+    return parent;
+}
+
+// Depth of the incomplete bottom level of a balanced tree holding count nodes
+static int redLevelFor(size_t count) {
+    int level = 0;
+    for (size_t m = count + 1; m > 1; m >>= 1) level++;
+    return level;
+}
+
+// Links nodes[lo, hi) into a balanced subtree; only the incomplete bottom level is red
+static TreeMapNode *linkBalanced(const zzTreeMap *tm, TreeMapNode **nodes, size_t lo, size_t hi,
+                                 int depth, int redLevel, TreeMapNode *parent) {
+    if (lo >= hi) return NULL;
+
+    size_t mid = lo + (hi - lo) / 2;
+    TreeMapNode *node = nodes[mid];
+    SET_PARENT(node, parent);
+    SET_COLOR(node, (depth == redLevel) ? ZZ_RED : ZZ_BLACK);
+    node->left = linkBalanced(tm, nodes, lo, mid, depth + 1, redLevel, node);
+    node->right = linkBalanced(tm, nodes, mid + 1, hi, depth + 1, redLevel, node);
+    pullUp(tm, node);
+    return node;
+}
+
+static void linkSorted(zzTreeMap *tm, TreeMapNode **nodes, size_t count) {
+    tm->root = linkBalanced(tm, nodes, 0, count, 0, redLevelFor(count), NULL);
+    tm->first = count > 0 ? nodes[0] : NULL;
+    tm->last = count > 0 ? nodes[count - 1] : NULL;
+    tm->size = count;
+}
+
+// Frees the entries for which pred returns verdict and relinks the survivors into a balanced
+// tree. The nodes are gathered in order first because a freed node may still be on the path
+// the in-order walk climbs back through.
+static zzOpResult zzTreeMapRemoveMatching(zzTreeMap *tm, zzEntryPredicateFn pred, void *userdata, bool verdict, size_t *removedOut) {
+    size_t count = tm->size, kept = 0;
+    if (count > 0) {
+        TreeMapNode **nodes = malloc(count * sizeof(*nodes));
+        if (!nodes) return ZZ_ERR("Memory allocation failed");
+
+        size_t n = 0;
+        for (TreeMapNode *node = tm->first; node; node = nextNode(node)) nodes[n++] = node;
+
+        for (size_t i = 0; i < count; i++) {
+            TreeMapNode *node = nodes[i];
+            if (pred(KEY_PTR(node), VAL_PTR(node, tm->keySize), userdata) != verdict) {
+                nodes[kept++] = node;
+                continue;
+            }
+            if (tm->keyFree) tm->keyFree(KEY_PTR(node));
+            if (tm->valueFree) tm->valueFree(VAL_PTR(node, tm->keySize));
+            releaseNode(tm, node);
+        }
+        if (kept < count) linkSorted(tm, nodes, kept);
+        free(nodes);
+    }
+    if (removedOut) *removedOut = count - kept;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Removes every entry for which the predicate returns true.
+ *
+ * This function tests each key-value pair once, in ascending key order, frees
+ * the matching entries and relinks the remaining nodes into a balanced tree
+ * without any rotations, so it runs in O(n) time however many entries are
+ * removed. Subtree sizes and aggregates are recomputed during relinking. If
+ * custom free functions were provided, they are called on the key and value of
+ * every removed entry. The predicate must not modify the map. A temporary array
+ * of n node pointers is allocated; if that fails the map is left unchanged.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to filter
+ * @param[in] pred Function selecting the entries to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRemoveIf(zzTreeMap *tm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+    return zzTreeMapRemoveMatching(tm, pred, userdata, true, removedOut);
+}
+
+/**
+ * @brief Keeps only the entries for which the predicate returns true.
+ *
+ * This function is the complement of zzTreeMapRemoveIf and removes every entry
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to filter
+ * @param[in] pred Function selecting the entries to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed entries, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRetainIf(zzTreeMap *tm, zzEntryPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+    return zzTreeMapRemoveMatching(tm, pred, userdata, false, removedOut);
+}
+
+// Stable bottom-up merge sort of pointers into a key array
+static void sortKeyRefs(const zzTreeMap *tm, const unsigned char **refs, const unsigned char **tmp, size_t count) {
+    const unsigned char **src = refs, **dst = tmp;
+    for (size_t width = 1; width < count; width *= 2) {
+        for (size_t lo = 0; lo < count; lo += 2 * width) {
+            size_t mid = (lo + width < count) ? lo + width : count;
+            size_t hi = (lo + 2 * width < count) ? lo + 2 * width : count;
+            size_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                dst[k++] = (tm->compareFn(src[j], src[i]) < 0) ? src[j++] : src[i++];
+            }
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi) dst[k++] = src[j++];
+        }
+        const unsigned char **swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != refs) memcpy(refs, src, count * sizeof(*refs));
+}
+
+// Maps a pointer into the batch key array to the matching entry of the value array
+static const unsigned char *batchValue(const zzTreeMap *tm, const unsigned char *keys, const unsigned char *values,
+                                       const unsigned char *keyRef) {
+    return values + (size_t)(keyRef - keys) / tm->keySize * tm->valueSize;
+}
+
+/**
+ * @brief Replaces the contents of the TreeMap with entries from sorted arrays.
+ *
+ * This function builds a perfectly balanced red-black tree from count keys and
+ * values stored contiguously in the given arrays, in O(n) time and without any
+ * rotations. The keys must be in strictly ascending order according to the
+ * map's comparison function. Existing entries are cleared only after the input
+ * has been validated and all nodes have been allocated, so on failure the map
+ * is left unchanged.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to build
+ * @param[in] keys Pointer to an array of count keys in strictly ascending order (contents will be copied)
+ * @param[in] values Pointer to an array of count values matching the keys (contents will be copied)
+ * @param[in] count Number of entries in the arrays
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapBuildFromSorted(zzTreeMap *tm, const void *keys, const void *values, size_t count) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (count > 0 && !keys) return ZZ_ERR("Keys pointer is NULL");
+    if (count > 0 && !values) return ZZ_ERR("Values pointer is NULL");
+
+    const unsigned char *keyBytes = keys;
+    const unsigned char *valueBytes = values;
+    for (size_t i = 1; i < count; i++) {
+        if (tm->compareFn(keyBytes + (i - 1) * tm->keySize, keyBytes + i * tm->keySize) >= 0) {
+            return ZZ_ERR("Keys are not in strictly ascending order");
+        }
+    }
+
+    if (count == 0) {
+        zzTreeMapClear(tm);
+        return ZZ_OK();
+    }
+
+    TreeMapNode **nodes = malloc(count * sizeof(*nodes));
+    if (!nodes) return ZZ_ERR("Memory allocation failed");
+
+    for (size_t i = 0; i < count; i++) {
+        nodes[i] = allocNode(tm);
+        if (!nodes[i]) {
+            while (i > 0) free(nodes[--i]);
+            free(nodes);
+            return ZZ_ERR("Failed to allocate node");
+        }
+        memcpy(KEY_PTR(nodes[i]), keyBytes + i * tm->keySize, tm->keySize);
+        storePrefix(tm, nodes[i]);
+        memcpy(VAL_PTR(nodes[i], tm->keySize), valueBytes + i * tm->valueSize, tm->valueSize);
+    }
+
+    zzTreeMapClear(tm);
+    linkSorted(tm, nodes, count);
+    free(nodes);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Inserts or updates a batch of key-value pairs in the TreeMap.
+ *
+ * This function stably sorts the (possibly unsorted) batch, merges it with the
+ * existing entries in a single in-order pass and relinks all nodes into a balanced
+ * tree, costing O(m log m + n) instead of m separate rebalancing insertions. Existing
+ * nodes are reused. Keys already present have their value replaced exactly as
+ * zzTreeMapPut would, and if a key repeats within the batch its last value wins.
+ * Batches that are small relative to the map are inserted one by one instead.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to insert into
+ * @param[in] keys Pointer to an array of count keys in any order (contents will be copied)
+ * @param[in] values Pointer to an array of count values matching the keys (contents will be copied)
+ * @param[in] count Number of entries in the arrays
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapPutAll(zzTreeMap *tm, const void *keys, const void *values, size_t count) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (count == 0) return ZZ_OK();
+    if (!keys) return ZZ_ERR("Keys pointer is NULL");
+    if (!values) return ZZ_ERR("Values pointer is NULL");
+
+    const unsigned char *keyBytes = keys;
+    const unsigned char *valueBytes = values;
+    const unsigned char **refs = malloc(2 * count * sizeof(*refs));
+    if (!refs) return ZZ_ERR("Memory allocation failed");
+    for (size_t i = 0; i < count; i++) refs[i] = keyBytes + i * tm->keySize;
+    sortKeyRefs(tm, refs, refs + count, count);
+
+    // A rebuild touches every node, so small batches are cheaper to insert one by one
+    if (count * (size_t)redLevelFor(tm->size) < tm->size) {
+        for (size_t i = 0; i < count; i++) {
+            zzOpResult res = zzTreeMapPut(tm, refs[i], batchValue(tm, keyBytes, valueBytes, refs[i]));
+            if (ZZ_IS_ERR(res)) {
+                free(refs);
+                return res;
+            }
+        }
+        free(refs);
+        return ZZ_OK();
+    }
+
+    // Existing nodes are gathered at the tail of the merge buffer; the merge never overtakes them
+    size_t oldCount = tm->size;
+    TreeMapNode **merged = malloc((oldCount + count) * sizeof(*merged));
+    if (!merged) {
+        free(refs);
+        return ZZ_ERR("Memory allocation failed");
+    }
+    TreeMapNode **old = merged + count;
+    size_t n = 0;
+    for (TreeMapNode *cur = zzTreeMapMin(tm->root); cur; cur = nextNode(cur)) old[n++] = cur;
+
+    // First pass counts new keys so every allocation happens before the map is touched
+    size_t freshCount = 0;
+    for (size_t i = 0, j = 0; j < count; ) {
+        size_t end = j + 1;
+        while (end < count && tm->compareFn(refs[end], refs[j]) == 0) end++;
+        while (i < oldCount && tm->compareFn(KEY_PTR(old[i]), refs[j]) < 0) i++;
+        if (i == oldCount || tm->compareFn(KEY_PTR(old[i]), refs[j]) != 0) freshCount++;
+        j = end;
+    }
+
+    TreeMapNode **fresh = NULL;
+    if (freshCount > 0) {
+        fresh = malloc(freshCount * sizeof(*fresh));
+        if (!fresh) {
+            free(merged);
+            free(refs);
+            return ZZ_ERR("Memory allocation failed");
+        }
+        for (size_t f = 0; f < freshCount; f++) {
+            fresh[f] = allocNode(tm);
+            if (!fresh[f]) {
+                while (f > 0) free(fresh[--f]);
+                free(fresh);
+                free(merged);
+                free(refs);
+                return ZZ_ERR("Failed to allocate node");
+            }
+        }
+    }
+
+    size_t i = 0, k = 0, used = 0;
+    for (size_t j = 0; j < count; ) {
+        size_t end = j + 1;
+        while (end < count && tm->compareFn(refs[end], refs[j]) == 0) end++;
+        while (i < oldCount && tm->compareFn(KEY_PTR(old[i]), refs[j]) < 0) merged[k++] = old[i++];
+
+        TreeMapNode *node;
+        size_t first = j;
+        if (i < oldCount && tm->compareFn(KEY_PTR(old[i]), refs[j]) == 0) {
+            node = old[i++];
+        } else {
+            node = fresh[used++];
+            memcpy(KEY_PTR(node), refs[j], tm->keySize);
+            storePrefix(tm, node);
+            memcpy(VAL_PTR(node, tm->keySize), batchValue(tm, keyBytes, valueBytes, refs[j]), tm->valueSize);
+            first++;
+        }
+        for (size_t r = first; r < end; r++) {
+            if (tm->valueFree) tm->valueFree(VAL_PTR(node, tm->keySize));
+            memcpy(VAL_PTR(node, tm->keySize), batchValue(tm, keyBytes, valueBytes, refs[r]), tm->valueSize);
+        }
+        merged[k++] = node;
+        j = end;
+    }
+    while (i < oldCount) merged[k++] = old[i++];
+
+    linkSorted(tm, merged, k);
+    free(fresh);
+    free(merged);
+    free(refs);
+    return ZZ_OK();
+}
+
 /**
  * @brief Gets the minimum key-value pair from the TreeMap.
  *
  * This function retrieves the key-value pair with the smallest key in the tree map
- * and copies both the key and value to the output buffers. The minimum element
- * is the leftmost node in the binary search tree.
+ * and copies both the key and value to the output buffers. The map keeps a
+ * pointer to its leftmost node, so this takes O(1) time.
  *
  * @param[in] tm Pointer to the TreeMap to retrieve from
  * @param[out] keyOut Pointer to a buffer where the minimum key will be copied
@@ -411,7 +947,7 @@ zzOpResult zzTreeMapGetMin(const zzTreeMap *tm, void *keyOut, void *valueOut) {
     if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
     if (!tm->root) return ZZ_ERR("Tree is empty");
 
-    TreeMapNode *min = zzTreeMapMin(tm->root);
+    TreeMapNode *min = tm->first;
     if (keyOut) memcpy(keyOut, KEY_PTR(min), tm->keySize);
     if (valueOut) memcpy(valueOut, VAL_PTR(min, tm->keySize), tm->valueSize);
     return ZZ_OK();
@@ -421,8 +957,8 @@ zzOpResult zzTreeMapGetMin(const zzTreeMap *tm, void *keyOut, void *valueOut) {
  * @brief Gets the maximum key-value pair from the TreeMap.
  *
  * This function retrieves the key-value pair with the largest key in the tree map
- * and copies both the key and value to the output buffers. The maximum element
- * is the rightmost node in the binary search tree.
+ * and copies both the key and value to the output buffers. The map keeps a
+ * pointer to its rightmost node, so this takes O(1) time.
  *
  * @param[in] tm Pointer to the TreeMap to retrieve from
  * @param[out] keyOut Pointer to a buffer where the maximum key will be copied
@@ -433,12 +969,572 @@ zzOpResult zzTreeMapGetMax(const zzTreeMap *tm, void *keyOut, void *valueOut) {
     if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
     if (!tm->root) return ZZ_ERR("Tree is empty");
 
-    TreeMapNode *max = zzTreeMapMax(tm->root);
+    TreeMapNode *max = tm->last;
     if (keyOut) memcpy(keyOut, KEY_PTR(max), tm->keySize);
     if (valueOut) memcpy(valueOut, VAL_PTR(max, tm->keySize), tm->valueSize);
     return ZZ_OK();
 }
 
+// Detaches a node and hands its key and value to the caller instead of freeing them
+static void pollNode(zzTreeMap *tm, TreeMapNode *node, void *keyOut, void *valueOut) {
+    dropBounds(tm, node);
+    rbDetachNode(tm, node);
+
+    if (keyOut) memcpy(keyOut, KEY_PTR(node), tm->keySize);
+    else if (tm->keyFree) tm->keyFree(KEY_PTR(node));
+    if (valueOut) memcpy(valueOut, VAL_PTR(node, tm->keySize), tm->valueSize);
+    else if (tm->valueFree) tm->valueFree(VAL_PTR(node, tm->keySize));
+    releaseNode(tm, node);
+    tm->size--;
+}
+
+/**
+ * @brief Removes the entry with the smallest key from the TreeMap and returns it.
+ *
+ * This function removes the leftmost entry in a single operation, without a
+ * separate lookup, so the map can serve as an updatable priority queue. The key
+ * and value are handed to the caller, so the free functions are not called on
+ * them; an output pointer may be NULL to discard that part, in which case the
+ * corresponding free function is called instead.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to remove from
+ * @param[out] keyOut Pointer to a buffer where the smallest key will be copied, or NULL
+ * @param[out] valueOut Pointer to a buffer where its value will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapPollFirst(zzTreeMap *tm, void *keyOut, void *valueOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!tm->first) return ZZ_ERR("Tree is empty");
+
+    pollNode(tm, tm->first, keyOut, valueOut);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Removes the entry with the largest key from the TreeMap and returns it.
+ *
+ * This function removes the rightmost entry in a single operation, without a
+ * separate lookup. The key and value are handed to the caller, so the free
+ * functions are not called on them; an output pointer may be NULL to discard
+ * that part, in which case the corresponding free function is called instead.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to remove from
+ * @param[out] keyOut Pointer to a buffer where the largest key will be copied, or NULL
+ * @param[out] valueOut Pointer to a buffer where its value will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapPollLast(zzTreeMap *tm, void *keyOut, void *valueOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!tm->last) return ZZ_ERR("Tree is empty");
+
+    pollNode(tm, tm->last, keyOut, valueOut);
+    return ZZ_OK();
+}
+
+// Number of keys strictly smaller than key; requires size augmentation
+static size_t countLess(const zzTreeMap *tm, const void *key) {
+    uint64_t keyPrefix = probePrefix(tm, key);
+    size_t rank = 0;
+    TreeMapNode *cur = tm->root;
+    while (cur) {
+        if (compareKey(tm, key, keyPrefix, cur) <= 0) {
+            cur = cur->left;
+        } else {
+            rank += subtreeSize(tm, cur->left) + 1;
+            cur = cur->right;
+        }
+    }
+    return rank;
+}
+
+// First node whose key is not smaller than key, or NULL if there is none
+static TreeMapNode *lowerBound(const zzTreeMap *tm, const void *key) {
+    uint64_t keyPrefix = probePrefix(tm, key);
+    TreeMapNode *found = NULL;
+    TreeMapNode *cur = tm->root;
+    while (cur) {
+        if (compareKey(tm, key, keyPrefix, cur) <= 0) {
+            found = cur;
+            cur = cur->left;
+        } else {
+            cur = cur->right;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Computes the rank of a key in an augmented TreeMap.
+ *
+ * This function counts how many keys in the tree map are strictly smaller than
+ * the given key, using the subtree sizes kept by an augmented map. The key does
+ * not need to be present in the map. Runs in O(log n).
+ *
+ * @param[in] tm Pointer to the augmented TreeMap to query
+ * @param[in] key Pointer to the key whose rank is requested
+ * @param[out] rankOut Pointer to where the number of smaller keys will be stored
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRank(const zzTreeMap *tm, const void *key, size_t *rankOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!rankOut) return ZZ_ERR("Rank output pointer is NULL");
+    if (!tm->augmented) return ZZ_ERR("TreeMap is not augmented");
+
+    *rankOut = countLess(tm, key);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Retrieves the key-value pair at the given sorted position of an augmented TreeMap.
+ *
+ * This function finds the entry whose key is the rank-th smallest (0-based) in the
+ * tree map and copies its key and value to the output buffers. Runs in O(log n).
+ *
+ * @param[in] tm Pointer to the augmented TreeMap to query
+ * @param[in] rank Sorted position of the entry to retrieve (0-based)
+ * @param[out] keyOut Pointer to a buffer where the key will be copied, or NULL
+ * @param[out] valueOut Pointer to a buffer where the value will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapSelect(const zzTreeMap *tm, size_t rank, void *keyOut, void *valueOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!tm->augmented) return ZZ_ERR("TreeMap is not augmented");
+    if (rank >= tm->size) return ZZ_ERR("Rank out of bounds");
+
+    TreeMapNode *cur = tm->root;
+    while (cur) {
+        size_t leftSize = subtreeSize(tm, cur->left);
+        if (rank < leftSize) {
+            cur = cur->left;
+        } else if (rank == leftSize) {
+            break;
+        } else {
+            rank -= leftSize + 1;
+            cur = cur->right;
+        }
+    }
+
+    if (keyOut) memcpy(keyOut, KEY_PTR(cur), tm->keySize);
+    if (valueOut) memcpy(valueOut, VAL_PTR(cur, tm->keySize), tm->valueSize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Computes the aggregate of all values whose keys lie in [lo, hi).
+ *
+ * This function combines the per-subtree aggregates of an augmented TreeMap that
+ * was initialized with aggregate functions, touching O(log n) nodes. A NULL bound
+ * leaves that side of the range open. The function returns an error if no key
+ * falls inside the range, since an empty range has no aggregate.
+ *
+ * @param[in] tm Pointer to the augmented TreeMap to query
+ * @param[in] lo Pointer to the inclusive lower bound key, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound key, or NULL for no upper bound
+ * @param[out] aggOut Pointer to a buffer of aggSize bytes receiving the aggregate
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRangeAggregate(const zzTreeMap *tm, const void *lo, const void *hi, void *aggOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!aggOut) return ZZ_ERR("Aggregate output pointer is NULL");
+    if (!tm->augmented || tm->aggSize == 0) return ZZ_ERR("TreeMap has no aggregate");
+
+    // Find the highest node inside the range; both halves of the range hang below it
+    TreeMapNode *split = tm->root;
+    while (split) {
+        if (lo && tm->compareFn(KEY_PTR(split), lo) < 0) split = split->right;
+        else if (hi && tm->compareFn(KEY_PTR(split), hi) >= 0) split = split->left;
+        else break;
+    }
+    if (!split) return ZZ_ERR("No keys in range");
+
+    unsigned char *single = malloc(tm->aggSize);
+    if (!single) return ZZ_ERR("Memory allocation failed");
+
+    tm->aggInit(aggOut, VAL_PTR(split, tm->keySize));
+
+    // Left half: each node >= lo contributes itself and its right subtree, largest first
+    TreeMapNode *cur = split->left;
+    while (cur) {
+        if (!lo) {
+            tm->aggCombine(aggOut, AGG_PTR(tm, cur), aggOut);
+            break;
+        }
+        if (tm->compareFn(KEY_PTR(cur), lo) < 0) {
+            cur = cur->right;
+            continue;
+        }
+        if (cur->right) tm->aggCombine(aggOut, AGG_PTR(tm, cur->right), aggOut);
+        tm->aggInit(single, VAL_PTR(cur, tm->keySize));
+        tm->aggCombine(aggOut, single, aggOut);
+        cur = cur->left;
+    }
+
+    // Right half: each node < hi contributes its left subtree and itself, smallest first
+    cur = split->right;
+    while (cur) {
+        if (!hi) {
+            tm->aggCombine(aggOut, aggOut, AGG_PTR(tm, cur));
+            break;
+        }
+        if (tm->compareFn(KEY_PTR(cur), hi) >= 0) {
+            cur = cur->left;
+            continue;
+        }
+        if (cur->left) tm->aggCombine(aggOut, aggOut, AGG_PTR(tm, cur->left));
+        tm->aggInit(single, VAL_PTR(cur, tm->keySize));
+        tm->aggCombine(aggOut, aggOut, single);
+        cur = cur->right;
+    }
+
+    free(single);
+    return ZZ_OK();
+}
+
+// Number of black nodes on any path from node down to a leaf
+static int blackHeight(const TreeMapNode *node) {
+    int height = 0;
+    for (; node; node = node->left) {
+        if (COLOR(node) == ZZ_BLACK) height++;
+    }
+    return height;
+}
+
+// Joins the subtrees l < k < r of black heights lh and rh through the middle node k in
+// O(|lh - rh| + 1) steps; returns the new root and stores its black height in heightOut
+static TreeMapNode *joinAt(zzTreeMap *ctx, TreeMapNode *l, int lh, TreeMapNode *k, TreeMapNode *r, int rh, int *heightOut) {
+    if (l) {
+        SET_PARENT(l, NULL);
+        if (COLOR(l) == ZZ_RED) { SET_COLOR(l, ZZ_BLACK); lh++; }
+    }
+    if (r) {
+        SET_PARENT(r, NULL);
+        if (COLOR(r) == ZZ_RED) { SET_COLOR(r, ZZ_BLACK); rh++; }
+    }
+
+    if (lh == rh) {
+        k->left = l;
+        k->right = r;
+        SET_PARENT(k, NULL);
+        SET_COLOR(k, ZZ_BLACK);
+        if (l) SET_PARENT(l, k);
+        if (r) SET_PARENT(r, k);
+        pullUp(ctx, k);
+        *heightOut = lh + 1;
+        return k;
+    }
+
+    // Walk down the inner spine of the taller tree to a black node as high as the shorter tree
+    bool leftTaller = lh > rh;
+    TreeMapNode *tall = leftTaller ? l : r;
+    int height = leftTaller ? lh : rh;
+    int target = leftTaller ? rh : lh;
+    TreeMapNode *parent = NULL;
+    TreeMapNode *c = tall;
+    while (c && (COLOR(c) == ZZ_RED || height > target)) {
+        if (COLOR(c) == ZZ_BLACK) height--;
+        parent = c;
+        c = leftTaller ? c->right : c->left;
+    }
+
+    SET_PARENT(k, parent);
+    SET_COLOR(k, ZZ_RED);
+    if (leftTaller) {
+        k->left = c;
+        k->right = r;
+        parent->right = k;
+    } else {
+        k->left = l;
+        k->right = c;
+        parent->left = k;
+    }
+    if (k->left) SET_PARENT(k->left, k);
+    if (k->right) SET_PARENT(k->right, k);
+
+    ctx->root = tall;
+    pullUpToRoot(ctx, k);
+    *heightOut = (leftTaller ? lh : rh) + rbInsertFixup(ctx, k);
+    return ctx->root;
+}
+
+// Splits the subtree rooted at node, of black height height, into keys < key and keys >= key
+static void splitAt(zzTreeMap *ctx, TreeMapNode *node, int height, const void *key, uint64_t keyPrefix,
+                    TreeMapNode **lo, int *loHeight, TreeMapNode **hi, int *hiHeight) {
+    if (!node) {
+        *lo = *hi = NULL;
+        *loHeight = *hiHeight = 0;
+        return;
+    }
+
+    int childHeight = height - (COLOR(node) == ZZ_BLACK);
+    if (compareKey(ctx, key, keyPrefix, node) <= 0) {
+        splitAt(ctx, node->left, childHeight, key, keyPrefix, lo, loHeight, hi, hiHeight);
+        *hi = joinAt(ctx, *hi, *hiHeight, node, node->right, childHeight, hiHeight);
+    } else {
+        splitAt(ctx, node->right, childHeight, key, keyPrefix, lo, loHeight, hi, hiHeight);
+        *lo = joinAt(ctx, node->left, childHeight, node, *lo, *loHeight, loHeight);
+    }
+}
+
+// Counts the nodes under a by walking a and b in lockstep, so only the smaller tree is fully visited
+static size_t countLockstep(TreeMapNode *a, TreeMapNode *b, size_t total) {
+    TreeMapNode *x = zzTreeMapMin(a);
+    TreeMapNode *y = zzTreeMapMin(b);
+    size_t steps = 0;
+    while (x && y) {
+        x = nextNode(x);
+        y = nextNode(y);
+        steps++;
+    }
+    return x ? total - steps : steps;
+}
+
+// Joins the trees l < r of black heights lh and rh, borrowing the smallest node of r as the link
+static TreeMapNode *joinTrees(zzTreeMap *ctx, TreeMapNode *l, int lh, TreeMapNode *r) {
+    if (!r) return l;
+
+    TreeMapNode *mid = zzTreeMapMin(r);
+    ctx->root = r;
+    rbDetachNode(ctx, mid);
+    r = ctx->root;
+
+    int height;
+    return joinAt(ctx, l, lh, mid, r, blackHeight(r), &height);
+}
+
+/**
+ * @brief Splits a TreeMap around a key into two TreeMaps.
+ *
+ * This function moves every entry with a key smaller than the given key into
+ * left and every remaining entry into right, reusing the existing nodes without
+ * copying any keys or values. The tree is cut along the search path and the
+ * pieces are rejoined by black height. Both outputs are initialized with the
+ * configuration of tm (including augmentation); their previous contents are not
+ * freed. Unless it is passed as one of the outputs, tm is left empty and remains
+ * usable. Augmented maps know their subtree sizes, so the split takes O(log n)
+ * time; for plain maps the smaller half is additionally counted to set the
+ * sizes, which makes it O(log n + min(|L|, |R|)) for output sizes |L| and |R|.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to split
+ * @param[in] key Pointer to the key at which to split; entries with this key go to right
+ * @param[out] left Pointer to the TreeMap receiving the entries with smaller keys
+ * @param[out] right Pointer to the TreeMap receiving the entries with greater or equal keys
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapSplit(zzTreeMap *tm, const void *key, zzTreeMap *left, zzTreeMap *right) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!left) return ZZ_ERR("Left TreeMap pointer is NULL");
+    if (!right) return ZZ_ERR("Right TreeMap pointer is NULL");
+    if (left == right) return ZZ_ERR("Left and right TreeMaps must differ");
+
+    zzTreeMap ctx = *tm;
+    TreeMapNode *lo, *hi;
+    int loHeight, hiHeight;
+    splitAt(&ctx, tm->root, blackHeight(tm->root), key, probePrefix(tm, key), &lo, &loHeight, &hi, &hiHeight);
+
+    size_t total = tm->size;
+    size_t loSize = tm->augmented ? subtreeSize(tm, lo) : countLockstep(lo, hi, total);
+
+    tm->root = NULL;
+    tm->first = NULL;
+    tm->last = NULL;
+    tm->size = 0;
+
+    *left = ctx;
+    left->root = lo;
+    left->size = loSize;
+    refreshBounds(left);
+
+    *right = ctx;
+    right->root = hi;
+    right->size = total - loSize;
+    refreshBounds(right);
+
+    return ZZ_OK();
+}
+
+/**
+ * @brief Joins two TreeMaps whose key ranges do not overlap.
+ *
+ * This function moves every entry of right into left, reusing the existing
+ * nodes without copying any keys or values. Every key in left must be smaller
+ * than every key in right. The smaller tree is hung into the spine of the taller
+ * one at matching black height and rebalanced, which takes O(log n) time. Both
+ * maps must share key size, value size, comparison function, augmentation and
+ * key prefix function; left keeps its own free functions. Afterwards right is
+ * empty and remains usable.
+ *
+ * @param[in,out] left Pointer to the TreeMap receiving all entries
+ * @param[in,out] right Pointer to the TreeMap whose entries are moved; emptied on success
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapJoin(zzTreeMap *left, zzTreeMap *right) {
+    if (!left) return ZZ_ERR("Left TreeMap pointer is NULL");
+    if (!right) return ZZ_ERR("Right TreeMap pointer is NULL");
+    if (left == right) return ZZ_ERR("Left and right TreeMaps must differ");
+    if (left->keySize != right->keySize || left->valueSize != right->valueSize ||
+        left->compareFn != right->compareFn || left->augmented != right->augmented ||
+        left->aggSize != right->aggSize || left->aggInit != right->aggInit ||
+        left->aggCombine != right->aggCombine || left->prefixFn != right->prefixFn) {
+        return ZZ_ERR("TreeMaps are not compatible");
+    }
+    if (!right->root) return ZZ_OK();
+
+    if (left->root && left->compareFn(KEY_PTR(zzTreeMapMax(left->root)), KEY_PTR(zzTreeMapMin(right->root))) >= 0) {
+        return ZZ_ERR("Left keys must all be smaller than right keys");
+    }
+
+    zzTreeMap ctx = *left;
+    left->root = joinTrees(&ctx, left->root, blackHeight(left->root), right->root);
+    left->size += right->size;
+    refreshBounds(left);
+
+    right->root = NULL;
+    right->first = NULL;
+    right->last = NULL;
+    right->size = 0;
+
+    return ZZ_OK();
+}
+
+/**
+ * @brief Removes every entry whose key lies in the range [lo, hi).
+ *
+ * This function cuts the range out of the tree with two splits, joins the
+ * remaining halves back together and then frees the detached subtree in a
+ * single pass, instead of rebalancing once per removed key. It runs in
+ * O(log n + k) time for k removed entries. A NULL bound leaves that side of
+ * the range open. If a custom free function was provided for keys or values,
+ * it is called on every removed key and value.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to remove the entries from
+ * @param[in] lo Pointer to the inclusive lower bound, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound, or NULL for no upper bound
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapRemoveRange(zzTreeMap *tm, const void *lo, const void *hi) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (lo && hi && tm->compareFn(lo, hi) >= 0) return ZZ_OK();
+
+    zzTreeMap ctx = *tm;
+    TreeMapNode *below = NULL, *rest = tm->root, *inside, *above = NULL;
+    int belowHeight = 0, restHeight = blackHeight(tm->root), insideHeight, aboveHeight;
+
+    if (lo) splitAt(&ctx, rest, restHeight, lo, probePrefix(tm, lo), &below, &belowHeight, &rest, &restHeight);
+    if (hi) {
+        splitAt(&ctx, rest, restHeight, hi, probePrefix(tm, hi), &inside, &insideHeight, &above, &aboveHeight);
+    } else {
+        inside = rest;
+    }
+
+    tm->size -= zzTreeMapFreeNode(tm, inside);
+    tm->root = joinTrees(&ctx, below, belowHeight, above);
+    refreshBounds(tm);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Counts the entries whose key lies in the range [lo, hi).
+ *
+ * This function counts the keys in the half-open range without modifying the
+ * map. On maps created with zzTreeMapInitAugmented the count is derived from the
+ * subtree sizes in O(log n) time; otherwise the entries in the range are walked
+ * in O(log n + k) time. A NULL bound leaves that side of the range open.
+ *
+ * @param[in] tm Pointer to the TreeMap to count in
+ * @param[in] lo Pointer to the inclusive lower bound, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound, or NULL for no upper bound
+ * @param[out] countOut Pointer to a size_t receiving the number of entries in the range
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapCountRange(const zzTreeMap *tm, const void *lo, const void *hi, size_t *countOut) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (!countOut) return ZZ_ERR("Count output pointer is NULL");
+
+    if (lo && hi && tm->compareFn(lo, hi) >= 0) {
+        *countOut = 0;
+        return ZZ_OK();
+    }
+
+    if (tm->augmented) {
+        size_t below = lo ? countLess(tm, lo) : 0;
+        size_t upTo = hi ? countLess(tm, hi) : tm->size;
+        *countOut = upTo - below;
+        return ZZ_OK();
+    }
+
+    size_t count = 0;
+    TreeMapNode *cur = lo ? lowerBound(tm, lo) : zzTreeMapMin(tm->root);
+    while (cur && (!hi || tm->compareFn(KEY_PTR(cur), hi) < 0)) {
+        count++;
+        cur = nextNode(cur);
+    }
+    *countOut = count;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Relocates all nodes of the TreeMap into contiguous memory in key order.
+ *
+ * After many insertions and removals the nodes of a tree end up scattered over
+ * the heap, so an in-order walk takes a cache miss per node. This function
+ * copies every node into large size-aligned slab chunks in ascending key order
+ * and relinks them into a perfectly balanced tree, so iteration and range scans
+ * touch memory sequentially again. Keys and values are moved, not copied, so no
+ * free functions are called. Nodes inserted later are allocated individually as
+ * usual, and a chunk is returned to the system once all of its nodes are gone.
+ * Runs in O(n) time and invalidates all iterators over the map.
+ *
+ * @param[in,out] tm Pointer to the TreeMap to compact
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeMapCompact(zzTreeMap *tm) {
+    if (!tm) return ZZ_ERR("TreeMap pointer is NULL");
+    if (tm->size == 0) return ZZ_OK();
+
+    size_t stride = slabStride(tm);
+    size_t chunkBytes = slabChunkBytes(tm);
+    size_t perChunk = (chunkBytes - slabHeaderBytes()) / stride;
+    size_t chunkCount = (tm->size + perChunk - 1) / perChunk;
+
+    TreeMapNode **nodes = malloc(tm->size * sizeof(TreeMapNode*));
+    SlabChunk **chunks = malloc(chunkCount * sizeof(SlabChunk*));
+    if (!nodes || !chunks) {
+        free(nodes);
+        free(chunks);
+        return ZZ_ERR("Memory allocation failed");
+    }
+    for (size_t c = 0; c < chunkCount; c++) {
+        chunks[c] = aligned_alloc(chunkBytes, chunkBytes);
+        if (!chunks[c]) {
+            while (c > 0) free(chunks[--c]);
+            free(chunks);
+            free(nodes);
+            return ZZ_ERR("Memory allocation failed");
+        }
+        chunks[c]->live = (c + 1 < chunkCount) ? perChunk : tm->size - c * perChunk;
+    }
+
+    // Copy the nodes into consecutive slots in key order; the old nodes are released afterwards
+    size_t i = 0;
+    for (TreeMapNode *cur = zzTreeMapMin(tm->root); cur; cur = nextNode(cur), i++) {
+        unsigned char *slot = (unsigned char*)chunks[i / perChunk] + slabHeaderBytes() + (i % perChunk) * stride;
+        TreeMapNode *copy = (TreeMapNode*)slot;
+        memcpy(copy, cur, nodeBytes(tm));
+        INIT_LINKS(copy);
+        MARK_SLAB(copy);
+        nodes[i] = copy;
+    }
+
+    releaseSubtree(tm, tm->root);
+    linkSorted(tm, nodes, i);
+
+    free(chunks);
+    free(nodes);
+    return ZZ_OK();
+}
+
 /**
  * @brief Initializes an iterator for the TreeMap.
  *
@@ -455,13 +1551,8 @@ void zzTreeMapIteratorInit(zzTreeMapIterator *it, zzTreeMap *tm) {
     it->map = tm;
     it->lastReturned = NULL;
 
-    // Find the minimum node (leftmost node) to start iteration
-    it->currentNode = tm->root;
-    if (it->currentNode) {
-        while (it->currentNode->left) {
-            it->currentNode = it->currentNode->left;
-        }
-    }
+    // Start at the cached minimum node
+    it->currentNode = tm->first;
 
     it->state = it->currentNode ? ZZ_ITER_VALID : ZZ_ITER_END;
 }
@@ -498,10 +1589,10 @@ bool zzTreeMapIteratorNext(zzTreeMapIterator *it, void *keyOut, void *valueOut)
         it->currentNode = current;
     } else {
         // If current node has no right child, go up to parent until we come from a left child
-        TreeMapNode *parent = current->parent;
+        TreeMapNode *parent = PARENT(current);
         while (parent && current == parent->right) {
             current = parent;
-            parent = parent->parent;
+            parent = PARENT(parent);
         }
         it->currentNode = parent;
     }
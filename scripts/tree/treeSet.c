@@ -2,6 +2,37 @@
 #include <string.h>
 #include <stdlib.h>
 
+#define AGG_PTR(ts, node) ((node)->key + tsAggOffset(ts))
+#define CNT_PTR(ts, node) ((size_t*)((node)->key + tsCntOffset(ts)))
+#define PREFIX_PTR(ts, node) ((uint64_t*)((node)->key + tsPrefixOffset(ts)))
+
+// Node link accessors; besides the color, one more low bit marks nodes that live in a slab chunk
+#ifdef ZZ_TREE_COMPACT_NODES
+#define LINK_BITS ((uintptr_t)3)
+#define PARENT(node) ((TreeSetNode*)((node)->parentColor & ~LINK_BITS))
+#define COLOR(node) ((zzRBColor)((node)->parentColor & 1))
+#define IN_SLAB(node) (((node)->parentColor & 2) != 0)
+#define SET_PARENT(node, p) ((node)->parentColor = (uintptr_t)(p) | ((node)->parentColor & LINK_BITS))
+#define SET_COLOR(node, c) ((node)->parentColor = ((node)->parentColor & ~(uintptr_t)1) | (uintptr_t)(c))
+#define MARK_SLAB(node) ((node)->parentColor |= 2)
+#define INIT_LINKS(node) ((node)->parentColor = 0)
+#else
+#define PARENT(node) ((node)->parent)
+#define COLOR(node) ((zzRBColor)((node)->color & 1))
+#define IN_SLAB(node) (((node)->color & 2) != 0)
+#define SET_PARENT(node, p) ((node)->parent = (p))
+#define SET_COLOR(node, c) ((node)->color = (zzRBColor)(((node)->color & 2) | (c)))
+#define MARK_SLAB(node) ((node)->color = (zzRBColor)((node)->color | 2))
+#define INIT_LINKS(node) ((node)->parent = NULL, (node)->color = ZZ_RED)
+#endif
+
+#define SLAB_MIN_CHUNK_BYTES ((size_t)64 * 1024)
+
+// Header at the start of every slab chunk; chunks are aligned to their size so a node finds its chunk by masking
+typedef struct SlabChunk {
+    size_t live;    // Number of nodes in the chunk that have not been released yet
+} SlabChunk;
+
 /**
  * @brief Initializes a new TreeSet with the specified key size.
  *
@@ -21,19 +52,204 @@ zzOpResult zzTreeSetInit(zzTreeSet *ts, size_t keySize, zzCompareFn compareFn, z
     if (!compareFn) return ZZ_ERR("Comparison function is NULL");
 
     ts->root = NULL;
+    ts->first = NULL;
+    ts->last = NULL;
     ts->size = 0;
     ts->keySize = keySize;
     ts->compareFn = compareFn;
     ts->keyFree = keyFree;
+    ts->augmented = false;
+    ts->aggSize = 0;
+    ts->aggInit = NULL;
+    ts->aggCombine = NULL;
+    ts->prefixFn = NULL;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Initializes a new augmented TreeSet for order-statistic and aggregate queries.
+ *
+ * This function initializes a TreeSet like zzTreeSetInit, but every node additionally
+ * tracks the size of its subtree and, when aggregate functions are given, an aggregate
+ * of all keys in its subtree. The augmentation is maintained through insertions,
+ * removals and rotations, enabling O(log n) rank, select and range-aggregate queries.
+ *
+ * @param[out] ts Pointer to the TreeSet structure to initialize
+ * @param[in] keySize Size in bytes of each key that will be stored in the set
+ * @param[in] compareFn Function to compare keys for ordering (returns negative if a<b, 0 if a==b, positive if a>b)
+ * @param[in] keyFree Function to free key memory when entries are removed or the set is freed, or NULL if not needed
+ * @param[in] aggSize Size in bytes of the key aggregate, or 0 to only track subtree sizes
+ * @param[in] aggInit Function to seed an aggregate from a single key (required if aggSize is non-zero)
+ * @param[in] aggCombine Associative function combining two adjacent aggregates (required if aggSize is non-zero)
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetInitAugmented(zzTreeSet *ts, size_t keySize, zzCompareFn compareFn, zzFreeFn keyFree,
+                                  size_t aggSize, zzAggregateInitFn aggInit, zzAggregateCombineFn aggCombine) {
+    if (aggSize > 0 && (!aggInit || !aggCombine)) return ZZ_ERR("Aggregate functions are NULL");
+
+    zzOpResult res = zzTreeSetInit(ts, keySize, compareFn, keyFree);
+    if (ZZ_IS_ERR(res)) return res;
+
+    ts->augmented = true;
+    ts->aggSize = aggSize;
+    ts->aggInit = aggSize > 0 ? aggInit : NULL;
+    ts->aggCombine = aggSize > 0 ? aggCombine : NULL;
     return ZZ_OK();
 }
 
-static void zzTreeSetFreeNode(zzTreeSet *ts, TreeSetNode *node) {
+/**
+ * @brief Enables cached key prefixes on an empty TreeSet.
+ *
+ * This function makes every node also store a normalized 64-bit prefix of its
+ * key, computed by prefixFn. Lookups compare these prefixes with a single integer
+ * comparison first and only call the comparison function when two prefixes tie,
+ * so keys held out of line (such as strings) are rarely dereferenced during a
+ * descent. zzIntPrefix, zzLongPrefix and zzStringPrefix cover the built-in key
+ * types. The prefix must agree with the comparison function as described for
+ * zzKeyPrefixFn. Because it changes the node layout, the set must be empty;
+ * passing NULL turns the cache off again. Works with both plain and augmented sets.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to configure
+ * @param[in] prefixFn Function extracting the key prefix, or NULL to disable prefix caching
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSetKeyPrefix(zzTreeSet *ts, zzKeyPrefixFn prefixFn) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (ts->size > 0) return ZZ_ERR("TreeSet is not empty");
+
+    ts->prefixFn = prefixFn;
+    return ZZ_OK();
+}
+
+// The cached key prefix sits at the first 8-byte boundary after the key
+static size_t tsPrefixOffset(const zzTreeSet *ts) {
+    const size_t align = sizeof(uint64_t);
+    size_t end = offsetof(TreeSetNode, key) + ts->keySize;
+    return (end + align - 1) / align * align - offsetof(TreeSetNode, key);
+}
+
+// Bytes of node data taken by the key and the cached prefix, if any
+static size_t tsPayloadBytes(const zzTreeSet *ts) {
+    return ts->prefixFn ? tsPrefixOffset(ts) + sizeof(uint64_t) : ts->keySize;
+}
+
+// The aggregate is placed at a max_align_t boundary so callbacks may access it directly
+static size_t tsAggOffset(const zzTreeSet *ts) {
+    const size_t align = _Alignof(max_align_t);
+    size_t end = offsetof(TreeSetNode, key) + tsPayloadBytes(ts);
+    return (end + align - 1) / align * align - offsetof(TreeSetNode, key);
+}
+
+static size_t tsCntOffset(const zzTreeSet *ts) {
+    return tsAggOffset(ts) + (ts->aggSize + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+}
+
+static size_t tsNodeBytes(const zzTreeSet *ts) {
+    if (!ts->augmented && !ts->prefixFn) return sizeof(TreeSetNode) + ts->keySize;
+    if (!ts->augmented) return offsetof(TreeSetNode, key) + tsPayloadBytes(ts);
+    return offsetof(TreeSetNode, key) + tsCntOffset(ts) + sizeof(size_t);
+}
+
+static size_t tsSubtreeSize(const zzTreeSet *ts, const TreeSetNode *node) {
+    return node ? *CNT_PTR(ts, node) : 0;
+}
+
+// Recomputes the subtree size and aggregate of a node from its children
+static void tsPullUp(const zzTreeSet *ts, TreeSetNode *node) {
+    if (!ts->augmented) return;
+
+    *CNT_PTR(ts, node) = 1 + tsSubtreeSize(ts, node->left) + tsSubtreeSize(ts, node->right);
+
+    if (ts->aggSize == 0) return;
+    unsigned char *agg = AGG_PTR(ts, node);
+    ts->aggInit(agg, node->key);
+    if (node->left) ts->aggCombine(agg, AGG_PTR(ts, node->left), agg);
+    if (node->right) ts->aggCombine(agg, agg, AGG_PTR(ts, node->right));
+}
+
+static void tsPullUpToRoot(const zzTreeSet *ts, TreeSetNode *node) {
+    if (!ts->augmented) return;
+    for (; node; node = PARENT(node)) tsPullUp(ts, node);
+}
+
+// Rotations, insert and delete fixups shared with the other red-black trees, keeping sizes and aggregates current
+#define RB_TREE zzTreeSet
+#define RB_NODE TreeSetNode
+#define RB_PARENT(node) PARENT(node)
+#define RB_SET_PARENT(node, p) SET_PARENT(node, p)
+#define RB_COLOR(node) COLOR(node)
+#define RB_SET_COLOR(node, c) SET_COLOR(node, c)
+#define RB_PULL_UP(ts, node) tsPullUp(ts, node)
+#define RB_PULL_UP_TO_ROOT(ts, node) tsPullUpToRoot(ts, node)
+#include "rbTreeOps.h"
+
+// Prefix of a probe key, or 0 when the TreeSet does not cache prefixes
+static uint64_t tsProbePrefix(const zzTreeSet *ts, const void *key) {
+    return ts->prefixFn ? ts->prefixFn(key) : 0;
+}
+
+// Compares a probe key with a node's key, deciding on the cached prefixes whenever they differ
+static int tsCompareKey(const zzTreeSet *ts, const void *key, uint64_t keyPrefix, const TreeSetNode *node) {
+    if (ts->prefixFn) {
+        uint64_t nodePrefix = *PREFIX_PTR(ts, node);
+        if (keyPrefix != nodePrefix) return (keyPrefix < nodePrefix) ? -1 : 1;
+    }
+    return ts->compareFn(key, node->key);
+}
+
+// Stores the cached prefix of a node whose key has just been written
+static void tsStorePrefix(const zzTreeSet *ts, TreeSetNode *node) {
+    if (ts->prefixFn) *PREFIX_PTR(ts, node) = ts->prefixFn(node->key);
+}
+
+// Allocates a heap node with cleared link bits
+static TreeSetNode *tsAllocNode(const zzTreeSet *ts) {
+    TreeSetNode *node = malloc(tsNodeBytes(ts));
+    if (node) INIT_LINKS(node);
+    return node;
+}
+
+static size_t tsSlabStride(const zzTreeSet *ts) {
+    const size_t align = _Alignof(max_align_t);
+    return (tsNodeBytes(ts) + align - 1) / align * align;
+}
+
+static size_t tsSlabHeaderBytes(void) {
+    const size_t align = _Alignof(max_align_t);
+    return (sizeof(SlabChunk) + align - 1) / align * align;
+}
+
+static size_t tsSlabChunkBytes(const zzTreeSet *ts) {
+    size_t bytes = SLAB_MIN_CHUNK_BYTES;
+    while (bytes < tsSlabHeaderBytes() + tsSlabStride(ts)) bytes *= 2;
+    return bytes;
+}
+
+// Frees a heap node, or releases a slab node and frees its chunk once the last node in it is gone
+static void tsReleaseNode(const zzTreeSet *ts, TreeSetNode *node) {
+    if (!IN_SLAB(node)) {
+        free(node);
+        return;
+    }
+    SlabChunk *chunk = (SlabChunk*)((uintptr_t)node & ~(uintptr_t)(tsSlabChunkBytes(ts) - 1));
+    if (--chunk->live == 0) free(chunk);
+}
+
+// Releases the nodes of a subtree without touching the keys they hold
+static void tsReleaseSubtree(const zzTreeSet *ts, TreeSetNode *node) {
     if (!node) return;
-    zzTreeSetFreeNode(ts, node->left);
-    zzTreeSetFreeNode(ts, node->right);
+    tsReleaseSubtree(ts, node->left);
+    tsReleaseSubtree(ts, node->right);
+    tsReleaseNode(ts, node);
+}
+
+// Frees the subtree rooted at node and returns the number of nodes freed
+static size_t zzTreeSetFreeNode(zzTreeSet *ts, TreeSetNode *node) {
+    if (!node) return 0;
+    size_t freed = 1 + zzTreeSetFreeNode(ts, node->left) + zzTreeSetFreeNode(ts, node->right);
     if (ts->keyFree) ts->keyFree(node->key);
-    free(node);
+    tsReleaseNode(ts, node);
+    return freed;
 }
 
 /**
@@ -49,76 +265,11 @@ void zzTreeSetFree(zzTreeSet *ts) {
     if (!ts) return;
     zzTreeSetFreeNode(ts, ts->root);
     ts->root = NULL;
+    ts->first = NULL;
+    ts->last = NULL;
     ts->size = 0;
 }
 
-static void tsRotateLeft(zzTreeSet *ts, TreeSetNode *x) {
-    TreeSetNode *y = x->right;
-    x->right = y->left;
-    if (y->left) y->left->parent = x;
-    y->parent = x->parent;
-    
-    if (!x->parent) ts->root = y;
-    else if (x == x->parent->left) x->parent->left = y;
-    else x->parent->right = y;
-    
-    y->left = x;
-    x->parent = y;
-}
-
-static void tsRotateRight(zzTreeSet *ts, TreeSetNode *y) {
-    TreeSetNode *x = y->left;
-    y->left = x->right;
-    if (x->right) x->right->parent = y;
-    x->parent = y->parent;
-    
-    if (!y->parent) ts->root = x;
-    else if (y == y->parent->right) y->parent->right = x;
-    else y->parent->left = x;
-    
-    x->right = y;
-    y->parent = x;
-}
-
-static void tsInsertFixup(zzTreeSet *ts, TreeSetNode *z) {
-    while (z->parent && z->parent->color == ZZ_RED) {
-        if (z->parent == z->parent->parent->left) {
-            TreeSetNode *y = z->parent->parent->right;
-            if (y && y->color == ZZ_RED) {
-                z->parent->color = ZZ_BLACK;
-                y->color = ZZ_BLACK;
-                z->parent->parent->color = ZZ_RED;
-                z = z->parent->parent;
-            } else {
-                if (z == z->parent->right) {
-                    z = z->parent;
-                    tsRotateLeft(ts, z);
-                }
-                z->parent->color = ZZ_BLACK;
-                z->parent->parent->color = ZZ_RED;
-                tsRotateRight(ts, z->parent->parent);
-            }
-        } else {
-            TreeSetNode *y = z->parent->parent->left;
-            if (y && y->color == ZZ_RED) {
-                z->parent->color = ZZ_BLACK;
-                y->color = ZZ_BLACK;
-                z->parent->parent->color = ZZ_RED;
-                z = z->parent->parent;
-            } else {
-                if (z == z->parent->left) {
-                    z = z->parent;
-                    tsRotateRight(ts, z);
-                }
-                z->parent->color = ZZ_BLACK;
-                z->parent->parent->color = ZZ_RED;
-                tsRotateLeft(ts, z->parent->parent);
-            }
-        }
-    }
-    ts->root->color = ZZ_BLACK;
-}
-
 /**
  * @brief Inserts a key into the TreeSet.
  *
@@ -134,30 +285,36 @@ zzOpResult zzTreeSetInsert(zzTreeSet *ts, const void *key) {
     if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
     if (!key) return ZZ_ERR("Key pointer is NULL");
 
+    uint64_t keyPrefix = tsProbePrefix(ts, key);
     TreeSetNode *parent = NULL;
     TreeSetNode *cur = ts->root;
+    int cmp = 0;
 
     while (cur) {
         parent = cur;
-        int cmp = ts->compareFn(key, cur->key);
+        cmp = tsCompareKey(ts, key, keyPrefix, cur);
         if (cmp == 0) return ZZ_ERR("Key already exists");
         cur = (cmp < 0) ? cur->left : cur->right;
     }
 
-    TreeSetNode *node = malloc(sizeof(TreeSetNode) + ts->keySize);
+    TreeSetNode *node = tsAllocNode(ts);
     if (!node) return ZZ_ERR("Failed to allocate node");
 
     memcpy(node->key, key, ts->keySize);
+    tsStorePrefix(ts, node);
     node->left = node->right = NULL;
-    node->parent = parent;
-    node->color = ZZ_RED;
+    SET_PARENT(node, parent);
+    SET_COLOR(node, ZZ_RED);
 
     if (!parent) ts->root = node;
-    else if (ts->compareFn(key, parent->key) < 0) parent->left = node;
+    else if (cmp < 0) parent->left = node;
     else parent->right = node;
+    if (!ts->first || (parent == ts->first && cmp < 0)) ts->first = node;
+    if (!ts->last || (parent == ts->last && cmp > 0)) ts->last = node;
 
     ts->size++;
-    tsInsertFixup(ts, node);
+    tsPullUpToRoot(ts, node);
+    rbInsertFixup(ts, node);
     return ZZ_OK();
 }
 
@@ -173,9 +330,10 @@ zzOpResult zzTreeSetInsert(zzTreeSet *ts, const void *key) {
 bool zzTreeSetContains(const zzTreeSet *ts, const void *key) {
     if (!ts || !key) return false;
     
+    uint64_t keyPrefix = tsProbePrefix(ts, key);
     TreeSetNode *cur = ts->root;
     while (cur) {
-        int cmp = ts->compareFn(key, cur->key);
+        int cmp = tsCompareKey(ts, key, keyPrefix, cur);
         if (cmp == 0) return true;
         cur = (cmp < 0) ? cur->left : cur->right;
     }
@@ -192,74 +350,16 @@ static TreeSetNode *zzTreeSetMax(TreeSetNode *node) {
     return node;
 }
 
-static void tsTransplant(zzTreeSet *ts, TreeSetNode *u, TreeSetNode *v) {
-    if (!u->parent) ts->root = v;
-    else if (u == u->parent->left) u->parent->left = v;
-    else u->parent->right = v;
-    if (v) v->parent = u->parent;
+// Moves the cached first and last pointers off z before it is detached
+static void tsDropBounds(zzTreeSet *ts, TreeSetNode *z) {
+    if (z == ts->first) ts->first = z->right ? zzTreeSetMin(z->right) : PARENT(z);
+    if (z == ts->last) ts->last = z->left ? zzTreeSetMax(z->left) : PARENT(z);
 }
 
-static void tsDeleteFixup(zzTreeSet *ts, TreeSetNode *x, TreeSetNode *xParent) {
-    while (x != ts->root && (!x || x->color == ZZ_BLACK)) {
-        if (x == (xParent ? xParent->left : NULL)) {
-            TreeSetNode *w = xParent->right;
-            if (w && w->color == ZZ_RED) {
-                w->color = ZZ_BLACK;
-                xParent->color = ZZ_RED;
-                tsRotateLeft(ts, xParent);
-                w = xParent->right;
-            }
-            if (w && (!w->left || w->left->color == ZZ_BLACK) &&
-                (!w->right || w->right->color == ZZ_BLACK)) {
-                w->color = ZZ_RED;
-                x = xParent;
-                xParent = x ? x->parent : NULL;
-            } else {
-                if (w && (!w->right || w->right->color == ZZ_BLACK)) {
-                    if (w->left) w->left->color = ZZ_BLACK;
-                    w->color = ZZ_RED;
-                    tsRotateRight(ts, w);
-                    w = xParent->right;
-                }
-                if (w) {
-                    w->color = xParent->color;
-                    if (w->right) w->right->color = ZZ_BLACK;
-                }
-                xParent->color = ZZ_BLACK;
-                tsRotateLeft(ts, xParent);
-                x = ts->root;
-            }
-        } else {
-            TreeSetNode *w = xParent->left;
-            if (w && w->color == ZZ_RED) {
-                w->color = ZZ_BLACK;
-                xParent->color = ZZ_RED;
-                tsRotateRight(ts, xParent);
-                w = xParent->left;
-            }
-            if (w && (!w->right || w->right->color == ZZ_BLACK) &&
-                (!w->left || w->left->color == ZZ_BLACK)) {
-                w->color = ZZ_RED;
-                x = xParent;
-                xParent = x ? x->parent : NULL;
-            } else {
-                if (w && (!w->left || w->left->color == ZZ_BLACK)) {
-                    if (w->right) w->right->color = ZZ_BLACK;
-                    w->color = ZZ_RED;
-                    tsRotateLeft(ts, w);
-                    w = xParent->left;
-                }
-                if (w) {
-                    w->color = xParent->color;
-                    if (w->left) w->left->color = ZZ_BLACK;
-                }
-                xParent->color = ZZ_BLACK;
-                tsRotateRight(ts, xParent);
-                x = ts->root;
-            }
-        }
-    }
-    if (x) x->color = ZZ_BLACK;
+// Recomputes the cached first and last pointers after the tree was relinked wholesale
+static void tsRefreshBounds(zzTreeSet *ts) {
+    ts->first = zzTreeSetMin(ts->root);
+    ts->last = zzTreeSetMax(ts->root);
 }
 
 /**
@@ -279,56 +379,22 @@ zzOpResult zzTreeSetRemove(zzTreeSet *ts, const void *key) {
     if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
     if (!key) return ZZ_ERR("Key pointer is NULL");
 
+    uint64_t keyPrefix = tsProbePrefix(ts, key);
     TreeSetNode *z = ts->root;
     while (z) {
-        int cmp = ts->compareFn(key, z->key);
+        int cmp = tsCompareKey(ts, key, keyPrefix, z);
         if (cmp == 0) break;
         z = (cmp < 0) ? z->left : z->right;
     }
     if (!z) return ZZ_ERR("Key not found");
 
-    TreeSetNode *y = z;
-    TreeSetNode *x, *xParent;
-    zzRBColor yOrigColor = y->color;
-
-    if (!z->left) {
-        x = z->right;
-        xParent = z->parent;
-        tsTransplant(ts, z, z->right);
-    } else if (!z->right) {
-        x = z->left;
-        xParent = z->parent;
-        tsTransplant(ts, z, z->left);
-    } else {
-        y = zzTreeSetMin(z->right);
-        yOrigColor = y->color;
-        x = y->right;
-        xParent = y;
-
-        if (y->parent == z) {
-            if (x) x->parent = y;
-            xParent = y;
-        } else {
-            xParent = y->parent;
-            tsTransplant(ts, y, y->right);
-            y->right = z->right;
-            y->right->parent = y;
-        }
-
-        tsTransplant(ts, z, y);
-        y->left = z->left;
-        y->left->parent = y;
-        y->color = z->color;
-    }
+    tsDropBounds(ts, z);
+    rbDetachNode(ts, z);
 
     if (ts->keyFree) ts->keyFree(z->key);
-    free(z);
+    tsReleaseNode(ts, z);
     ts->size--;
 
-    if (yOrigColor == ZZ_BLACK) {
-        tsDeleteFixup(ts, x, xParent);
-    }
-
     return ZZ_OK();
 }
 
@@ -345,14 +411,301 @@ void zzTreeSetClear(zzTreeSet *ts) {
     if (!ts) return;
     zzTreeSetFreeNode(ts, ts->root);
     ts->root = NULL;
+    ts->first = NULL;
+    ts->last = NULL;
     ts->size = 0;
 }
 
+static TreeSetNode *tsNextNode(TreeSetNode *node) {
+    if (node->right) return zzTreeSetMin(node->right);
+    TreeSetNode *parent = PARENT(node);
+    while (parent && node == parent->right) {
+        node = parent;
+        parent = PARENT(parent);
+    }
+    return parent;
+}
+
+// Depth of the incomplete bottom level of a balanced tree holding count nodes
+static int tsRedLevelFor(size_t count) {
+    int level = 0;
+    for (size_t m = count + 1; m > 1; m >>= 1) level++;
+    return level;
+}
+
+// Links nodes[lo, hi) into a balanced subtree; only the incomplete bottom level is red
+static TreeSetNode *tsLinkBalanced(const zzTreeSet *ts, TreeSetNode **nodes, size_t lo, size_t hi,
+                                   int depth, int redLevel, TreeSetNode *parent) {
+    if (lo >= hi) return NULL;
+
+    size_t mid = lo + (hi - lo) / 2;
+    TreeSetNode *node = nodes[mid];
+    SET_PARENT(node, parent);
+    SET_COLOR(node, (depth == redLevel) ? ZZ_RED : ZZ_BLACK);
+    node->left = tsLinkBalanced(ts, nodes, lo, mid, depth + 1, redLevel, node);
+    node->right = tsLinkBalanced(ts, nodes, mid + 1, hi, depth + 1, redLevel, node);
+    tsPullUp(ts, node);
+    return node;
+}
+
+static void tsLinkSorted(zzTreeSet *ts, TreeSetNode **nodes, size_t count) {
+    ts->root = tsLinkBalanced(ts, nodes, 0, count, 0, tsRedLevelFor(count), NULL);
+    ts->first = count > 0 ? nodes[0] : NULL;
+    ts->last = count > 0 ? nodes[count - 1] : NULL;
+    ts->size = count;
+}
+
+// Frees the keys for which pred returns verdict and relinks the survivors into a balanced
+// tree. The nodes are gathered in order first because a freed node may still be on the path
+// the in-order walk climbs back through.
+static zzOpResult zzTreeSetRemoveMatching(zzTreeSet *ts, zzPredicateFn pred, void *userdata, bool verdict, size_t *removedOut) {
+    size_t count = ts->size, kept = 0;
+    if (count > 0) {
+        TreeSetNode **nodes = malloc(count * sizeof(*nodes));
+        if (!nodes) return ZZ_ERR("Memory allocation failed");
+
+        size_t n = 0;
+        for (TreeSetNode *node = ts->first; node; node = tsNextNode(node)) nodes[n++] = node;
+
+        for (size_t i = 0; i < count; i++) {
+            TreeSetNode *node = nodes[i];
+            if (pred(node->key, userdata) != verdict) {
+                nodes[kept++] = node;
+                continue;
+            }
+            if (ts->keyFree) ts->keyFree(node->key);
+            tsReleaseNode(ts, node);
+        }
+        if (kept < count) tsLinkSorted(ts, nodes, kept);
+        free(nodes);
+    }
+    if (removedOut) *removedOut = count - kept;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Removes every key for which the predicate returns true.
+ *
+ * This function tests each key once, in ascending order, frees the matching keys
+ * and relinks the remaining nodes into a balanced tree without any rotations, so
+ * it runs in O(n) time however many keys are removed. Subtree sizes and
+ * aggregates are recomputed during relinking. If a custom free function was
+ * provided, it is called on every removed key. The predicate must not modify the
+ * set. A temporary array of n node pointers is allocated; if that fails the set
+ * is left unchanged.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to filter
+ * @param[in] pred Function selecting the keys to remove
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRemoveIf(zzTreeSet *ts, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+    return zzTreeSetRemoveMatching(ts, pred, userdata, true, removedOut);
+}
+
+/**
+ * @brief Keeps only the keys for which the predicate returns true.
+ *
+ * This function is the complement of zzTreeSetRemoveIf and removes every key
+ * that does not satisfy the predicate in the same single O(n) pass.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to filter
+ * @param[in] pred Function selecting the keys to keep
+ * @param[in] userdata Pointer passed unchanged to every call of pred
+ * @param[out] removedOut Pointer receiving the number of removed keys, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRetainIf(zzTreeSet *ts, zzPredicateFn pred, void *userdata, size_t *removedOut) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!pred) return ZZ_ERR("Predicate function is NULL");
+    return zzTreeSetRemoveMatching(ts, pred, userdata, false, removedOut);
+}
+
+// Stable bottom-up merge sort of pointers into a key array
+static void tsSortKeyRefs(const zzTreeSet *ts, const unsigned char **refs, const unsigned char **tmp, size_t count) {
+    const unsigned char **src = refs, **dst = tmp;
+    for (size_t width = 1; width < count; width *= 2) {
+        for (size_t lo = 0; lo < count; lo += 2 * width) {
+            size_t mid = (lo + width < count) ? lo + width : count;
+            size_t hi = (lo + 2 * width < count) ? lo + 2 * width : count;
+            size_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                dst[k++] = (ts->compareFn(src[j], src[i]) < 0) ? src[j++] : src[i++];
+            }
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi) dst[k++] = src[j++];
+        }
+        const unsigned char **swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != refs) memcpy(refs, src, count * sizeof(*refs));
+}
+
+/**
+ * @brief Replaces the contents of the TreeSet with keys from a sorted array.
+ *
+ * This function builds a perfectly balanced red-black tree from count keys stored
+ * contiguously in the given array, in O(n) time and without any rotations. The keys
+ * must be in strictly ascending order according to the set's comparison function.
+ * Existing keys are cleared only after the input has been validated and all nodes
+ * have been allocated, so on failure the set is left unchanged.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to build
+ * @param[in] keys Pointer to an array of count keys in strictly ascending order (contents will be copied)
+ * @param[in] count Number of keys in the array
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetBuildFromSorted(zzTreeSet *ts, const void *keys, size_t count) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (count > 0 && !keys) return ZZ_ERR("Keys pointer is NULL");
+
+    const unsigned char *keyBytes = keys;
+    for (size_t i = 1; i < count; i++) {
+        if (ts->compareFn(keyBytes + (i - 1) * ts->keySize, keyBytes + i * ts->keySize) >= 0) {
+            return ZZ_ERR("Keys are not in strictly ascending order");
+        }
+    }
+
+    if (count == 0) {
+        zzTreeSetClear(ts);
+        return ZZ_OK();
+    }
+
+    TreeSetNode **nodes = malloc(count * sizeof(*nodes));
+    if (!nodes) return ZZ_ERR("Memory allocation failed");
+
+    for (size_t i = 0; i < count; i++) {
+        nodes[i] = tsAllocNode(ts);
+        if (!nodes[i]) {
+            while (i > 0) free(nodes[--i]);
+            free(nodes);
+            return ZZ_ERR("Failed to allocate node");
+        }
+        memcpy(nodes[i]->key, keyBytes + i * ts->keySize, ts->keySize);
+        tsStorePrefix(ts, nodes[i]);
+    }
+
+    zzTreeSetClear(ts);
+    tsLinkSorted(ts, nodes, count);
+    free(nodes);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Inserts a batch of keys into the TreeSet.
+ *
+ * This function stably sorts the (possibly unsorted) batch, merges it with the
+ * existing keys in a single in-order pass and relinks all nodes into a balanced
+ * tree, costing O(m log m + n) instead of m separate rebalancing insertions. Existing
+ * nodes are reused. Keys that are already present, or that repeat within the batch,
+ * are skipped. Batches that are small relative to the set are inserted one by one instead.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to insert into
+ * @param[in] keys Pointer to an array of count keys in any order (contents will be copied)
+ * @param[in] count Number of keys in the array
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetInsertAll(zzTreeSet *ts, const void *keys, size_t count) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (count == 0) return ZZ_OK();
+    if (!keys) return ZZ_ERR("Keys pointer is NULL");
+
+    const unsigned char *keyBytes = keys;
+    const unsigned char **refs = malloc(2 * count * sizeof(*refs));
+    if (!refs) return ZZ_ERR("Memory allocation failed");
+    for (size_t i = 0; i < count; i++) refs[i] = keyBytes + i * ts->keySize;
+    tsSortKeyRefs(ts, refs, refs + count, count);
+
+    // A rebuild touches every node, so small batches are cheaper to insert one by one
+    if (count * (size_t)tsRedLevelFor(ts->size) < ts->size) {
+        for (size_t i = 0; i < count; i++) {
+            if (i > 0 && ts->compareFn(refs[i - 1], refs[i]) == 0) continue;
+            if (zzTreeSetContains(ts, refs[i])) continue;
+            zzOpResult res = zzTreeSetInsert(ts, refs[i]);
+            if (ZZ_IS_ERR(res)) {
+                free(refs);
+                return res;
+            }
+        }
+        free(refs);
+        return ZZ_OK();
+    }
+
+    // Existing nodes are gathered at the tail of the merge buffer; the merge never overtakes them
+    size_t oldCount = ts->size;
+    TreeSetNode **merged = malloc((oldCount + count) * sizeof(*merged));
+    if (!merged) {
+        free(refs);
+        return ZZ_ERR("Memory allocation failed");
+    }
+    TreeSetNode **old = merged + count;
+    size_t n = 0;
+    for (TreeSetNode *cur = zzTreeSetMin(ts->root); cur; cur = tsNextNode(cur)) old[n++] = cur;
+
+    // First pass counts new keys so every allocation happens before the set is touched
+    size_t freshCount = 0;
+    for (size_t i = 0, j = 0; j < count; ) {
+        size_t end = j + 1;
+        while (end < count && ts->compareFn(refs[end], refs[j]) == 0) end++;
+        while (i < oldCount && ts->compareFn(old[i]->key, refs[j]) < 0) i++;
+        if (i == oldCount || ts->compareFn(old[i]->key, refs[j]) != 0) freshCount++;
+        j = end;
+    }
+
+    TreeSetNode **fresh = NULL;
+    if (freshCount > 0) {
+        fresh = malloc(freshCount * sizeof(*fresh));
+        if (!fresh) {
+            free(merged);
+            free(refs);
+            return ZZ_ERR("Memory allocation failed");
+        }
+        for (size_t f = 0; f < freshCount; f++) {
+            fresh[f] = tsAllocNode(ts);
+            if (!fresh[f]) {
+                while (f > 0) free(fresh[--f]);
+                free(fresh);
+                free(merged);
+                free(refs);
+                return ZZ_ERR("Failed to allocate node");
+            }
+        }
+    }
+
+    size_t i = 0, k = 0, used = 0;
+    for (size_t j = 0; j < count; ) {
+        size_t end = j + 1;
+        while (end < count && ts->compareFn(refs[end], refs[j]) == 0) end++;
+        while (i < oldCount && ts->compareFn(old[i]->key, refs[j]) < 0) merged[k++] = old[i++];
+
+        if (i < oldCount && ts->compareFn(old[i]->key, refs[j]) == 0) {
+            merged[k++] = old[i++];
+        } else {
+            TreeSetNode *node = fresh[used++];
+            memcpy(node->key, refs[j], ts->keySize);
+            tsStorePrefix(ts, node);
+            merged[k++] = node;
+        }
+        j = end;
+    }
+    while (i < oldCount) merged[k++] = old[i++];
+
+    tsLinkSorted(ts, merged, k);
+    free(fresh);
+    free(merged);
+    free(refs);
+    return ZZ_OK();
+}
+
 /**
  * @brief Gets the minimum key from the TreeSet.
  *
  * This function retrieves the smallest key in the tree set and copies it to the
- * output buffer. The minimum element is the leftmost node in the binary search tree.
+ * output buffer. The set keeps a pointer to its leftmost node, so this takes O(1) time.
  *
  * @param[in] ts Pointer to the TreeSet to retrieve from
  * @param[out] keyOut Pointer to a buffer where the minimum key will be copied
@@ -363,7 +716,7 @@ zzOpResult zzTreeSetGetMin(const zzTreeSet *ts, void *keyOut) {
     if (!keyOut) return ZZ_ERR("Key output pointer is NULL");
     if (!ts->root) return ZZ_ERR("Set is empty");
 
-    TreeSetNode *min = zzTreeSetMin(ts->root);
+    TreeSetNode *min = ts->first;
     memcpy(keyOut, min->key, ts->keySize);
     return ZZ_OK();
 }
@@ -372,7 +725,7 @@ zzOpResult zzTreeSetGetMin(const zzTreeSet *ts, void *keyOut) {
  * @brief Gets the maximum key from the TreeSet.
  *
  * This function retrieves the largest key in the tree set and copies it to the
- * output buffer. The maximum element is the rightmost node in the binary search tree.
+ * output buffer. The set keeps a pointer to its rightmost node, so this takes O(1) time.
  *
  * @param[in] ts Pointer to the TreeSet to retrieve from
  * @param[out] keyOut Pointer to a buffer where the maximum key will be copied
@@ -383,11 +736,807 @@ zzOpResult zzTreeSetGetMax(const zzTreeSet *ts, void *keyOut) {
     if (!keyOut) return ZZ_ERR("Key output pointer is NULL");
     if (!ts->root) return ZZ_ERR("Set is empty");
 
-    TreeSetNode *max = zzTreeSetMax(ts->root);
+    TreeSetNode *max = ts->last;
     memcpy(keyOut, max->key, ts->keySize);
     return ZZ_OK();
 }
 
+// Detaches a node and hands its key to the caller instead of freeing it
+static void tsPollNode(zzTreeSet *ts, TreeSetNode *node, void *keyOut) {
+    tsDropBounds(ts, node);
+    rbDetachNode(ts, node);
+
+    if (keyOut) memcpy(keyOut, node->key, ts->keySize);
+    else if (ts->keyFree) ts->keyFree(node->key);
+    tsReleaseNode(ts, node);
+    ts->size--;
+}
+
+/**
+ * @brief Removes the smallest key from the TreeSet and returns it.
+ *
+ * This function removes the leftmost key in a single operation, without a
+ * separate lookup, so the set can serve as an updatable priority queue. The key
+ * is handed to the caller, so the free function is not called on it; keyOut may
+ * be NULL to discard the key, in which case the free function is called instead.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to remove from
+ * @param[out] keyOut Pointer to a buffer where the smallest key will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetPollFirst(zzTreeSet *ts, void *keyOut) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!ts->first) return ZZ_ERR("Set is empty");
+
+    tsPollNode(ts, ts->first, keyOut);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Removes the largest key from the TreeSet and returns it.
+ *
+ * This function removes the rightmost key in a single operation, without a
+ * separate lookup. The key is handed to the caller, so the free function is not
+ * called on it; keyOut may be NULL to discard the key, in which case the free
+ * function is called instead.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to remove from
+ * @param[out] keyOut Pointer to a buffer where the largest key will be copied, or NULL
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetPollLast(zzTreeSet *ts, void *keyOut) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!ts->last) return ZZ_ERR("Set is empty");
+
+    tsPollNode(ts, ts->last, keyOut);
+    return ZZ_OK();
+}
+
+// Number of keys strictly smaller than key; requires size augmentation
+static size_t tsCountLess(const zzTreeSet *ts, const void *key) {
+    uint64_t keyPrefix = tsProbePrefix(ts, key);
+    size_t rank = 0;
+    TreeSetNode *cur = ts->root;
+    while (cur) {
+        if (tsCompareKey(ts, key, keyPrefix, cur) <= 0) {
+            cur = cur->left;
+        } else {
+            rank += tsSubtreeSize(ts, cur->left) + 1;
+            cur = cur->right;
+        }
+    }
+    return rank;
+}
+
+// First node whose key is not smaller than key, or NULL if there is none
+static TreeSetNode *tsLowerBound(const zzTreeSet *ts, const void *key) {
+    uint64_t keyPrefix = tsProbePrefix(ts, key);
+    TreeSetNode *found = NULL;
+    TreeSetNode *cur = ts->root;
+    while (cur) {
+        if (tsCompareKey(ts, key, keyPrefix, cur) <= 0) {
+            found = cur;
+            cur = cur->left;
+        } else {
+            cur = cur->right;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Computes the rank of a key in an augmented TreeSet.
+ *
+ * This function counts how many keys in the tree set are strictly smaller than
+ * the given key, using the subtree sizes kept by an augmented set. The key does
+ * not need to be present in the set. Runs in O(log n).
+ *
+ * @param[in] ts Pointer to the augmented TreeSet to query
+ * @param[in] key Pointer to the key whose rank is requested
+ * @param[out] rankOut Pointer to where the number of smaller keys will be stored
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRank(const zzTreeSet *ts, const void *key, size_t *rankOut) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!rankOut) return ZZ_ERR("Rank output pointer is NULL");
+    if (!ts->augmented) return ZZ_ERR("TreeSet is not augmented");
+
+    *rankOut = tsCountLess(ts, key);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Retrieves the key at the given sorted position of an augmented TreeSet.
+ *
+ * This function finds the rank-th smallest key (0-based) in the tree set and
+ * copies it to the output buffer. Runs in O(log n).
+ *
+ * @param[in] ts Pointer to the augmented TreeSet to query
+ * @param[in] rank Sorted position of the key to retrieve (0-based)
+ * @param[out] keyOut Pointer to a buffer where the key will be copied
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSelect(const zzTreeSet *ts, size_t rank, void *keyOut) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!keyOut) return ZZ_ERR("Key output pointer is NULL");
+    if (!ts->augmented) return ZZ_ERR("TreeSet is not augmented");
+    if (rank >= ts->size) return ZZ_ERR("Rank out of bounds");
+
+    TreeSetNode *cur = ts->root;
+    while (cur) {
+        size_t leftSize = tsSubtreeSize(ts, cur->left);
+        if (rank < leftSize) {
+            cur = cur->left;
+        } else if (rank == leftSize) {
+            break;
+        } else {
+            rank -= leftSize + 1;
+            cur = cur->right;
+        }
+    }
+
+    memcpy(keyOut, cur->key, ts->keySize);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Computes the aggregate of all keys in [lo, hi).
+ *
+ * This function combines the per-subtree aggregates of an augmented TreeSet that
+ * was initialized with aggregate functions, touching O(log n) nodes. A NULL bound
+ * leaves that side of the range open. The function returns an error if no key
+ * falls inside the range, since an empty range has no aggregate.
+ *
+ * @param[in] ts Pointer to the augmented TreeSet to query
+ * @param[in] lo Pointer to the inclusive lower bound key, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound key, or NULL for no upper bound
+ * @param[out] aggOut Pointer to a buffer of aggSize bytes receiving the aggregate
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRangeAggregate(const zzTreeSet *ts, const void *lo, const void *hi, void *aggOut) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!aggOut) return ZZ_ERR("Aggregate output pointer is NULL");
+    if (!ts->augmented || ts->aggSize == 0) return ZZ_ERR("TreeSet has no aggregate");
+
+    // Find the highest node inside the range; both halves of the range hang below it
+    TreeSetNode *split = ts->root;
+    while (split) {
+        if (lo && ts->compareFn(split->key, lo) < 0) split = split->right;
+        else if (hi && ts->compareFn(split->key, hi) >= 0) split = split->left;
+        else break;
+    }
+    if (!split) return ZZ_ERR("No keys in range");
+
+    unsigned char *single = malloc(ts->aggSize);
+    if (!single) return ZZ_ERR("Memory allocation failed");
+
+    ts->aggInit(aggOut, split->key);
+
+    // Left half: each node >= lo contributes itself and its right subtree, largest first
+    TreeSetNode *cur = split->left;
+    while (cur) {
+        if (!lo) {
+            ts->aggCombine(aggOut, AGG_PTR(ts, cur), aggOut);
+            break;
+        }
+        if (ts->compareFn(cur->key, lo) < 0) {
+            cur = cur->right;
+            continue;
+        }
+        if (cur->right) ts->aggCombine(aggOut, AGG_PTR(ts, cur->right), aggOut);
+        ts->aggInit(single, cur->key);
+        ts->aggCombine(aggOut, single, aggOut);
+        cur = cur->left;
+    }
+
+    // Right half: each node < hi contributes its left subtree and itself, smallest first
+    cur = split->right;
+    while (cur) {
+        if (!hi) {
+            ts->aggCombine(aggOut, aggOut, AGG_PTR(ts, cur));
+            break;
+        }
+        if (ts->compareFn(cur->key, hi) >= 0) {
+            cur = cur->left;
+            continue;
+        }
+        if (cur->left) ts->aggCombine(aggOut, aggOut, AGG_PTR(ts, cur->left));
+        ts->aggInit(single, cur->key);
+        ts->aggCombine(aggOut, aggOut, single);
+        cur = cur->right;
+    }
+
+    free(single);
+    return ZZ_OK();
+}
+
+enum { KEEP_FIRST_ONLY = 1, KEEP_BOTH = 2, KEEP_SECOND_ONLY = 4 };
+
+// Merges a and b in order into dst as a balanced tree, keeping the key classes in keep.
+// In place (dst == a) the nodes of a are reused or freed; otherwise dst receives copies.
+static zzOpResult tsMergeInto(zzTreeSet *dst, const zzTreeSet *a, const zzTreeSet *b, int keep) {
+    bool inPlace = (dst == a);
+    size_t cap = a->size + b->size;
+    if (cap == 0) return ZZ_OK();
+
+    // Emitted nodes fill the front of out; dropped nodes of an in-place target fill the back
+    TreeSetNode **out = malloc(cap * sizeof(*out));
+    if (!out) return ZZ_ERR("Memory allocation failed");
+    size_t front = 0, back = cap;
+
+    // Out of place every emitted node is new; in place only keys taken from b are
+    TreeSetNode **fresh = out;
+    size_t freshCount = 0;
+    if (inPlace && (keep & KEEP_SECOND_ONLY) && b->size > 0) {
+        fresh = malloc(b->size * sizeof(*fresh));
+        if (!fresh) {
+            free(out);
+            return ZZ_ERR("Memory allocation failed");
+        }
+    }
+
+    TreeSetNode *x = zzTreeSetMin(a->root);
+    TreeSetNode *y = zzTreeSetMin(b->root);
+    while (x || y) {
+        int cmp = !x ? 1 : !y ? -1 : a->compareFn(x->key, y->key);
+        const unsigned char *key;
+        TreeSetNode *own = NULL;
+        int kind;
+
+        if (cmp < 0) {
+            kind = KEEP_FIRST_ONLY;
+            key = x->key;
+            own = x;
+            x = tsNextNode(x);
+        } else if (cmp > 0) {
+            kind = KEEP_SECOND_ONLY;
+            key = y->key;
+            y = tsNextNode(y);
+        } else {
+            kind = KEEP_BOTH;
+            key = x->key;
+            own = x;
+            x = tsNextNode(x);
+            y = tsNextNode(y);
+        }
+        if (!inPlace) own = NULL;
+
+        if (!(keep & kind)) {
+            if (own) out[--back] = own;
+            continue;
+        }
+        if (own) {
+            out[front++] = own;
+            continue;
+        }
+
+        TreeSetNode *node = tsAllocNode(dst);
+        if (!node) {
+            if (fresh == out) freshCount = front;
+            for (size_t i = 0; i < freshCount; i++) free(fresh[i]);
+            if (fresh != out) free(fresh);
+            free(out);
+            return ZZ_ERR("Failed to allocate node");
+        }
+        memcpy(node->key, key, dst->keySize);
+        tsStorePrefix(dst, node);
+        out[front++] = node;
+        if (fresh != out) fresh[freshCount++] = node;
+    }
+
+    for (size_t i = back; i < cap; i++) {
+        if (dst->keyFree) dst->keyFree(out[i]->key);
+        tsReleaseNode(dst, out[i]);
+    }
+    tsLinkSorted(dst, out, front);
+
+    if (fresh != out) free(fresh);
+    free(out);
+    return ZZ_OK();
+}
+
+static zzOpResult tsSetOperation(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree, int keep) {
+    if (!s1) return ZZ_ERR("TreeSet s1 pointer is NULL");
+    if (!s2) return ZZ_ERR("TreeSet s2 pointer is NULL");
+    if (!result) return ZZ_ERR("Result TreeSet pointer is NULL");
+    if (result == s1 || result == s2) return ZZ_ERR("Result TreeSet must differ from the inputs");
+    if (s1->keySize != s2->keySize || s1->compareFn != s2->compareFn) return ZZ_ERR("TreeSets are not compatible");
+
+    zzOpResult initResult = s1->augmented
+        ? zzTreeSetInitAugmented(result, s1->keySize, s1->compareFn, keyFree, s1->aggSize, s1->aggInit, s1->aggCombine)
+        : zzTreeSetInit(result, s1->keySize, s1->compareFn, keyFree);
+    if (ZZ_IS_ERR(initResult)) return initResult;
+    result->prefixFn = s1->prefixFn;
+
+    return tsMergeInto(result, s1, s2, keep);
+}
+
+static zzOpResult tsSetOperationInPlace(zzTreeSet *s1, const zzTreeSet *s2, int keep) {
+    if (!s1) return ZZ_ERR("TreeSet s1 pointer is NULL");
+    if (!s2) return ZZ_ERR("TreeSet s2 pointer is NULL");
+    if (s1->keySize != s2->keySize || s1->compareFn != s2->compareFn) return ZZ_ERR("TreeSets are not compatible");
+
+    return tsMergeInto(s1, s1, s2, keep);
+}
+
+/**
+ * @brief Computes the union of two tree sets into a new set.
+ *
+ * This function walks both sets in sorted order, merges them in O(n + m) and builds
+ * the result as a balanced tree in a single pass. The result set is initialized by
+ * this function with the key size, comparison function, augmentation and key
+ * prefix settings of the first set. Both sets must share the same key size and comparison function.
+ *
+ * @param[in] s1 Pointer to the first TreeSet
+ * @param[in] s2 Pointer to the second TreeSet
+ * @param[out] result Pointer to the TreeSet where the union will be stored
+ * @param[in] keyFree Function to free key memory in the result set, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetUnion(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree) {
+    return tsSetOperation(s1, s2, result, keyFree, KEEP_FIRST_ONLY | KEEP_BOTH | KEEP_SECOND_ONLY);
+}
+
+/**
+ * @brief Computes the intersection of two tree sets into a new set.
+ *
+ * This function walks both sets in sorted order and collects the keys present in
+ * both, in O(n + m), building the result as a balanced tree in a single pass. The
+ * result set is initialized by this function like the first set. Both sets must
+ * share the same key size and comparison function.
+ *
+ * @param[in] s1 Pointer to the first TreeSet
+ * @param[in] s2 Pointer to the second TreeSet
+ * @param[out] result Pointer to the TreeSet where the intersection will be stored
+ * @param[in] keyFree Function to free key memory in the result set, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetIntersection(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree) {
+    return tsSetOperation(s1, s2, result, keyFree, KEEP_BOTH);
+}
+
+/**
+ * @brief Computes the difference of two tree sets into a new set.
+ *
+ * This function walks both sets in sorted order and collects the keys of the first
+ * set that are absent from the second, in O(n + m), building the result as a
+ * balanced tree in a single pass. The result set is initialized by this function
+ * like the first set. Both sets must share the same key size and comparison function.
+ *
+ * @param[in] s1 Pointer to the first TreeSet (minuend)
+ * @param[in] s2 Pointer to the second TreeSet (subtrahend)
+ * @param[out] result Pointer to the TreeSet where the difference will be stored
+ * @param[in] keyFree Function to free key memory in the result set, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetDifference(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree) {
+    return tsSetOperation(s1, s2, result, keyFree, KEEP_FIRST_ONLY);
+}
+
+/**
+ * @brief Computes the symmetric difference of two tree sets into a new set.
+ *
+ * This function walks both sets in sorted order and collects the keys present in
+ * exactly one of them, in O(n + m), building the result as a balanced tree in a
+ * single pass. The result set is initialized by this function like the first set.
+ * Both sets must share the same key size and comparison function.
+ *
+ * @param[in] s1 Pointer to the first TreeSet
+ * @param[in] s2 Pointer to the second TreeSet
+ * @param[out] result Pointer to the TreeSet where the symmetric difference will be stored
+ * @param[in] keyFree Function to free key memory in the result set, or NULL if not needed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSymmetricDifference(const zzTreeSet *s1, const zzTreeSet *s2, zzTreeSet *result, zzFreeFn keyFree) {
+    return tsSetOperation(s1, s2, result, keyFree, KEEP_FIRST_ONLY | KEEP_SECOND_ONLY);
+}
+
+/**
+ * @brief Adds every key of the second tree set to the first.
+ *
+ * This function merges both sets in sorted order in O(n + m) and relinks the first
+ * set as a balanced tree, reusing its existing nodes and copying only the keys that
+ * it did not already contain. On failure the first set is left unchanged.
+ *
+ * @param[in,out] s1 Pointer to the TreeSet that receives the union
+ * @param[in] s2 Pointer to the TreeSet whose keys are added
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetUnionInPlace(zzTreeSet *s1, const zzTreeSet *s2) {
+    return tsSetOperationInPlace(s1, s2, KEEP_FIRST_ONLY | KEEP_BOTH | KEEP_SECOND_ONLY);
+}
+
+/**
+ * @brief Removes from the first tree set every key absent from the second.
+ *
+ * This function merges both sets in sorted order in O(n + m), frees the nodes of
+ * the first set whose keys are not in the second (calling keyFree if provided) and
+ * relinks the remaining nodes as a balanced tree.
+ *
+ * @param[in,out] s1 Pointer to the TreeSet that keeps the intersection
+ * @param[in] s2 Pointer to the TreeSet to intersect with
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetIntersectionInPlace(zzTreeSet *s1, const zzTreeSet *s2) {
+    return tsSetOperationInPlace(s1, s2, KEEP_BOTH);
+}
+
+/**
+ * @brief Removes from the first tree set every key present in the second.
+ *
+ * This function merges both sets in sorted order in O(n + m), frees the nodes of
+ * the first set whose keys also appear in the second (calling keyFree if provided)
+ * and relinks the remaining nodes as a balanced tree.
+ *
+ * @param[in,out] s1 Pointer to the TreeSet that keeps the difference
+ * @param[in] s2 Pointer to the TreeSet whose keys are removed
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetDifferenceInPlace(zzTreeSet *s1, const zzTreeSet *s2) {
+    return tsSetOperationInPlace(s1, s2, KEEP_FIRST_ONLY);
+}
+
+/**
+ * @brief Replaces the first tree set with the symmetric difference of both sets.
+ *
+ * This function merges both sets in sorted order in O(n + m), frees the nodes of
+ * the first set whose keys also appear in the second (calling keyFree if provided),
+ * copies in the keys found only in the second set and relinks the result as a
+ * balanced tree. On allocation failure the first set is left unchanged.
+ *
+ * @param[in,out] s1 Pointer to the TreeSet that receives the symmetric difference
+ * @param[in] s2 Pointer to the other TreeSet
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSymmetricDifferenceInPlace(zzTreeSet *s1, const zzTreeSet *s2) {
+    return tsSetOperationInPlace(s1, s2, KEEP_FIRST_ONLY | KEEP_SECOND_ONLY);
+}
+
+// Number of black nodes on any path from node down to a leaf
+static int tsBlackHeight(const TreeSetNode *node) {
+    int height = 0;
+    for (; node; node = node->left) {
+        if (COLOR(node) == ZZ_BLACK) height++;
+    }
+    return height;
+}
+
+// Joins the subtrees l < k < r of black heights lh and rh through the middle node k in
+// O(|lh - rh| + 1) steps; returns the new root and stores its black height in heightOut
+static TreeSetNode *tsJoinAt(zzTreeSet *ctx, TreeSetNode *l, int lh, TreeSetNode *k, TreeSetNode *r, int rh, int *heightOut) {
+    if (l) {
+        SET_PARENT(l, NULL);
+        if (COLOR(l) == ZZ_RED) { SET_COLOR(l, ZZ_BLACK); lh++; }
+    }
+    if (r) {
+        SET_PARENT(r, NULL);
+        if (COLOR(r) == ZZ_RED) { SET_COLOR(r, ZZ_BLACK); rh++; }
+    }
+
+    if (lh == rh) {
+        k->left = l;
+        k->right = r;
+        SET_PARENT(k, NULL);
+        SET_COLOR(k, ZZ_BLACK);
+        if (l) SET_PARENT(l, k);
+        if (r) SET_PARENT(r, k);
+        tsPullUp(ctx, k);
+        *heightOut = lh + 1;
+        return k;
+    }
+
+    // Walk down the inner spine of the taller tree to a black node as high as the shorter tree
+    bool leftTaller = lh > rh;
+    TreeSetNode *tall = leftTaller ? l : r;
+    int height = leftTaller ? lh : rh;
+    int target = leftTaller ? rh : lh;
+    TreeSetNode *parent = NULL;
+    TreeSetNode *c = tall;
+    while (c && (COLOR(c) == ZZ_RED || height > target)) {
+        if (COLOR(c) == ZZ_BLACK) height--;
+        parent = c;
+        c = leftTaller ? c->right : c->left;
+    }
+
+    SET_PARENT(k, parent);
+    SET_COLOR(k, ZZ_RED);
+    if (leftTaller) {
+        k->left = c;
+        k->right = r;
+        parent->right = k;
+    } else {
+        k->left = l;
+        k->right = c;
+        parent->left = k;
+    }
+    if (k->left) SET_PARENT(k->left, k);
+    if (k->right) SET_PARENT(k->right, k);
+
+    ctx->root = tall;
+    tsPullUpToRoot(ctx, k);
+    *heightOut = (leftTaller ? lh : rh) + rbInsertFixup(ctx, k);
+    return ctx->root;
+}
+
+// Splits the subtree rooted at node, of black height height, into keys < key and keys >= key
+static void tsSplitAt(zzTreeSet *ctx, TreeSetNode *node, int height, const void *key, uint64_t keyPrefix,
+                    TreeSetNode **lo, int *loHeight, TreeSetNode **hi, int *hiHeight) {
+    if (!node) {
+        *lo = *hi = NULL;
+        *loHeight = *hiHeight = 0;
+        return;
+    }
+
+    int childHeight = height - (COLOR(node) == ZZ_BLACK);
+    if (tsCompareKey(ctx, key, keyPrefix, node) <= 0) {
+        tsSplitAt(ctx, node->left, childHeight, key, keyPrefix, lo, loHeight, hi, hiHeight);
+        *hi = tsJoinAt(ctx, *hi, *hiHeight, node, node->right, childHeight, hiHeight);
+    } else {
+        tsSplitAt(ctx, node->right, childHeight, key, keyPrefix, lo, loHeight, hi, hiHeight);
+        *lo = tsJoinAt(ctx, node->left, childHeight, node, *lo, *loHeight, loHeight);
+    }
+}
+
+// Counts the nodes under a by walking a and b in lockstep, so only the smaller tree is fully visited
+static size_t tsCountLockstep(TreeSetNode *a, TreeSetNode *b, size_t total) {
+    TreeSetNode *x = zzTreeSetMin(a);
+    TreeSetNode *y = zzTreeSetMin(b);
+    size_t steps = 0;
+    while (x && y) {
+        x = tsNextNode(x);
+        y = tsNextNode(y);
+        steps++;
+    }
+    return x ? total - steps : steps;
+}
+
+// Joins the trees l < r of black heights lh and rh, borrowing the smallest node of r as the link
+static TreeSetNode *tsJoinTrees(zzTreeSet *ctx, TreeSetNode *l, int lh, TreeSetNode *r) {
+    if (!r) return l;
+
+    TreeSetNode *mid = zzTreeSetMin(r);
+    ctx->root = r;
+    rbDetachNode(ctx, mid);
+    r = ctx->root;
+
+    int height;
+    return tsJoinAt(ctx, l, lh, mid, r, tsBlackHeight(r), &height);
+}
+
+/**
+ * @brief Splits a TreeSet around a key into two TreeSets.
+ *
+ * This function moves every key smaller than the given key into left and every
+ * remaining key into right, reusing the existing nodes without copying any keys.
+ * The tree is cut along the search path and the pieces are rejoined by black
+ * height. Both outputs are initialized with the configuration of ts (including
+ * augmentation); their previous contents are not freed. Unless it is passed as
+ * one of the outputs, ts is left empty and remains usable. Augmented sets know
+ * their subtree sizes, so the split takes O(log n) time; for plain sets the
+ * smaller half is additionally counted to set the sizes, which makes it
+ * O(log n + min(|L|, |R|)) for output sizes |L| and |R|.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to split
+ * @param[in] key Pointer to the key at which to split; this key itself goes to right
+ * @param[out] left Pointer to the TreeSet receiving the smaller keys
+ * @param[out] right Pointer to the TreeSet receiving the greater or equal keys
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetSplit(zzTreeSet *ts, const void *key, zzTreeSet *left, zzTreeSet *right) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!key) return ZZ_ERR("Key pointer is NULL");
+    if (!left) return ZZ_ERR("Left TreeSet pointer is NULL");
+    if (!right) return ZZ_ERR("Right TreeSet pointer is NULL");
+    if (left == right) return ZZ_ERR("Left and right TreeSets must differ");
+
+    zzTreeSet ctx = *ts;
+    TreeSetNode *lo, *hi;
+    int loHeight, hiHeight;
+    tsSplitAt(&ctx, ts->root, tsBlackHeight(ts->root), key, tsProbePrefix(ts, key), &lo, &loHeight, &hi, &hiHeight);
+
+    size_t total = ts->size;
+    size_t loSize = ts->augmented ? tsSubtreeSize(ts, lo) : tsCountLockstep(lo, hi, total);
+
+    ts->root = NULL;
+    ts->first = NULL;
+    ts->last = NULL;
+    ts->size = 0;
+
+    *left = ctx;
+    left->root = lo;
+    left->size = loSize;
+    tsRefreshBounds(left);
+
+    *right = ctx;
+    right->root = hi;
+    right->size = total - loSize;
+    tsRefreshBounds(right);
+
+    return ZZ_OK();
+}
+
+/**
+ * @brief Joins two TreeSets whose key ranges do not overlap.
+ *
+ * This function moves every key of right into left, reusing the existing
+ * nodes without copying any keys. Every key in left must be smaller
+ * than every key in right. The smaller tree is hung into the spine of the taller
+ * one at matching black height and rebalanced, which takes O(log n) time. Both
+ * sets must share key size, comparison function, augmentation and key prefix
+ * function; left keeps its own free function. Afterwards right is empty and
+ * remains usable.
+ *
+ * @param[in,out] left Pointer to the TreeSet receiving all keys
+ * @param[in,out] right Pointer to the TreeSet whose keys are moved; emptied on success
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetJoin(zzTreeSet *left, zzTreeSet *right) {
+    if (!left) return ZZ_ERR("Left TreeSet pointer is NULL");
+    if (!right) return ZZ_ERR("Right TreeSet pointer is NULL");
+    if (left == right) return ZZ_ERR("Left and right TreeSets must differ");
+    if (left->keySize != right->keySize || left->compareFn != right->compareFn ||
+        left->augmented != right->augmented || left->aggSize != right->aggSize ||
+        left->aggInit != right->aggInit || left->aggCombine != right->aggCombine ||
+        left->prefixFn != right->prefixFn) {
+        return ZZ_ERR("TreeSets are not compatible");
+    }
+    if (!right->root) return ZZ_OK();
+
+    if (left->root && left->compareFn(zzTreeSetMax(left->root)->key, zzTreeSetMin(right->root)->key) >= 0) {
+        return ZZ_ERR("Left keys must all be smaller than right keys");
+    }
+
+    zzTreeSet ctx = *left;
+    left->root = tsJoinTrees(&ctx, left->root, tsBlackHeight(left->root), right->root);
+    left->size += right->size;
+    tsRefreshBounds(left);
+
+    right->root = NULL;
+    right->first = NULL;
+    right->last = NULL;
+    right->size = 0;
+
+    return ZZ_OK();
+}
+
+/**
+ * @brief Removes every key that lies in the range [lo, hi).
+ *
+ * This function cuts the range out of the tree with two splits, joins the
+ * remaining halves back together and then frees the detached subtree in a
+ * single pass, instead of rebalancing once per removed key. It runs in
+ * O(log n + k) time for k removed keys. A NULL bound leaves that side of the
+ * range open. If a custom free function was provided for keys, it is called
+ * on every removed key.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to remove the keys from
+ * @param[in] lo Pointer to the inclusive lower bound, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound, or NULL for no upper bound
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetRemoveRange(zzTreeSet *ts, const void *lo, const void *hi) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (lo && hi && ts->compareFn(lo, hi) >= 0) return ZZ_OK();
+
+    zzTreeSet ctx = *ts;
+    TreeSetNode *below = NULL, *rest = ts->root, *inside, *above = NULL;
+    int belowHeight = 0, restHeight = tsBlackHeight(ts->root), insideHeight, aboveHeight;
+
+    if (lo) tsSplitAt(&ctx, rest, restHeight, lo, tsProbePrefix(ts, lo), &below, &belowHeight, &rest, &restHeight);
+    if (hi) {
+        tsSplitAt(&ctx, rest, restHeight, hi, tsProbePrefix(ts, hi), &inside, &insideHeight, &above, &aboveHeight);
+    } else {
+        inside = rest;
+    }
+
+    ts->size -= zzTreeSetFreeNode(ts, inside);
+    ts->root = tsJoinTrees(&ctx, below, belowHeight, above);
+    tsRefreshBounds(ts);
+    return ZZ_OK();
+}
+
+/**
+ * @brief Counts the keys that lie in the range [lo, hi).
+ *
+ * This function counts the keys in the half-open range without modifying the
+ * set. On sets created with zzTreeSetInitAugmented the count is derived from the
+ * subtree sizes in O(log n) time; otherwise the keys in the range are walked
+ * in O(log n + k) time. A NULL bound leaves that side of the range open.
+ *
+ * @param[in] ts Pointer to the TreeSet to count in
+ * @param[in] lo Pointer to the inclusive lower bound, or NULL for no lower bound
+ * @param[in] hi Pointer to the exclusive upper bound, or NULL for no upper bound
+ * @param[out] countOut Pointer to a size_t receiving the number of keys in the range
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetCountRange(const zzTreeSet *ts, const void *lo, const void *hi, size_t *countOut) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (!countOut) return ZZ_ERR("Count output pointer is NULL");
+
+    if (lo && hi && ts->compareFn(lo, hi) >= 0) {
+        *countOut = 0;
+        return ZZ_OK();
+    }
+
+    if (ts->augmented) {
+        size_t below = lo ? tsCountLess(ts, lo) : 0;
+        size_t upTo = hi ? tsCountLess(ts, hi) : ts->size;
+        *countOut = upTo - below;
+        return ZZ_OK();
+    }
+
+    size_t count = 0;
+    TreeSetNode *cur = lo ? tsLowerBound(ts, lo) : zzTreeSetMin(ts->root);
+    while (cur && (!hi || ts->compareFn(cur->key, hi) < 0)) {
+        count++;
+        cur = tsNextNode(cur);
+    }
+    *countOut = count;
+    return ZZ_OK();
+}
+
+/**
+ * @brief Relocates all nodes of the TreeSet into contiguous memory in key order.
+ *
+ * After many insertions and removals the nodes of a tree end up scattered over
+ * the heap, so an in-order walk takes a cache miss per node. This function
+ * copies every node into large size-aligned slab chunks in ascending key order
+ * and relinks them into a perfectly balanced tree, so iteration and range scans
+ * touch memory sequentially again. Keys are moved, not copied, so the free
+ * function is not called. Nodes inserted later are allocated individually as
+ * usual, and a chunk is returned to the system once all of its nodes are gone.
+ * Runs in O(n) time and invalidates all iterators over the set.
+ *
+ * @param[in,out] ts Pointer to the TreeSet to compact
+ * @return zzOpResult with status ZZ_SUCCESS on success, or ZZ_ERROR with error message on failure
+ */
+zzOpResult zzTreeSetCompact(zzTreeSet *ts) {
+    if (!ts) return ZZ_ERR("TreeSet pointer is NULL");
+    if (ts->size == 0) return ZZ_OK();
+
+    size_t stride = tsSlabStride(ts);
+    size_t chunkBytes = tsSlabChunkBytes(ts);
+    size_t perChunk = (chunkBytes - tsSlabHeaderBytes()) / stride;
+    size_t chunkCount = (ts->size + perChunk - 1) / perChunk;
+
+    TreeSetNode **nodes = malloc(ts->size * sizeof(TreeSetNode*));
+    SlabChunk **chunks = malloc(chunkCount * sizeof(SlabChunk*));
+    if (!nodes || !chunks) {
+        free(nodes);
+        free(chunks);
+        return ZZ_ERR("Memory allocation failed");
+    }
+    for (size_t c = 0; c < chunkCount; c++) {
+        chunks[c] = aligned_alloc(chunkBytes, chunkBytes);
+        if (!chunks[c]) {
+            while (c > 0) free(chunks[--c]);
+            free(chunks);
+            free(nodes);
+            return ZZ_ERR("Memory allocation failed");
+        }
+        chunks[c]->live = (c + 1 < chunkCount) ? perChunk : ts->size - c * perChunk;
+    }
+
+    // Copy the nodes into consecutive slots in key order; the old nodes are released afterwards
+    size_t i = 0;
+    for (TreeSetNode *cur = zzTreeSetMin(ts->root); cur; cur = tsNextNode(cur), i++) {
+        unsigned char *slot = (unsigned char*)chunks[i / perChunk] + tsSlabHeaderBytes() + (i % perChunk) * stride;
+        TreeSetNode *copy = (TreeSetNode*)slot;
+        memcpy(copy, cur, tsNodeBytes(ts));
+        INIT_LINKS(copy);
+        MARK_SLAB(copy);
+        nodes[i] = copy;
+    }
+
+    tsReleaseSubtree(ts, ts->root);
+    tsLinkSorted(ts, nodes, i);
+
+    free(chunks);
+    free(nodes);
+    return ZZ_OK();
+}
+
 /**
  * @brief Initializes an iterator for the TreeSet.
  *
@@ -404,13 +1553,8 @@ void zzTreeSetIteratorInit(zzTreeSetIterator *it, zzTreeSet *ts) {
     it->set = ts;
     it->lastReturned = NULL;
 
-    // Find the minimum node (leftmost node) to start iteration
-    it->currentNode = ts->root;
-    if (it->currentNode) {
-        while (it->currentNode->left) {
-            it->currentNode = it->currentNode->left;
-        }
-    }
+    // Start at the cached minimum node
+    it->currentNode = ts->first;
 
     it->state = it->currentNode ? ZZ_ITER_VALID : ZZ_ITER_END;
 }
@@ -445,10 +1589,10 @@ bool zzTreeSetIteratorNext(zzTreeSetIterator *it, void *keyOut) {
         it->currentNode = current;
     } else {
         // If current node has no right child, go up to parent until we come from a left child
-        TreeSetNode *parent = current->parent;
+        TreeSetNode *parent = PARENT(current);
         while (parent && current == parent->right) {
             current = parent;
-            parent = parent->parent;
+            parent = PARENT(parent);
         }
         it->currentNode = parent;
     }